@@ -0,0 +1,93 @@
+// bench/Benchmark.cpp
+#include "Benchmark.h"
+#include <algorithm> // For std::sort
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+BenchmarkRunner::BenchmarkRunner(int reps, std::size_t max_n,
+                                 std::size_t min_ops, std::string name_filter)
+    : repetitions(reps > 0 ? reps : 1), maxN(max_n),
+      minOpsPerRepetition(min_ops), filter(std::move(name_filter)) {}
+
+std::vector<std::size_t> BenchmarkRunner::decades(std::size_t upTo) {
+  std::vector<std::size_t> sizes;
+  for (std::size_t n = 10; n <= upTo; n *= 10) {
+    sizes.push_back(n);
+  }
+  return sizes;
+}
+
+void BenchmarkRunner::add(const std::string &name,
+                          const std::vector<std::size_t> &sizes,
+                          BenchmarkFn fn) {
+  Entry entry;
+  entry.name = name;
+  entry.sizes = sizes;
+  entry.fn = std::move(fn);
+  entries.push_back(std::move(entry));
+}
+
+void BenchmarkRunner::runAll() {
+  std::cout << std::left << std::setw(36) << "Benchmark" << std::right
+            << std::setw(10) << "n" << std::setw(14) << "ns/op (min)"
+            << std::setw(14) << "ns/op (med)" << "\n";
+  for (const Entry &entry : entries) {
+    if (!filter.empty() && entry.name.find(filter) == std::string::npos) {
+      continue;
+    }
+    for (std::size_t n : entry.sizes) {
+      if (n > maxN) {
+        continue;
+      }
+      std::vector<double> samples;
+      std::size_t opsPerRep = 0;
+      for (int rep = 0; rep < repetitions; ++rep) {
+        Stopwatch stopwatch;
+        std::size_t ops = 0;
+        do {
+          ops += entry.fn(n, stopwatch);
+        } while (ops < minOpsPerRepetition);
+        opsPerRep = ops;
+        samples.push_back(stopwatch.elapsedNs() / static_cast<double>(ops));
+      }
+      std::sort(samples.begin(), samples.end());
+
+      BenchmarkResult result;
+      result.name = entry.name;
+      result.n = n;
+      result.opsPerRepetition = opsPerRep;
+      result.nsPerOpMin = samples.front();
+      result.nsPerOpMedian = samples[samples.size() / 2];
+      result.nsPerOpMax = samples.back();
+      results.push_back(result);
+
+      std::cout << std::left << std::setw(36) << entry.name << std::right
+                << std::setw(10) << n << std::fixed << std::setprecision(1)
+                << std::setw(14) << result.nsPerOpMin << std::setw(14)
+                << result.nsPerOpMedian << std::endl; // Show progress
+    }
+  }
+}
+
+bool BenchmarkRunner::writeJson(const std::string &path) const {
+  std::ofstream out(path.c_str());
+  if (!out) {
+    return false;
+  }
+  out << "{\n  \"context\": {\"repetitions\": " << repetitions
+      << ", \"max_n\": " << maxN << ", \"seed\": " << BENCH_SEED << "},\n";
+  out << "  \"benchmarks\": [\n";
+  out << std::fixed << std::setprecision(2);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const BenchmarkResult &r = results[i];
+    out << "    {\"name\": \"" << r.name << "\", \"n\": " << r.n
+        << ", \"ops_per_repetition\": " << r.opsPerRepetition
+        << ", \"ns_per_op_min\": " << r.nsPerOpMin
+        << ", \"ns_per_op_median\": " << r.nsPerOpMedian
+        << ", \"ns_per_op_max\": " << r.nsPerOpMax << "}"
+        << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  out << "  ]\n}\n";
+  return static_cast<bool>(out);
+}
@@ -0,0 +1,83 @@
+// bench/Benchmark.h
+
+#pragma once // Header guard
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Accumulates the time of the measured region(s) of one benchmark body.
+// Setup that should not be timed goes outside start()/stop().
+class Stopwatch {
+private:
+  std::chrono::steady_clock::time_point startedAt;
+  std::chrono::nanoseconds elapsed;
+
+public:
+  Stopwatch() : elapsed(0) {}
+  void start() { startedAt = std::chrono::steady_clock::now(); }
+  void stop() { elapsed += std::chrono::steady_clock::now() - startedAt; }
+  double elapsedNs() const { return static_cast<double>(elapsed.count()); }
+};
+
+// A benchmark body runs the workload once for problem size n and returns
+// how many operations it timed.
+using BenchmarkFn = std::function<std::size_t(std::size_t n, Stopwatch &)>;
+
+struct BenchmarkResult {
+  std::string name;
+  std::size_t n;
+  std::size_t opsPerRepetition;
+  double nsPerOpMin;
+  double nsPerOpMedian;
+  double nsPerOpMax;
+};
+
+// Runs registered benchmarks over a range of sizes and reports ns/op.
+// Each repetition re-runs the body until at least minOpsPerRepetition
+// operations were timed, so tiny sizes are not dominated by timer overhead.
+class BenchmarkRunner {
+private:
+  struct Entry {
+    std::string name;
+    std::vector<std::size_t> sizes;
+    BenchmarkFn fn;
+  };
+
+  std::vector<Entry> entries;
+  std::vector<BenchmarkResult> results;
+  int repetitions;
+  std::size_t maxN;
+  std::size_t minOpsPerRepetition;
+  std::string filter;
+
+public:
+  BenchmarkRunner(int reps, std::size_t max_n, std::size_t min_ops,
+                  std::string name_filter);
+
+  // Sizes 10, 100, ..., up to 'upTo' (still capped by --max-n)
+  static std::vector<std::size_t> decades(std::size_t upTo);
+
+  void add(const std::string &name, const std::vector<std::size_t> &sizes,
+           BenchmarkFn fn);
+  void runAll(); // Prints a table to stdout as it goes
+  bool writeJson(const std::string &path) const;
+};
+
+// Keeps a value observable so the optimizer cannot drop the measured work
+template <typename T> inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Fixed seeds keep every run of the suite on identical inputs
+const unsigned BENCH_SEED = 42;
+
+// Defined in the per-area benchmark sources
+void registerHeapBenchmarks(BenchmarkRunner &runner);
+void registerFlightBenchmarks(BenchmarkRunner &runner);
+void registerQueueBenchmarks(BenchmarkRunner &runner);
+void registerEngineBenchmarks(BenchmarkRunner &runner);
+void registerStorageBenchmarks(BenchmarkRunner &runner);
+void registerServerBenchmarks(BenchmarkRunner &runner);
@@ -0,0 +1,227 @@
+// bench/EngineBenchmarks.cpp
+// Booking throughput of the sharded and actor engines with several caller
+// threads.
+#include "Benchmark.h"
+#include "booking/ActorBookingEngine.h"
+#include "booking/ShardedBookingEngine.h"
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// n bookings split evenly over 'threads' callers, cycling over 'flights'
+// routes. Each thread books its own passengers, so every booking succeeds
+// (confirmed or waitlisted); total ns / n is reported.
+static std::size_t bookConcurrently(std::size_t n, unsigned threads,
+                                    unsigned flights, Stopwatch &sw) {
+  ShardedBookingEngine engine;
+  std::vector<std::string> flightIds;
+  for (unsigned f = 0; f < flights; ++f) {
+    flightIds.push_back("ENG" + std::to_string(f));
+    engine.addFlight(flightIds.back(), "Delhi", "Mumbai", 180);
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    engine.addPassenger("P");
+  }
+
+  std::vector<std::thread> workers;
+  sw.start();
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&engine, &flightIds, n, threads, t]() {
+      for (std::size_t i = t; i < n; i += threads) {
+        doNotOptimize(
+            engine.book(static_cast<PassengerIdType>(i + 1),
+                        flightIds[i % flightIds.size()]));
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  sw.stop();
+  return n;
+}
+
+// n two-leg itineraries split over 'threads' callers, on pairs of distinct
+// flights out of 'flights' that usually live in different shards. Seats
+// never run out, so every itinerary is sold; total ns / n is reported.
+static std::size_t bookItinerariesConcurrently(std::size_t n, unsigned threads,
+                                               unsigned flights,
+                                               Stopwatch &sw) {
+  ShardedBookingEngine engine;
+  std::vector<std::string> flightIds;
+  for (unsigned f = 0; f < flights; ++f) {
+    flightIds.push_back("ENG" + std::to_string(f));
+    engine.addFlight(flightIds.back(), "Delhi", "Mumbai",
+                     static_cast<int>(n));
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    engine.addPassenger("P");
+  }
+
+  std::vector<std::thread> workers;
+  sw.start();
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&engine, &flightIds, n, threads, t]() {
+      std::vector<std::string> legs(2);
+      for (std::size_t i = t; i < n; i += threads) {
+        const std::size_t first = i % flightIds.size();
+        const std::size_t offset = 1 + i / flightIds.size() %
+                                           (flightIds.size() - 1);
+        legs[0] = flightIds[first];
+        legs[1] = flightIds[(first + offset) % flightIds.size()];
+        doNotOptimize(
+            engine.bookItinerary(static_cast<PassengerIdType>(i + 1), legs)
+                .result);
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  sw.stop();
+  return n;
+}
+
+// Same workload through the actor engine: callers post and move on, the
+// clock stops once every callback has run
+static std::size_t bookThroughActors(std::size_t n, unsigned threads,
+                                     unsigned flights, Stopwatch &sw) {
+  ActorBookingEngine engine;
+  std::vector<std::string> flightIds;
+  for (unsigned f = 0; f < flights; ++f) {
+    flightIds.push_back("ENG" + std::to_string(f));
+    engine.addFlight(flightIds.back(), "Delhi", "Mumbai", 180);
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    engine.addPassenger("P");
+  }
+
+  std::atomic<std::size_t> completed(0);
+  std::vector<std::thread> workers;
+  sw.start();
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&engine, &flightIds, &completed, n, threads, t]() {
+      for (std::size_t i = t; i < n; i += threads) {
+        engine.book(static_cast<PassengerIdType>(i + 1),
+                    flightIds[i % flightIds.size()],
+                    [&completed](BookingResult) {
+                      completed.fetch_add(1, std::memory_order_relaxed);
+                    });
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  while (completed.load(std::memory_order_relaxed) < n) {
+    std::this_thread::yield();
+  }
+  sw.stop();
+  return n;
+}
+
+// n status reads split over 'threads' readers of random flights out of
+// 64 while one writer keeps booking and cancelling on the same flights.
+// 'lockFree' reads the published StatusCell, otherwise the flight is read
+// under its shard lock; total ns / n is reported.
+static std::size_t readStatusUnderWrites(std::size_t n, unsigned threads,
+                                         bool lockFree, Stopwatch &sw) {
+  ShardedBookingEngine engine;
+  std::vector<std::string> flightIds;
+  for (unsigned f = 0; f < 64; ++f) {
+    flightIds.push_back("ENG" + std::to_string(f));
+    engine.addFlight(flightIds.back(), "Delhi", "Mumbai", 180);
+  }
+  const PassengerIdType passengerCount = 512;
+  for (PassengerIdType i = 0; i < passengerCount; ++i) {
+    engine.addPassenger("P");
+  }
+
+  std::atomic<bool> done(false);
+  std::thread writer([&engine, &flightIds, &done, passengerCount]() {
+    for (std::size_t i = 0; !done.load(std::memory_order_relaxed); ++i) {
+      PassengerIdType passengerId =
+          static_cast<PassengerIdType>(i % passengerCount) + 1;
+      const std::string &flightId = flightIds[i % flightIds.size()];
+      if (i / passengerCount % 2 == 0) {
+        engine.book(passengerId, flightId);
+      } else {
+        engine.cancel(passengerId, flightId);
+      }
+    }
+  });
+
+  std::vector<std::thread> readers;
+  sw.start();
+  for (unsigned t = 0; t < threads; ++t) {
+    readers.emplace_back([&engine, &flightIds, n, threads, t, lockFree]() {
+      std::mt19937 rng(BENCH_SEED + t);
+      long long checksum = 0;
+      for (std::size_t i = t; i < n; i += threads) {
+        const std::string &flightId = flightIds[rng() % flightIds.size()];
+        if (lockFree) {
+          FlightCounters counters;
+          engine.readStatus(flightId, counters);
+          checksum += counters.booked + counters.waitlisted;
+        } else {
+          engine.withFlight(flightId, [&checksum](const Flight &flight) {
+            checksum += flight.getBookedCount() + flight.getWaitlistCount();
+          });
+        }
+      }
+      doNotOptimize(checksum);
+    });
+  }
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  sw.stop();
+  done.store(true, std::memory_order_relaxed);
+  writer.join();
+  return n;
+}
+
+void registerEngineBenchmarks(BenchmarkRunner &runner) {
+  const std::vector<std::size_t> sizes = BenchmarkRunner::decades(1000000);
+  // Actor setup (threads, synchronous addFlight round trips) would dominate
+  // tiny runs
+  const std::vector<std::size_t> actorSizes = {1000, 10000, 100000, 1000000};
+  const unsigned threadCounts[] = {1, 2, 4, 8};
+  for (unsigned threads : threadCounts) {
+    std::string suffix = "_t" + std::to_string(threads);
+    // Bookings spread over a large schedule
+    runner.add("engine/book_spread" + suffix, sizes,
+               [threads](std::size_t n, Stopwatch &sw) {
+                 return bookConcurrently(n, threads, 4096, sw);
+               });
+    // Sale launch: everyone hits the same few routes
+    runner.add("engine/book_hot_routes" + suffix, sizes,
+               [threads](std::size_t n, Stopwatch &sw) {
+                 return bookConcurrently(n, threads, 8, sw);
+               });
+    // Connections: two legs locked and sold together
+    runner.add("engine/itinerary_2leg" + suffix, sizes,
+               [threads](std::size_t n, Stopwatch &sw) {
+                 return bookItinerariesConcurrently(n, threads, 64, sw);
+               });
+    runner.add("actor/book_spread" + suffix, actorSizes,
+               [threads](std::size_t n, Stopwatch &sw) {
+                 return bookThroughActors(n, threads, 4096, sw);
+               });
+    runner.add("actor/book_hot_routes" + suffix, actorSizes,
+               [threads](std::size_t n, Stopwatch &sw) {
+                 return bookThroughActors(n, threads, 8, sw);
+               });
+    // Status endpoint next to a booking writer
+    runner.add("engine/status_read_lock_free" + suffix, actorSizes,
+               [threads](std::size_t n, Stopwatch &sw) {
+                 return readStatusUnderWrites(n, threads, true, sw);
+               });
+    runner.add("engine/status_read_locked" + suffix, actorSizes,
+               [threads](std::size_t n, Stopwatch &sw) {
+                 return readStatusUnderWrites(n, threads, false, sw);
+               });
+  }
+}
@@ -0,0 +1,277 @@
+// bench/FlightBenchmarks.cpp
+#include "Benchmark.h"
+#include "booking/Flight.h"
+#include "booking/FlightIndex.h"
+#include "booking/RouteIndex.h"
+#include "booking/SeatHolds.h"
+#include "core/PassengerTable.h"
+#include <algorithm> // For std::max
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Swallows everything written to it; keeps displayStatus() off the terminal
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override { return traits_type::not_eof(c); }
+  std::streamsize xsputn(const char *, std::streamsize n) override {
+    return n;
+  }
+};
+
+// Books 'n' passengers onto a flight with room for half of them, so the
+// second half goes through the waitlist heap
+static std::size_t bookAll(std::size_t n, Stopwatch &sw) {
+  Flight flight("BENCH1", "Delhi", "Mumbai", static_cast<int>(n / 2));
+  sw.start();
+  for (std::size_t i = 0; i < n; ++i) {
+    doNotOptimize(flight.book(static_cast<PassengerIdType>(i),
+                              static_cast<PriorityType>(i + 1)));
+  }
+  sw.stop();
+  return n;
+}
+
+// Cancels every confirmed passenger of a full flight with an equally long
+// waitlist, so each cancellation promotes someone
+static std::size_t cancelAllWithPromotion(std::size_t n, Stopwatch &sw) {
+  const std::size_t seats = n / 2 > 0 ? n / 2 : 1;
+  Flight flight("BENCH2", "London", "NewYork", static_cast<int>(seats));
+  for (std::size_t i = 0; i < 2 * seats; ++i) {
+    flight.book(static_cast<PassengerIdType>(i),
+                static_cast<PriorityType>(i + 1));
+  }
+  sw.start();
+  for (std::size_t i = 0; i < seats; ++i) {
+    doNotOptimize(flight.cancel(static_cast<PassengerIdType>(i)));
+  }
+  sw.stop();
+  return seats;
+}
+
+// Realistic traffic on one flight of the given capacity: 70% book, 25%
+// cancel (promoting from the waitlist when a confirmed seat frees up) and
+// 5% status display. Passenger IDs are drawn from a pool twice the capacity,
+// so the flight stays full with a waitlist about as long as the seat list.
+static std::size_t mixedTraffic(std::size_t capacity, Stopwatch &sw) {
+  const std::size_t ops = 200000;
+  const std::size_t poolSize = 2 * capacity;
+  PassengerTable passengerDb(0); // IDs 0 .. poolSize - 1
+  for (std::size_t i = 0; i < poolSize; ++i) {
+    passengerDb.add("Passenger " + std::to_string(i));
+  }
+
+  std::mt19937 rng(BENCH_SEED);
+  std::uniform_int_distribution<int> opDist(0, 99);
+  std::uniform_int_distribution<PassengerIdType> idDist(
+      0, static_cast<PassengerIdType>(poolSize - 1));
+  Flight flight("BENCH3", "Frankfurt", "Tokyo", static_cast<int>(capacity));
+  PriorityType nextPriority = 1;
+  for (std::size_t i = 0; i < poolSize; ++i) {
+    flight.book(static_cast<PassengerIdType>(i), nextPriority++);
+  }
+
+  NullBuffer nullBuffer;
+  std::streambuf *savedBuffer = std::cout.rdbuf(&nullBuffer);
+  sw.start();
+  for (std::size_t i = 0; i < ops; ++i) {
+    int op = opDist(rng);
+    PassengerIdType passengerId = idDist(rng);
+    if (op < 70) {
+      doNotOptimize(flight.book(passengerId, nextPriority++));
+    } else if (op < 95) {
+      doNotOptimize(flight.cancel(passengerId));
+    } else {
+      flight.displayStatus(passengerDb);
+    }
+  }
+  sw.stop();
+  std::cout.rdbuf(savedBuffer);
+  return ops;
+}
+
+// Random ID lookups in an index of n flights, as the TUI and batch API do
+static std::size_t findRandom(std::size_t n, Stopwatch &sw) {
+  FlightIndex index;
+  index.reserve(n);
+  std::vector<std::string> ids;
+  ids.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    ids.push_back("FL" + std::to_string(i));
+    index.insert(Flight(ids.back(), "Delhi", "Mumbai", 180));
+  }
+  std::mt19937 rng(BENCH_SEED);
+  std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+  const std::size_t lookups = 100000;
+  std::vector<const std::string *> queries(lookups);
+  for (auto &q : queries) {
+    q = &ids[pick(rng)];
+  }
+  unsigned long long checksum = 0;
+  sw.start();
+  for (const std::string *id : queries) {
+    checksum += index.find(*id);
+  }
+  sw.stop();
+  doNotOptimize(checksum);
+  return lookups;
+}
+
+// n flights over the 32 * 32 routes between 32 airports, a quarter of
+// them full. Reports ns per search for a random route.
+static const std::size_t AIRPORTS = 32;
+
+static void buildSchedule(std::size_t n, FlightIndex &index) {
+  index.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::size_t route = i % (AIRPORTS * AIRPORTS);
+    index.insert(Flight("FL" + std::to_string(i),
+                        "AP" + std::to_string(route / AIRPORTS),
+                        "AP" + std::to_string(route % AIRPORTS),
+                        i % 4 == 0 ? 0 : 180));
+  }
+}
+
+static std::vector<std::pair<std::string, std::string>>
+randomRoutes(std::size_t count) {
+  std::mt19937 rng(BENCH_SEED);
+  std::uniform_int_distribution<std::size_t> pick(0, AIRPORTS - 1);
+  std::vector<std::pair<std::string, std::string>> routes(count);
+  for (auto &route : routes) {
+    route.first = "AP" + std::to_string(pick(rng));
+    route.second = "AP" + std::to_string(pick(rng));
+  }
+  return routes;
+}
+
+static std::size_t searchRouteIndex(std::size_t n, Stopwatch &sw) {
+  FlightIndex index;
+  buildSchedule(n, index);
+  RouteIndex routes;
+  routes.reserve(n);
+  for (const Flight &flight : index) {
+    routes.add(flight.getFlightId(), flight.getOrigin(),
+               flight.getDestination(),
+               flight.getCapacity() - flight.getBookedCount());
+  }
+  const auto queries = randomRoutes(100000);
+  std::vector<RouteAvailability> results;
+  std::size_t hits = 0;
+  sw.start();
+  for (const auto &query : queries) {
+    results.clear();
+    hits += routes.findAvailable(query.first, query.second, results);
+  }
+  sw.stop();
+  doNotOptimize(hits);
+  return queries.size();
+}
+
+// The same searches by walking every flight, as listAllFlights() does
+static std::size_t searchByScan(std::size_t n, Stopwatch &sw) {
+  FlightIndex index;
+  buildSchedule(n, index);
+  const auto queries = randomRoutes(std::max<std::size_t>(10, 1000000 / n));
+  std::vector<RouteAvailability> results;
+  std::size_t hits = 0;
+  sw.start();
+  for (const auto &query : queries) {
+    results.clear();
+    for (const Flight &flight : index) {
+      int seats = flight.getCapacity() - flight.getBookedCount();
+      if (seats > 0 && flight.getOrigin() == query.first &&
+          flight.getDestination() == query.second) {
+        RouteAvailability hit;
+        hit.flightId = flight.getFlightId();
+        hit.seatsAvailable = seats;
+        results.push_back(hit);
+      }
+    }
+    hits += results.size();
+  }
+  sw.stop();
+  doNotOptimize(hits);
+  return queries.size();
+}
+
+// Hold deadlines spread over a 15 minute checkout window
+static std::vector<std::chrono::milliseconds> holdDurations(std::size_t n) {
+  std::mt19937 rng(BENCH_SEED);
+  std::uniform_int_distribution<int> window(1, 15 * 60 * 1000);
+  std::vector<std::chrono::milliseconds> durations(n);
+  for (std::chrono::milliseconds &duration : durations) {
+    duration = std::chrono::milliseconds(window(rng));
+  }
+  return durations;
+}
+
+// Arms n holds on top of n outstanding ones, then cancels them again (a
+// checkout that completes): 2n timer wheel operations
+static std::size_t holdAndCancel(std::size_t n, Stopwatch &sw) {
+  const std::vector<std::chrono::milliseconds> durations = holdDurations(2 * n);
+  const SeatHolds::Clock::time_point now = SeatHolds::Clock::now();
+  SeatHolds holds;
+  for (std::size_t i = 0; i < n; ++i) {
+    holds.add(i % 64, static_cast<PassengerIdType>(i), now + durations[i]);
+  }
+  sw.start();
+  for (std::size_t i = n; i < 2 * n; ++i) {
+    holds.add(i % 64, static_cast<PassengerIdType>(i), now + durations[i]);
+  }
+  for (std::size_t i = n; i < 2 * n; ++i) {
+    holds.remove(i % 64, static_cast<PassengerIdType>(i));
+  }
+  sw.stop();
+  doNotOptimize(holds.size());
+  return 2 * n;
+}
+
+// Every seat of a flight held, as many passengers waitlisted behind them,
+// then the clock stepped through the window a second at a time: each
+// expiry releases the seat and promotes the next waitlisted passenger
+static std::size_t expireHoldsWithPromotion(std::size_t n, Stopwatch &sw) {
+  const std::vector<std::chrono::milliseconds> durations = holdDurations(n);
+  Flight flight("BENCH3", "Delhi", "Goa", static_cast<int>(n));
+  SeatHolds holds;
+  const SeatHolds::Clock::time_point start = SeatHolds::Clock::now();
+  for (std::size_t i = 0; i < n; ++i) {
+    flight.holdSeat(static_cast<PassengerIdType>(i));
+    holds.add(0, static_cast<PassengerIdType>(i), start + durations[i]);
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    flight.book(static_cast<PassengerIdType>(n + i),
+                static_cast<PriorityType>(i + 1));
+  }
+  std::size_t expired = 0;
+  sw.start();
+  for (int second = 1; holds.size() > 0; ++second) {
+    expired += holds.expire(start + std::chrono::seconds(second),
+                            [&flight](std::uint64_t, PassengerIdType id) {
+                              flight.releaseHold(id);
+                            });
+  }
+  sw.stop();
+  doNotOptimize(flight.getBookedCount());
+  return expired;
+}
+
+void registerFlightBenchmarks(BenchmarkRunner &runner) {
+  const std::vector<std::size_t> sizes = BenchmarkRunner::decades(10000000);
+  runner.add("flight/book", sizes, bookAll);
+  runner.add("flight/cancel_with_promotion", sizes, cancelAllWithPromotion);
+  // Regional jet, narrow-body, wide-body, A380 plus charter block
+  runner.add("flight/mix_70book_25cancel_5display", {50, 180, 400, 850},
+             mixedTraffic);
+  runner.add("flight_index/find_random", BenchmarkRunner::decades(1000000),
+             findRandom);
+  runner.add("route_index/find_available", BenchmarkRunner::decades(100000),
+             searchRouteIndex);
+  runner.add("route_index/scan_all_flights",
+             BenchmarkRunner::decades(1000000), searchByScan);
+  runner.add("holds/hold_and_cancel", sizes, holdAndCancel);
+  runner.add("holds/expire_with_promotion", BenchmarkRunner::decades(1000000),
+             expireHoldsWithPromotion);
+}
@@ -0,0 +1,159 @@
+// bench/HeapBenchmarks.cpp
+#include "Benchmark.h"
+#include "heap/BinomialHeap.h"
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Random priorities for n entries, identical on every run
+static std::vector<PriorityType> randomPriorities(std::size_t n) {
+  std::mt19937 rng(BENCH_SEED);
+  std::uniform_int_distribution<PriorityType> dist(0, MAX_PRIORITY - 1);
+  std::vector<PriorityType> priorities(n);
+  for (auto &p : priorities) {
+    p = dist(rng);
+  }
+  return priorities;
+}
+
+static std::vector<BinomialHeap::Entry> randomEntries(std::size_t n) {
+  std::vector<PriorityType> priorities = randomPriorities(n);
+  std::vector<BinomialHeap::Entry> entries;
+  entries.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    entries.emplace_back(priorities[i], static_cast<PassengerIdType>(i));
+  }
+  return entries;
+}
+
+static std::vector<PriorityType> monotonePriorities(std::size_t n) {
+  // The booking counter hands out ever increasing priorities
+  std::vector<PriorityType> priorities(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    priorities[i] = static_cast<PriorityType>(i + 1);
+  }
+  return priorities;
+}
+
+static std::size_t insertAll(const std::vector<PriorityType> &priorities,
+                             BinomialHeap::InsertMode mode, Stopwatch &sw) {
+  BinomialHeap heap(mode);
+  sw.start();
+  for (std::size_t i = 0; i < priorities.size(); ++i) {
+    heap.insert(priorities[i], static_cast<PassengerIdType>(i));
+  }
+  sw.stop();
+  doNotOptimize(heap.getSize());
+  return priorities.size();
+}
+
+static std::size_t extractAll(const std::vector<PriorityType> &priorities,
+                              Stopwatch &sw) {
+  BinomialHeap heap;
+  for (std::size_t i = 0; i < priorities.size(); ++i) {
+    heap.insert(priorities[i], static_cast<PassengerIdType>(i));
+  }
+  long long checksum = 0;
+  sw.start();
+  while (!heap.isEmpty()) {
+    checksum += heap.extractMin();
+  }
+  sw.stop();
+  doNotOptimize(checksum);
+  return priorities.size();
+}
+
+void registerHeapBenchmarks(BenchmarkRunner &runner) {
+  const std::vector<std::size_t> sizes = BenchmarkRunner::decades(10000000);
+
+  runner.add("heap/insert_monotone", sizes, [](std::size_t n, Stopwatch &sw) {
+    return insertAll(monotonePriorities(n), BinomialHeap::InsertMode::Eager,
+                     sw);
+  });
+  runner.add("heap/insert_random", sizes, [](std::size_t n, Stopwatch &sw) {
+    return insertAll(randomPriorities(n), BinomialHeap::InsertMode::Eager, sw);
+  });
+  runner.add("heap/insert_lazy", sizes, [](std::size_t n, Stopwatch &sw) {
+    return insertAll(monotonePriorities(n), BinomialHeap::InsertMode::Lazy,
+                     sw);
+  });
+  runner.add("heap/extract_min", sizes, [](std::size_t n, Stopwatch &sw) {
+    return extractAll(randomPriorities(n), sw);
+  });
+
+  runner.add("heap/get_size", sizes, [](std::size_t n, Stopwatch &sw) {
+    BinomialHeap heap;
+    for (std::size_t i = 0; i < n; ++i) {
+      heap.insert(static_cast<PriorityType>(i), 0);
+    }
+    const std::size_t calls = 1000;
+    long long total = 0;
+    sw.start();
+    for (std::size_t i = 0; i < calls; ++i) {
+      doNotOptimize(heap);
+      total += heap.getSize();
+    }
+    sw.stop();
+    doNotOptimize(total);
+    return calls;
+  });
+
+  // Bulk build of a whole batch (the heap-union path used by bookBatch)
+  runner.add("heap/insert_batch", sizes, [](std::size_t n, Stopwatch &sw) {
+    std::vector<BinomialHeap::Entry> entries = randomEntries(n);
+    std::vector<BinomialHeap::Handle> handles;
+    handles.reserve(n);
+    BinomialHeap heap;
+    sw.start();
+    heap.insertBatch(entries, handles);
+    sw.stop();
+    doNotOptimize(heap.findMinPriority());
+    return n;
+  });
+
+  // Whole waitlist known up front (restore, manifest import)
+  runner.add("heap/build_from", sizes, [](std::size_t n, Stopwatch &sw) {
+    std::vector<BinomialHeap::Entry> entries = randomEntries(n);
+    std::vector<BinomialHeap::Handle> handles;
+    handles.reserve(n);
+    sw.start();
+    BinomialHeap heap = BinomialHeap::buildFrom(entries, handles);
+    sw.stop();
+    doNotOptimize(heap.findMinPriority());
+    return n;
+  });
+  const unsigned threadCounts[] = {2, 4};
+  for (unsigned threads : threadCounts) {
+    runner.add("heap/build_from_parallel" + std::to_string(threads), sizes,
+               [threads](std::size_t n, Stopwatch &sw) {
+                 std::vector<BinomialHeap::Entry> entries = randomEntries(n);
+                 std::vector<BinomialHeap::Handle> handles;
+                 handles.reserve(n);
+                 sw.start();
+                 BinomialHeap heap =
+                     BinomialHeap::buildFromParallel(entries, handles, threads);
+                 sw.stop();
+                 doNotOptimize(heap.findMinPriority());
+                 return n;
+               });
+  }
+
+  // Steady-state churn: one insert + one extract on a heap of size n
+  runner.add("heap/insert_extract_churn", sizes,
+             [](std::size_t n, Stopwatch &sw) {
+               BinomialHeap heap;
+               PriorityType next = 1;
+               for (std::size_t i = 0; i < n; ++i) {
+                 heap.insert(next++, 0);
+               }
+               const std::size_t rounds = 100000;
+               sw.start();
+               for (std::size_t i = 0; i < rounds; ++i) {
+                 heap.insert(next++, 0);
+                 doNotOptimize(heap.extractMin());
+               }
+               sw.stop();
+               return rounds;
+             });
+}
@@ -0,0 +1,95 @@
+// bench/QueueBenchmarks.cpp
+// Waitlist backends side by side, on the access patterns a flight sees.
+#include "Benchmark.h"
+#include "heap/Waitlist.h"
+#include <algorithm> // For std::shuffle
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+static const WaitlistBackend ALL_BACKENDS[] = {
+    WaitlistBackend::Binomial, WaitlistBackend::Pairing,
+    WaitlistBackend::Quaternary, WaitlistBackend::Radix};
+
+static std::string queueName(WaitlistBackend backend, const char *what) {
+  return std::string("queue/") + toString(backend) + "/" + what;
+}
+
+void registerQueueBenchmarks(BenchmarkRunner &runner) {
+  const std::vector<std::size_t> sizes = BenchmarkRunner::decades(10000000);
+
+  for (WaitlistBackend backend : ALL_BACKENDS) {
+    // Overflow bookings: every insert carries the worst key so far
+    runner.add(queueName(backend, "insert_monotone"), sizes,
+               [backend](std::size_t n, Stopwatch &sw) {
+                 Waitlist waitlist(backend);
+                 sw.start();
+                 for (std::size_t i = 0; i < n; ++i) {
+                   waitlist.insert(static_cast<PriorityType>(i + 1),
+                                   static_cast<PassengerIdType>(i));
+                 }
+                 sw.stop();
+                 doNotOptimize(waitlist.getSize());
+                 return n;
+               });
+
+    // Promotions draining the waitlist in order
+    runner.add(queueName(backend, "extract_monotone"), sizes,
+               [backend](std::size_t n, Stopwatch &sw) {
+                 Waitlist waitlist(backend);
+                 for (std::size_t i = 0; i < n; ++i) {
+                   waitlist.insert(static_cast<PriorityType>(i + 1),
+                                   static_cast<PassengerIdType>(i));
+                 }
+                 long long checksum = 0;
+                 sw.start();
+                 while (!waitlist.isEmpty()) {
+                   checksum += waitlist.extractMin();
+                 }
+                 sw.stop();
+                 doNotOptimize(checksum);
+                 return n;
+               });
+
+    // Steady state: one overflow booking and one promotion per round
+    runner.add(queueName(backend, "churn"), sizes,
+               [backend](std::size_t n, Stopwatch &sw) {
+                 Waitlist waitlist(backend);
+                 PriorityType next = 1;
+                 for (std::size_t i = 0; i < n; ++i) {
+                   waitlist.insert(next++, 0);
+                 }
+                 const std::size_t rounds = 100000;
+                 sw.start();
+                 for (std::size_t i = 0; i < rounds; ++i) {
+                   waitlist.insert(next++, 0);
+                   doNotOptimize(waitlist.extractMin());
+                 }
+                 sw.stop();
+                 return rounds;
+               });
+
+    // Waitlisted passengers cancelling in random order
+    runner.add(queueName(backend, "erase_random"), sizes,
+               [backend](std::size_t n, Stopwatch &sw) {
+                 Waitlist waitlist(backend);
+                 std::vector<Waitlist::Handle> handles;
+                 handles.reserve(n);
+                 for (std::size_t i = 0; i < n; ++i) {
+                   handles.push_back(
+                       waitlist.insert(static_cast<PriorityType>(i + 1),
+                                       static_cast<PassengerIdType>(i)));
+                 }
+                 std::mt19937 rng(BENCH_SEED);
+                 std::shuffle(handles.begin(), handles.end(), rng);
+                 sw.start();
+                 for (Waitlist::Handle handle : handles) {
+                   waitlist.erase(handle);
+                 }
+                 sw.stop();
+                 doNotOptimize(waitlist.getSize());
+                 return n;
+               });
+  }
+}
@@ -0,0 +1,91 @@
+// bench/ServerBenchmarks.cpp
+// Round trips through the request server over a Unix domain socket, with
+// the server's event loop on its own thread.
+#include "Benchmark.h"
+#include "booking/ShardedBookingEngine.h"
+#include "server/RequestServer.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+// n book requests from one client, 'depth' of them in flight at a time
+// (1: request, wait, repeat). Every booking succeeds; ns / request.
+static std::size_t bookOverSocket(std::size_t n, std::size_t depth,
+                                  Stopwatch &sw) {
+  ShardedBookingEngine engine;
+  const unsigned flights = 4096;
+  for (unsigned f = 0; f < flights; ++f) {
+    engine.addFlight("SRV" + std::to_string(f), "Delhi", "Mumbai", 180);
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    engine.addPassenger("P");
+  }
+  ShardedEngineService service(engine);
+  ServerOptions options;
+  options.unixPath = "/tmp/booking_bench_" + std::to_string(::getpid()) +
+                     ".sock";
+  RequestServer server(service, options);
+  std::thread loop([&server] { server.run(); });
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, options.unixPath.c_str());
+  if (fd < 0 ||
+      ::connect(fd, reinterpret_cast<sockaddr *>(&address),
+                sizeof(address)) != 0) {
+    server.stop();
+    loop.join();
+    throw std::runtime_error("Cannot connect to the benchmark server");
+  }
+
+  // Requests are formatted up front so the clock sees only the round trips
+  std::string requests;
+  std::vector<std::size_t> ends;
+  for (std::size_t i = 0; i < n; ++i) {
+    requests += "book " + std::to_string(i + 1) + " SRV" +
+                std::to_string(i % flights) + '\n';
+    ends.push_back(requests.size());
+  }
+  std::vector<char> replies(1 << 16);
+
+  sw.start();
+  std::size_t begin = 0;
+  for (std::size_t i = 0; i < n; i += depth) {
+    std::size_t count = std::min(depth, n - i);
+    std::size_t end = ends[i + count - 1];
+    ::send(fd, requests.data() + begin, end - begin, 0);
+    begin = end;
+    while (count > 0) {
+      ssize_t got = ::recv(fd, replies.data(), replies.size(), 0);
+      if (got <= 0) {
+        break;
+      }
+      count -= static_cast<std::size_t>(
+          std::count(replies.data(), replies.data() + got, '\n'));
+    }
+  }
+  sw.stop();
+
+  ::close(fd);
+  server.stop();
+  loop.join();
+  return n;
+}
+
+void registerServerBenchmarks(BenchmarkRunner &runner) {
+  const std::vector<std::size_t> sizes = {1000, 10000, 100000};
+  const std::size_t depths[] = {1, 16, 256};
+  for (std::size_t depth : depths) {
+    runner.add("server/book_pipelined_d" + std::to_string(depth), sizes,
+               [depth](std::size_t n, Stopwatch &sw) {
+                 return bookOverSocket(n, depth, sw);
+               });
+  }
+}
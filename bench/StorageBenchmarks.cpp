@@ -0,0 +1,178 @@
+// bench/StorageBenchmarks.cpp
+// Journal append cost per booking for different group-commit sizes,
+// snapshot write, eager load and mapped open per flight, and schedule
+// import per row (CSV and binary).
+#include "Benchmark.h"
+#include "booking/Flight.h"
+#include "booking/FlightIndex.h"
+#include "core/PassengerTable.h"
+#include "storage/BulkImport.h"
+#include "storage/MappedSnapshot.h"
+#include "storage/Snapshot.h"
+#include "storage/WriteAheadLog.h"
+#include <cstdint>
+#include <cstdio> // For std::remove
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+// Scratch files live in the working directory: /tmp may be a tmpfs, where
+// fsync costs nothing and the comparison would be meaningless
+static std::string scratchPath(const char *name) {
+  return std::string("bench_") + name + "_" + std::to_string(::getpid());
+}
+
+static std::size_t appendBookings(std::size_t n, std::size_t groupRecords,
+                                  Stopwatch &sw) {
+  const std::string path = scratchPath("wal");
+  {
+    // No time-based commits: the group size alone decides the fsync count
+    WriteAheadLog journal(groupRecords, 1000000);
+    journal.open(path, 0, [](const WalRecord &) {});
+    const std::string flightId = "AI101";
+    sw.start();
+    for (std::size_t i = 0; i < n; ++i) {
+      journal.logBooking(WalRecord::Type::Booked, flightId,
+                         static_cast<PassengerIdType>(i),
+                         static_cast<PriorityType>(i));
+    }
+    journal.commit();
+    sw.stop();
+  }
+  std::remove(path.c_str());
+  return n;
+}
+
+// n flights of 8 seats, each full with 8 more passengers waitlisted
+static void fillSchedule(std::size_t n, PassengerTable &passengers,
+                         FlightIndex &flights) {
+  for (int i = 0; i < 16; ++i) {
+    passengers.add("Passenger");
+  }
+  std::vector<std::pair<PassengerIdType, PriorityType>> batch;
+  for (int i = 0; i < 16; ++i) {
+    batch.emplace_back(i + 1, i + 1);
+  }
+  std::vector<BookingResult> results;
+  flights.reserve(n);
+  for (std::size_t f = 0; f < n; ++f) {
+    Flight flight("SN" + std::to_string(f), "Delhi", "Mumbai", 8);
+    flight.addPassengers(batch, results);
+    flights.insert(std::move(flight));
+  }
+}
+
+static std::size_t writeSchedule(std::size_t n, Stopwatch &sw) {
+  PassengerTable passengers;
+  FlightIndex flights;
+  fillSchedule(n, passengers, flights);
+  const std::string path = scratchPath("snap");
+  sw.start();
+  writeSnapshot(path, SnapshotInfo(), passengers, flights);
+  sw.stop();
+  std::remove(path.c_str());
+  return n;
+}
+
+static std::size_t loadSchedule(std::size_t n, Stopwatch &sw) {
+  const std::string path = scratchPath("snap");
+  {
+    PassengerTable passengers;
+    FlightIndex flights;
+    fillSchedule(n, passengers, flights);
+    writeSnapshot(path, SnapshotInfo(), passengers, flights);
+  }
+  PassengerTable passengers;
+  FlightIndex flights;
+  SnapshotInfo info;
+  sw.start();
+  doNotOptimize(loadSnapshot(path, info, passengers, flights));
+  sw.stop();
+  std::remove(path.c_str());
+  return n;
+}
+
+// Startup of a replica: map the file and serve a first booking from it
+static std::size_t openMapped(std::size_t n, Stopwatch &sw) {
+  const std::string path = scratchPath("snap");
+  {
+    PassengerTable passengers;
+    FlightIndex flights;
+    fillSchedule(n, passengers, flights);
+    writeSnapshot(path, SnapshotInfo(), passengers, flights);
+  }
+  sw.start();
+  {
+    MappedSnapshot snapshot;
+    snapshot.open(path);
+    std::uint32_t index = snapshot.find("SN" + std::to_string(n / 2));
+    Flight flight = snapshot.materialize(index);
+    doNotOptimize(flight.getWaitlistCount());
+  }
+  sw.stop();
+  std::remove(path.c_str());
+  return n;
+}
+
+// n rows like "SN123,Delhi,Mumbai,180" in either format
+static void writeScheduleFile(const std::string &path, std::size_t n,
+                              bool binary) {
+  std::string out = binary ? "BSCH" : "flight_id,origin,destination,capacity\n";
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::string id = "SN" + std::to_string(i);
+    if (!binary) {
+      out += id + ",Delhi,Mumbai,180\n";
+      continue;
+    }
+    const std::uint16_t lengths[3] = {static_cast<std::uint16_t>(id.size()),
+                                      5, 6};
+    const std::int32_t capacity = 180;
+    out.append(reinterpret_cast<const char *>(lengths), sizeof(lengths));
+    out.append(2, '\0'); // Backend (binomial), padding
+    out.append(reinterpret_cast<const char *>(&capacity), sizeof(capacity));
+    out += id + "DelhiMumbai";
+  }
+  std::ofstream(path.c_str(), std::ios::binary) << out;
+}
+
+// Parse and build each flight in place, as BookingSystem::importSchedule
+static std::size_t importSchedule(std::size_t n, bool binary, Stopwatch &sw) {
+  const std::string path = scratchPath("schedule");
+  writeScheduleFile(path, n, binary);
+  {
+    FlightIndex flights;
+    sw.start();
+    ScheduleReader reader(path);
+    flights.reserve(reader.estimatedRows());
+    ScheduleRow row;
+    while (reader.next(row)) {
+      flights.emplace(row.flightId, row.origin, row.destination, row.capacity,
+                      row.backend);
+    }
+    sw.stop();
+    doNotOptimize(flights.size());
+  }
+  std::remove(path.c_str());
+  return n;
+}
+
+void registerStorageBenchmarks(BenchmarkRunner &runner) {
+  const std::vector<std::size_t> sizes = BenchmarkRunner::decades(1000000);
+  const std::size_t groups[] = {64, WriteAheadLog::DEFAULT_GROUP_RECORDS};
+  for (std::size_t group : groups) {
+    runner.add("wal/log_booking_group" + std::to_string(group), sizes,
+               [group](std::size_t n, Stopwatch &sw) {
+                 return appendBookings(n, group, sw);
+               });
+  }
+  runner.add("snapshot/write", sizes, writeSchedule);
+  runner.add("snapshot/load", sizes, loadSchedule);
+  runner.add("snapshot/open_mapped", sizes, openMapped);
+  const bool formats[] = {false, true};
+  for (bool binary : formats) {
+    runner.add(binary ? "import/schedule_binary" : "import/schedule_csv",
+               sizes, [binary](std::size_t n, Stopwatch &sw) {
+                 return importSchedule(n, binary, sw);
+               });
+  }
+}
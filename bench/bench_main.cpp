@@ -0,0 +1,68 @@
+// bench/bench_main.cpp
+//
+// Microbenchmarks for BinomialHeap and Flight.
+// Usage: booking_bench [--json=FILE] [--max-n=N] [--reps=R] [--min-ops=N]
+//                      [--filter=SUBSTRING] [--metrics=FILE]
+// --metrics writes the hot-path metrics of the whole run in the Prometheus
+// text format (only populated in a METRICS=1 build).
+#include "Benchmark.h"
+#include "metrics/Metrics.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char **argv) {
+  std::string jsonPath = "bench_results.json";
+  std::size_t maxN = 10000000;
+  std::size_t minOps = 100000;
+  int reps = 5;
+  std::string filter;
+  std::string metricsPath;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    std::string value = arg.substr(arg.find('=') + 1);
+    if (arg.compare(0, 7, "--json=") == 0) {
+      jsonPath = value;
+    } else if (arg.compare(0, 8, "--max-n=") == 0) {
+      maxN = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (arg.compare(0, 7, "--reps=") == 0) {
+      reps = std::atoi(value.c_str());
+    } else if (arg.compare(0, 10, "--min-ops=") == 0) {
+      minOps = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (arg.compare(0, 9, "--filter=") == 0) {
+      filter = value;
+    } else if (arg.compare(0, 10, "--metrics=") == 0) {
+      metricsPath = value;
+    } else {
+      std::cerr << "Unknown argument: " << arg << "\n";
+      return 1;
+    }
+  }
+
+  BenchmarkRunner runner(reps, maxN, minOps, filter);
+  registerHeapBenchmarks(runner);
+  registerFlightBenchmarks(runner);
+  registerQueueBenchmarks(runner);
+  registerEngineBenchmarks(runner);
+  registerStorageBenchmarks(runner);
+  registerServerBenchmarks(runner);
+  runner.runAll();
+
+  if (!runner.writeJson(jsonPath)) {
+    std::cerr << "Could not write " << jsonPath << "\n";
+    return 1;
+  }
+  std::cout << "Results written to " << jsonPath << "\n";
+  if (!metricsPath.empty()) {
+    std::ofstream metrics(metricsPath);
+    writePrometheus(metrics);
+    if (!metrics) {
+      std::cerr << "Could not write " << metricsPath << "\n";
+      return 1;
+    }
+    std::cout << "Metrics written to " << metricsPath << "\n";
+  }
+  return 0;
+}
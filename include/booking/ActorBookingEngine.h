@@ -0,0 +1,96 @@
+// include/booking/ActorBookingEngine.h
+#pragma once // Header guard
+
+#include "booking/BookingEvents.h"
+#include "booking/BookingRequest.h"
+#include "booking/FlightActor.h"
+#include "common/Types.h"
+#include "core/PassengerRegistry.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Message-passing booking core: flights are partitioned over a fixed set of
+// FlightActors by the hash of their ID, and every operation on a flight is
+// a command posted to its actor. Callers never lock and never wait on each
+// other; under a fare sale on one route, all its bookings queue up in one
+// mailbox and are executed back to back by a single thread.
+// Results come back through std::future or an optional callback (run on
+// the actor thread). Priorities and passenger IDs use atomic counters as
+// in ShardedBookingEngine.
+class ActorBookingEngine {
+public:
+  using Callback = std::function<void(BookingResult)>;
+
+private:
+  std::vector<std::unique_ptr<FlightActor>> actors;
+  std::atomic<PriorityType> nextBookingPriority;
+  PassengerRegistry passengers;
+
+  FlightActor &actorFor(const std::string &flightId) const;
+  std::future<BookingResult> rejected(BookingResult result) const;
+  BookingCommand *makeCommand(BookingCommand::Kind kind,
+                              PassengerIdType passengerId,
+                              const std::string &flightId);
+
+public:
+  // actorCount 0 picks one actor per hardware thread. 'sink' (not owned,
+  // may be nullptr) is called from the actor threads, so it must be
+  // thread-safe.
+  explicit ActorBookingEngine(unsigned actorCount = 0,
+                              BookingEventSink *sink = nullptr);
+  // Drains every actor's mailbox before returning
+  ~ActorBookingEngine();
+
+  ActorBookingEngine(const ActorBookingEngine &) = delete;
+  ActorBookingEngine &operator=(const ActorBookingEngine &) = delete;
+
+  // --- All of the following are safe to call concurrently ---
+
+  // Blocks until the owning actor has added the flight. Returns false if a
+  // flight with this ID already exists. Throws std::invalid_argument if a
+  // field does not fit a FlightCode.
+  bool addFlight(const std::string &flightId, const std::string &origin,
+                 const std::string &destination, int capacity,
+                 WaitlistBackend waitlistBackend = WaitlistBackend::Binomial);
+  PassengerIdType addPassenger(const std::string &name); // Returns the new ID
+  bool hasPassenger(PassengerIdType passengerId) const;  // Lock-free
+  std::string getPassengerName(PassengerIdType passengerId) const;
+
+  // Priority is taken from the shared counter when the call is made.
+  // Unknown passengers are rejected right away, without a message.
+  std::future<BookingResult> book(PassengerIdType passengerId,
+                                  const std::string &flightId);
+  std::future<BookingResult> cancel(PassengerIdType passengerId,
+                                    const std::string &flightId);
+  // Callback variants. onDone runs on the actor thread, or inline for an
+  // unknown passenger, and must not block it for long.
+  void book(PassengerIdType passengerId, const std::string &flightId,
+            Callback onDone);
+  void cancel(PassengerIdType passengerId, const std::string &flightId,
+              Callback onDone);
+
+  // Runs fn(const Flight &) on the flight's actor and waits for it.
+  // Returns false (without calling fn) for an unknown flight.
+  template <typename Fn> bool withFlight(const std::string &flightId, Fn fn) {
+    BookingCommand *command =
+        makeCommand(BookingCommand::Kind::Inspect, INVALID_PASSENGER_ID,
+                    flightId);
+    command->inspect = [fn](const Flight *flight) {
+      if (flight != nullptr) {
+        fn(*flight);
+      }
+    };
+    std::promise<bool> done;
+    std::future<bool> found = done.get_future();
+    command->done = &done;
+    actorFor(flightId).post(command);
+    return found.get();
+  }
+
+  unsigned getActorCount() const;
+};
@@ -0,0 +1,58 @@
+#pragma once // Header guard
+
+#include "common/Types.h"
+#include <cstdint>
+#include <iosfwd>
+
+class Flight;
+
+// What happened to a passenger on a flight
+enum class BookingEventType : std::uint8_t {
+  Confirmed,           // Seat booked directly
+  Waitlisted,          // Flight full, added to the waitlist
+  Promoted,            // Moved from the waitlist into a freed seat
+  Cancelled,           // Confirmed seat released
+  RemovedFromWaitlist, // Waitlist entry dropped
+  AlreadyConfirmed,    // Duplicate booking attempt, nothing changed
+  AlreadyWaitlisted,   // Duplicate booking attempt, nothing changed
+  NotBooked,           // Cancellation for a passenger not on the flight
+  PriorityUpgraded,    // Waitlist priority improved to 'priority'
+  Held,                // Seat held for checkout
+  HoldConfirmed,       // Held seat turned into a confirmed one
+  HoldReleased,        // Held seat given up or expired
+  AlreadyHeld,         // Duplicate booking or hold attempt, nothing changed
+  NotHeld,             // Confirm or release without a hold, nothing changed
+  SoldOut              // No seat to hold, nothing changed
+};
+
+// Plain record emitted by the booking core. Trivially copyable so sinks can
+// push it into ring buffers or write it out as is. 'flight' stays valid for
+// as long as the flight itself does.
+struct BookingEvent {
+  BookingEventType type;
+  PassengerIdType passengerId;
+  // Waitlist priority, meaningful for (Already)Waitlisted, Promoted and
+  // PriorityUpgraded
+  PriorityType priority;
+  const Flight *flight;
+};
+
+// Observer for booking events. Flights without a sink stay silent; the TUI
+// installs a ConsoleEventSink, high-throughput callers install their own
+// (e.g. an EventRingBuffer) or none at all.
+class BookingEventSink {
+public:
+  virtual ~BookingEventSink() {}
+  virtual void onEvent(const BookingEvent &event) = 0;
+};
+
+// Prints events as the interactive messages of the TUI. Lines end in '\n'
+// rather than std::endl, so nothing is flushed per event.
+class ConsoleEventSink : public BookingEventSink {
+private:
+  std::ostream &out;
+
+public:
+  explicit ConsoleEventSink(std::ostream &os);
+  void onEvent(const BookingEvent &event) override;
+};
@@ -0,0 +1,64 @@
+#pragma once // Header guard
+
+#include "common/PriorityKey.h"
+#include "common/Types.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// One entry of a programmatic book/cancel batch (see BookingSystem::bookBatch)
+struct BookingRequest {
+  PassengerIdType passengerId;
+  std::string flightId;
+  // Waitlist tier (fare class / loyalty), bookings only. STANDARD_TIER to
+  // MAX_TIER; bookBatch() throws std::invalid_argument otherwise.
+  PriorityTier tier;
+
+  BookingRequest()
+      : passengerId(INVALID_PASSENGER_ID), tier(STANDARD_TIER) {}
+  BookingRequest(PassengerIdType _passengerId, std::string _flightId,
+                 PriorityTier _tier = STANDARD_TIER)
+      : passengerId(_passengerId), flightId(std::move(_flightId)),
+        tier(_tier) {}
+};
+
+// Outcome of a single booking or cancellation
+enum class BookingResult {
+  Confirmed,           // Seat booked
+  Waitlisted,          // Flight full, added to the waitlist
+  AlreadyConfirmed,    // Duplicate booking of a confirmed passenger
+  AlreadyWaitlisted,   // Duplicate booking of a waitlisted passenger
+  Cancelled,           // Confirmed seat released (waitlist may be promoted)
+  RemovedFromWaitlist, // Waitlist entry dropped
+  NotBooked,           // Cancellation for a passenger not on the flight
+  UnknownFlight,
+  UnknownPassenger,
+  SoldOut, // No free seat; from itinerary booking or a hold, never waitlisted
+  Held,          // Seat held for checkout (see Flight::holdSeat)
+  HoldReleased,  // Held seat given up or expired (waitlist may be promoted)
+  NotHeld,       // Confirm or release of a hold that is not there (any more)
+  AlreadyHeld    // Duplicate booking or hold of a passenger holding a seat
+};
+
+// Outcome of an all-or-nothing itinerary booking (bookItinerary): either
+// every leg got a seat or nothing was changed
+struct ItineraryResult {
+  static const std::size_t NO_LEG = static_cast<std::size_t>(-1);
+
+  // Confirmed, or why 'failedLeg' could not be seated: UnknownFlight,
+  // SoldOut, AlreadyConfirmed, AlreadyWaitlisted or AlreadyHeld.
+  // UnknownPassenger concerns no leg.
+  BookingResult result;
+  std::size_t failedLeg; // Index into the legs, or NO_LEG
+
+  ItineraryResult() : result(BookingResult::Confirmed), failedLeg(NO_LEG) {}
+  ItineraryResult(BookingResult r, std::size_t leg)
+      : result(r), failedLeg(leg) {}
+};
+
+// Throws std::invalid_argument unless 'flightIds' is a valid itinerary:
+// at least one leg and no flight listed twice
+void requireDistinctLegs(const std::vector<std::string> &flightIds);
+
+// Lower-case name, e.g. "already_confirmed" (used by the request server)
+const char *toString(BookingResult result);
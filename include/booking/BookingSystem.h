@@ -2,7 +2,6 @@
 #pragma once
 
 #include "common/Types.h"
-#include <map>
 #include <string>
 #include <vector>
 // REMOVE Forward declarations:
@@ -10,31 +9,193 @@
 // struct Passenger;
 
 // ADD Includes for full definitions:
+#include "booking/BookingEvents.h"
+#include "booking/BookingRequest.h"
 #include "booking/Flight.h"
-#include "core/Passenger.h"
+#include "booking/FlightIndex.h"
+#include "booking/FlightStatus.h"
+#include "booking/RouteIndex.h"
+#include "booking/SeatHolds.h"
+#include "common/StringRef.h"
+#include "core/PassengerTable.h"
+#include "storage/BulkImport.h"
+#include "storage/MappedSnapshot.h"
+#include "storage/WriteAheadLog.h"
+#include <chrono>
+#include <cstdint>
 
 class BookingSystem {
 private:
-  // These map declarations now have the full type information for Flight and
-  // Passenger
-  std::map<std::string, Flight> flights;
-  std::map<PassengerIdType, Passenger> passengers;
-  PassengerIdType nextPassengerId;
+  // Every flight reports here. Journals state-changing events (when
+  // persistent), then hands them on to the user sink.
+  class JournalSink : public BookingEventSink {
+  private:
+    BookingSystem &owner;
+
+  public:
+    explicit JournalSink(BookingSystem &system) : owner(system) {}
+    void onEvent(const BookingEvent &event) override;
+  };
+
+  FlightIndex flights; // Live flights: interned IDs, contiguous storage
+  // Read-only flights of the last snapshot, mmap'ed at startup. A flight
+  // moves into 'flights' (materialized) the first time it is looked up for
+  // anything but listing; untouched ones are only ever read in place.
+  MappedSnapshot baseline;
+  PassengerTable passengers; // Dense by ID, hands out the next passenger ID
   PriorityType nextBookingPriority;
+  ConsoleEventSink consoleSink; // Prints booking events for the TUI
+  BookingEventSink *eventSink;  // User sink, may be nullptr
+  // Recovery or a bulk import is running: events are neither journaled
+  // nor sent on
+  bool muted;
+  // Origin/destination search, built by the first search and then kept in
+  // step by every seat change. routeKeys maps FlightHandle to route key;
+  // snapshot record i has key i, so a flight keeps its key when it is
+  // materialized.
+  RouteIndex routes;
+  std::vector<RouteIndex::Key> routeKeys;
+  bool routesBuilt;
+  SeatHolds holds; // Expiry of every held seat, keyed by FlightHandle
+
+  // Persistence, only used with a data directory
+  std::string dataDir;
+  WriteAheadLog journal;
+  JournalSink journalSink;
+  std::uint64_t checkpointLsn;       // Newest WAL record in the snapshot
+  std::uint64_t checkpointInterval;  // WAL records between snapshots
+
+  // Live handle for a flight ID, materializing a snapshot flight on first
+  // use; INVALID_FLIGHT_HANDLE if there is no such flight
+  FlightHandle resolveFlight(StringRef flightId);
+  Flight *findFlight(const std::string &flightId); // nullptr if unknown
+  bool hasFlight(const std::string &flightId) const;
+  void buildRoutes();
+  void indexRoute(FlightHandle handle); // A flight just added to 'flights'
+  void noteSeatChange(const BookingEvent &event);
+
+  BookingEventSink *flightSink(); // What flights report to
+  void journalEvent(const BookingEvent &event);
+  void recover();
+  // Imports bypass the WAL; a checkpoint makes the result durable at once,
+  // also after a failed import so memory and disk agree
+  template <typename Fn> ImportStats runImport(Fn importRows);
+  void applyJournalRecord(const WalRecord &record);
+  void journalHolds(); // A Held record for every outstanding hold
+  void releaseAllHolds();
+  void maybeCheckpoint();
 
   // --- Private TUI Helper Methods ---
   void clearScreen();
   void pressEnterToContinue();
   void displayMainMenu();
+  void printFlightRow(const Flight &flight);
   void listAllFlights();
   void viewFlightDetails();
   void addNewPassenger();
   void bookTicket();
   void cancelBooking();
   void addNewFlight();
+  void importData();
+  void searchFlights();
   void loadSampleData();
 
 public:
-  BookingSystem();
+  static const std::uint64_t DEFAULT_CHECKPOINT_INTERVAL = 1 << 20;
+
+  // Without a data directory everything lives in memory and the sample data
+  // is loaded. With one, state is recovered from its snapshot plus the WAL
+  // tail (sample data seeds a new directory), and every change is journaled
+  // from then on. Throws std::runtime_error if the files cannot be used.
+  explicit BookingSystem(const std::string &dataDir = "");
   void run();
+
+  // Routes booking events of all flights to 'sink' (not owned); nullptr
+  // silences them. Defaults to the console sink used by the TUI.
+  void setEventSink(BookingEventSink *sink);
+
+  // --- Programmatic Batch API (no TUI; events go to the installed sink) ---
+  // Requests are grouped by flight (one lookup per group) while waitlist
+  // priorities follow the order of the input within each request tier.
+  // Returns one result per request, in input order. Throws
+  // std::invalid_argument, before booking anything, if a tier is out of
+  // range.
+  std::vector<BookingResult>
+  bookBatch(const std::vector<BookingRequest> &requests);
+  std::vector<BookingResult>
+  cancelBatch(const std::vector<BookingRequest> &requests);
+  // Confirms a seat on every flight in 'flightIds' (e.g. a connection) or
+  // changes nothing: every leg is checked before the first is booked, and
+  // a full leg fails the itinerary instead of waitlisting. The legs are
+  // journaled as single bookings in one commit group, so recovery never
+  // sees part of an itinerary. Throws std::invalid_argument if
+  // 'flightIds' is empty or lists a flight twice.
+  ItineraryResult bookItinerary(PassengerIdType passengerId,
+                                const std::vector<std::string> &flightIds);
+
+  // --- Seat Holds (checkout with a payment step) ---
+  // holdSeat() takes a free seat for 'duration' without confirming it:
+  // Held, SoldOut (never waitlisted), UnknownFlight / UnknownPassenger, or
+  // AlreadyConfirmed / AlreadyWaitlisted / AlreadyHeld. confirmHold() turns
+  // the hold into a confirmed seat (Confirmed, or NotHeld once it is gone);
+  // releaseHold() gives it up (HoldReleased or NotHeld). A released or
+  // expired seat goes to the best waitlisted passenger, as on a cancel.
+  // Holds are journaled, but a restart releases every outstanding one.
+  BookingResult holdSeat(PassengerIdType passengerId,
+                         const std::string &flightId,
+                         std::chrono::milliseconds duration);
+  BookingResult confirmHold(PassengerIdType passengerId,
+                            const std::string &flightId);
+  BookingResult releaseHold(PassengerIdType passengerId,
+                            const std::string &flightId);
+  // Releases every hold due by 'now' and returns how many. Nothing expires
+  // on its own: the owner calls this periodically (the request server
+  // does every round). O(holds due), however many are outstanding.
+  std::size_t expireHolds(SeatHolds::Clock::time_point now =
+                              SeatHolds::Clock::now());
+  std::size_t getHoldCount() const;
+
+  PassengerIdType addPassenger(const std::string &name); // Returns the new ID
+  // Returns false (and changes nothing) if the flight ID is taken. Throws
+  // std::invalid_argument if a field does not fit a FlightCode.
+  bool addFlight(const std::string &flightId, const std::string &origin,
+                 const std::string &destination, int capacity,
+                 WaitlistBackend waitlistBackend = WaitlistBackend::Binomial);
+
+  // --- Bulk Import (file formats in storage/BulkImport.h) ---
+  // Streams the file through a fixed buffer; fields are never copied until
+  // they are stored. The tables are presized from the file size. Imports
+  // send no events. With a data directory the result is checkpointed once
+  // at the end instead of journaling every row. Throws std::runtime_error
+  // if the file cannot be read.
+  // Adds each flight in place; rows whose ID exists are skipped
+  ImportStats importSchedule(const std::string &path);
+  // Registers each passenger (IDs follow file order) and books those with
+  // a flight ID onto it, waitlist priorities in file order
+  ImportStats importManifest(const std::string &path);
+
+  // --- Durability (no-ops without a data directory) ---
+  // Changes are group-committed: a change is durable once the WAL group
+  // holding it is synced, which happens on its own every few thousand
+  // records or milliseconds. syncJournal() forces it, e.g. before telling
+  // a customer their booking went through. The TUI does so before every
+  // "Press Enter" prompt.
+  void syncJournal();
+  // Writes a fresh snapshot and empties the WAL. Also done automatically
+  // every checkpointInterval journal records and on exit from run().
+  void checkpoint();
+  void setCheckpointInterval(std::uint64_t records);
+
+  // Snapshot flights plus those added since; O(live flights)
+  std::size_t getFlightCount() const;
+  // False for an unknown flight. Reads a snapshot flight in place, without
+  // materializing it.
+  bool queryFlight(const std::string &flightId, FlightStatus &status) const;
+  // Appends the flights from 'origin' to 'destination' that have a free
+  // seat, with the seats left, and returns how many. The first call
+  // indexes every flight, O(flights); after that a search is O(results)
+  // and reads no Flight.
+  std::size_t findAvailableFlights(const std::string &origin,
+                                   const std::string &destination,
+                                   std::vector<RouteAvailability> &results);
 };
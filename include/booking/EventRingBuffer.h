@@ -0,0 +1,60 @@
+#pragma once // Header guard
+
+#include "booking/BookingEvents.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free single-producer/single-consumer queue of BookingEvents.
+// The booking thread is the producer (through onEvent()), one reader thread
+// drains it with tryPop(). When the ring is full new events are dropped and
+// counted instead of blocking the booking path.
+class EventRingBuffer : public BookingEventSink {
+private:
+  std::vector<BookingEvent> slots;
+  const std::size_t mask; // Capacity is a power of two
+
+  // Producer and consumer indices live on separate cache lines
+  alignas(64) std::atomic<std::size_t> writeIndex;
+  alignas(64) std::atomic<std::size_t> readIndex;
+  alignas(64) std::atomic<std::size_t> dropped;
+
+  static std::size_t roundUpToPowerOfTwo(std::size_t n) {
+    std::size_t capacity = 1;
+    while (capacity < n)
+      capacity <<= 1;
+    return capacity;
+  }
+
+public:
+  explicit EventRingBuffer(std::size_t minCapacity)
+      : slots(roundUpToPowerOfTwo(minCapacity > 0 ? minCapacity : 1)),
+        mask(slots.size() - 1), writeIndex(0), readIndex(0), dropped(0) {}
+
+  // Producer side
+  void onEvent(const BookingEvent &event) override {
+    const std::size_t write = writeIndex.load(std::memory_order_relaxed);
+    if (write - readIndex.load(std::memory_order_acquire) == slots.size()) {
+      dropped.fetch_add(1, std::memory_order_relaxed); // Full
+      return;
+    }
+    slots[write & mask] = event;
+    writeIndex.store(write + 1, std::memory_order_release);
+  }
+
+  // Consumer side
+  bool tryPop(BookingEvent &event) {
+    const std::size_t read = readIndex.load(std::memory_order_relaxed);
+    if (read == writeIndex.load(std::memory_order_acquire)) {
+      return false; // Empty
+    }
+    event = slots[read & mask];
+    readIndex.store(read + 1, std::memory_order_release);
+    return true;
+  }
+
+  std::size_t capacity() const { return slots.size(); }
+  std::size_t droppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+  }
+};
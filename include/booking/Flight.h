@@ -1,46 +1,170 @@
 #pragma once // Header guard
 
+#include "booking/BookingEvents.h"  // Event sink interface
+#include "booking/BookingRequest.h" // For BookingResult
+#include "common/InlineCode.h"
+#include "common/PriorityKey.h"
+#include "common/SmallVector.h"
+#include "common/StringRef.h"
 #include "common/Types.h"
-#include "core/Passenger.h"    // Needed for displayStatus signature
-#include "heap/BinomialHeap.h" // Contains a BinomialHeap member
-#include <map>                 // Needed for displayStatus signature
+#include "core/PassengerTable.h" // Needed for displayStatus signature
+#include "heap/Waitlist.h"         // Contains a Waitlist member
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+// Seat holders of a flight; the first few are kept inside the Flight
+using SeatList = SmallVector<PassengerIdType, 4>;
+
+// Per-flight memory is kept small for schedules of millions of flights:
+// the identity is inline (FlightCode), a flight with up to 4 seat holders
+// allocates no seat list, and one that never overflowed has no waitlist
+// heap.
 class Flight {
 private:
-  std::string flightId;
-  std::string origin;
-  std::string destination;
+  FlightCode flightId;
+  FlightCode origin;
+  FlightCode destination;
   int capacity;
-  std::vector<PassengerIdType> confirmedPassengers;
-  BinomialHeap waitlistHeap; // Binomial Heap for the waitlist
+  // Dense and unordered: removal swaps the last passenger into the hole
+  SeatList confirmedPassengers;
+  Waitlist waitlist; // Priority queue backend chosen per flight
+
+  // Where a passenger currently sits on this flight. One hash probe answers
+  // "confirmed?", "waitlisted?", "held?" and "where?" for both duplicate
+  // detection and cancellation.
+  static const int WAITLISTED = -1;
+  static const int HELD = -2;
+  struct BookingEntry {
+    int seatSlot; // Index into confirmedPassengers, WAITLISTED or HELD
+    Waitlist::Handle waitlistHandle; // nullptr unless waitlisted
+  };
+  std::unordered_map<PassengerIdType, BookingEntry> bookingIndex;
+  int heldSeats; // Seats neither free nor in confirmedPassengers
+
+  BookingEventSink *eventSink; // Not owned, nullptr keeps the flight silent
+
+  void emit(BookingEventType type, PassengerIdType passengerId,
+            PriorityType priority) const;
+  void confirmSeat(PassengerIdType passengerId); // Caller checks capacity
+  void releaseSeat(int seatSlot);                // O(1) swap-and-pop
+  bool hasFreeSeat() const; // Held seats count as taken
+  // Pops the best waitlisted passenger into the seat that just opened up.
+  // Caller ensures the waitlist is not empty.
+  void promoteFromWaitlist();
 
 public:
-  Flight(std::string id, std::string orig, std::string dest, int cap);
+  // Throws std::invalid_argument if the ID, origin or destination is
+  // longer than FlightCode::MAX_LENGTH
+  Flight(
+      StringRef id, StringRef orig, StringRef dest, int cap,
+      WaitlistBackend waitlistBackend = WaitlistBackend::Binomial,
+      BinomialHeap::InsertMode waitlistMode = BinomialHeap::InsertMode::Eager);
 
   // Accessors
-  std::string getFlightId() const;
-  std::string getOrigin() const;
-  std::string getDestination() const;
+  const FlightCode &getFlightId() const;
+  const FlightCode &getOrigin() const;
+  const FlightCode &getDestination() const;
   int getCapacity() const;
   int getBookedCount() const;
-  int getWaitlistCount() const; // Uses heap's getSize()
+  int getWaitlistCount() const; // O(1), heap caches its size
+  int getHeldCount() const;
+  // Seat holders in seat order (not booking order, see releaseSeat)
+  const SeatList &getConfirmedPassengers() const;
 
   // Core Operations
+  // The booking core never prints; every outcome is reported to the event
+  // sink (if any) and returned as a BookingResult.
+  BookingResult book(PassengerIdType passengerId, PriorityType priority);
+  // Promotes if possible. A hold is not a booking (NotBooked), it is
+  // ended with confirmHold() or releaseHold().
+  BookingResult cancel(PassengerIdType passengerId);
+  void setEventSink(BookingEventSink *sink);
+
+  // Convenience wrappers around book()/cancel()
   bool addPassenger(
       PassengerIdType passengerId,
       PriorityType priority); // Returns true if confirmed, false if waitlisted
   bool cancelBooking(
       PassengerIdType passengerId); // Returns true if successful (handles
-                                    // promotion from waitlist)
+                                    // promotion from waitlist, or removes
+                                    // the passenger from the waitlist)
+  // Batch variants: one BookingResult per input entry is appended to
+  // results. addPassengers() fills free seats in one pass and
+  // bulk-inserts the overflow into the waitlist heap. Like book(), it
+  // reports AlreadyWaitlisted with the priority the passenger keeps. If
+  // it throws (e.g. std::bad_alloc), the overflow is not booked; seats it
+  // confirmed before stay booked.
+  void addPassengers(
+      const std::vector<std::pair<PassengerIdType, PriorityType>> &batch,
+      std::vector<BookingResult> &results);
+  void cancelPassengers(const std::vector<PassengerIdType> &batch,
+                        std::vector<BookingResult> &results);
+  // Moves a waitlisted passenger up to newPriority (e.g. frequent flyer
+  // upgrade). Returns false if not waitlisted or newPriority is not better.
+  // Emits PriorityUpgraded on success.
+  bool upgradeWaitlistPriority(PassengerIdType passengerId,
+                               PriorityType newPriority);
+  // Same, moving the passenger to a higher tier while keeping their place
+  // in the booking sequence (see common/PriorityKey.h). Throws
+  // std::invalid_argument if the tier is out of range.
+  bool upgradeWaitlistTier(PassengerIdType passengerId, PriorityTier tier);
+  bool isConfirmed(PassengerIdType passengerId) const;
+  bool isWaitlisted(PassengerIdType passengerId) const;
+  // What book() would do, without doing it or emitting anything: Confirmed
+  // if a seat is free, SoldOut instead of Waitlisted, or AlreadyConfirmed /
+  // AlreadyWaitlisted / AlreadyHeld. Lets a multi-leg booking check every
+  // leg first.
+  BookingResult checkSeat(PassengerIdType passengerId) const;
+
+  // Seat holds (checkout): a held seat is taken, so later bookings are
+  // waitlisted, but the passenger is not confirmed until confirmHold().
+  // Expiry is up to the caller (see SeatHolds); an expired hold is
+  // released like a cancellation, promoting the best waitlisted passenger.
+  // Held, SoldOut (holds never waitlist), AlreadyConfirmed,
+  // AlreadyWaitlisted or AlreadyHeld
+  BookingResult holdSeat(PassengerIdType passengerId);
+  BookingResult confirmHold(PassengerIdType passengerId); // Or NotHeld
+  BookingResult releaseHold(PassengerIdType passengerId); // Or NotHeld
+  bool isHeld(PassengerIdType passengerId) const;
+  // Rebuilds a saved waitlist as is, even next to free (held) seats,
+  // instead of seating it. False if a passenger is already on the flight;
+  // the flight is then only fit to be discarded.
+  bool restoreWaitlist(
+      const std::vector<std::pair<PriorityType, PassengerIdType>> &entries);
+
+  // Folds 'other' into this flight (e.g. two under-sold frequencies of one
+  // route combined by ops). Its confirmed passengers take the free seats
+  // here in one pass; any beyond capacity are waitlisted ahead of every
+  // tier (BUMPED_TIER), in seat order, with the booking sequence numbers
+  // from 'firstSequence' on. The caller reserves other.getBookedCount()
+  // of them, as for a batch, so keys stay unique. Its waitlist is melded
+  // into this one (O(log n) for the binomial backend; entry by entry only
+  // if the backends differ) and keeps its priorities. A passenger already
+  // on this flight keeps their place here and is dropped from 'other'.
+  // Seats left free are then filled from the waitlist. 'other' ends empty.
+  // Every move reaches the event sinks as ordinary bookings: 'other'
+  // reports RemovedFromWaitlist, then Cancelled, for everyone on it, and
+  // this flight Confirmed for everyone seated here, then Waitlisted for
+  // everyone waiting here. Replaying them one by one gives the same state.
+  // Throws std::invalid_argument if 'other' has seats on hold: confirm or
+  // release them first.
+  void absorb(Flight &&other, PriorityType firstSequence);
+
+  // Switch to lazy waitlist inserts for insert-heavy periods (e.g. storms).
+  // Only affects the binomial backend.
+  void setWaitlistMode(BinomialHeap::InsertMode mode);
 
   // Display
-  // Takes passengerDb to look up names
-  void
-  displayStatus(const std::map<PassengerIdType, Passenger> &passengerDb) const;
+  // Takes passengerDb to look up names (O(1) per passenger)
+  void displayStatus(const PassengerTable &passengerDb) const;
+
+  // First k waitlisted passengers in priority order, {priority, id}.
+  // Read-only, the waitlist itself is left untouched.
+  std::vector<std::pair<PriorityType, PassengerIdType>>
+  getWaitlistTop(std::size_t k) const;
 
-  // Allow read-only access to heap if needed externally (e.g., for advanced
-  // display)
-  const BinomialHeap &getWaitlistHeap() const;
+  // Allow read-only access to the waitlist if needed externally (e.g., for
+  // advanced display)
+  const Waitlist &getWaitlist() const;
 };
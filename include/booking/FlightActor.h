@@ -0,0 +1,83 @@
+// include/booking/FlightActor.h
+#pragma once // Header guard
+
+#include "booking/BookingEvents.h"
+#include "booking/BookingRequest.h"
+#include "booking/Flight.h"
+#include "booking/FlightIndex.h"
+#include "booking/MpscQueue.h"
+#include "common/Types.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// One message for a FlightActor. Heap-allocated by the sender, owned and
+// deleted by the actor once executed.
+struct BookingCommand : MpscNode {
+  enum class Kind : std::uint8_t { AddFlight, Book, Cancel, Inspect };
+
+  Kind kind;
+  PassengerIdType passengerId;
+  PriorityType priority;
+  std::string flightId;
+
+  // Book/Cancel completion: callback if set, otherwise the promise
+  std::promise<BookingResult> result;
+  std::function<void(BookingResult)> callback;
+
+  // AddFlight payload and Inspect visitor; both complete through 'done',
+  // which belongs to the (waiting) sender
+  std::unique_ptr<Flight> newFlight;
+  std::function<void(const Flight *)> inspect; // nullptr for unknown flight
+  std::promise<bool> *done;
+
+  explicit BookingCommand(Kind k)
+      : kind(k), passengerId(INVALID_PASSENGER_ID), priority(MAX_PRIORITY),
+        done(nullptr) {}
+};
+
+// Single-writer owner of a group of flights. Its thread is the only one
+// that touches those flights, so no locks are needed around
+// Flight::book()/cancel() and waitlist promotion. Senders post commands to
+// a lock-free MPSC mailbox, and the actor drains it in batches. A hot
+// flight therefore sees a queue that keeps growing rather than threads
+// convoying on a mutex. When the mailbox runs dry the thread parks. A
+// sender wakes it only when it is actually parked.
+class FlightActor {
+private:
+  FlightIndex flights;
+  MpscQueue<BookingCommand> mailbox;
+  const std::size_t batchSize;
+  BookingEventSink *const eventSink; // Called from the actor thread
+  std::atomic<bool> sleeping; // Parked, or about to park
+  std::atomic<bool> stopping;
+  std::mutex parkMutex;
+  std::condition_variable parkCondition;
+  std::thread thread; // Last member: starts once the rest is constructed
+
+  void run();
+  void execute(BookingCommand &command);
+
+public:
+  static const std::size_t DEFAULT_BATCH_SIZE = 256;
+
+  // 'sink' (not owned, may be nullptr) is installed on every flight added
+  explicit FlightActor(BookingEventSink *sink = nullptr,
+                       std::size_t batchSize = DEFAULT_BATCH_SIZE);
+  // Executes everything already posted, then stops the thread. No post()
+  // may race with destruction.
+  ~FlightActor();
+
+  FlightActor(const FlightActor &) = delete;
+  FlightActor &operator=(const FlightActor &) = delete;
+
+  // Any thread. Takes ownership of the command.
+  void post(BookingCommand *command);
+};
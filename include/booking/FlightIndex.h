@@ -0,0 +1,111 @@
+// include/booking/FlightIndex.h
+#pragma once // Header guard
+
+#include "booking/Flight.h"
+#include "common/StringRef.h"
+#include "common/Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility> // For std::pair
+#include <vector>
+
+// Flights stored contiguously in fixed-size chunks and looked up by ID
+// through an open-addressing hash table (linear probing, power-of-two size,
+// load factor <= 1/2). Each flight ID is interned to a dense FlightHandle,
+// its insertion index, so later lookups are plain array indexing.
+// Chunks never move, so Flight addresses (held e.g. by queued
+// BookingEvents) stay valid while the index grows. Flights cannot be
+// removed. Iteration visits flights in the order they were added.
+class FlightIndex {
+private:
+  static const unsigned CHUNK_SHIFT = 8; // 256 flights per chunk
+  static const FlightHandle CHUNK_SIZE = FlightHandle(1) << CHUNK_SHIFT;
+
+  struct Slot {
+    std::uint32_t hash;  // Full hash of the ID, checked before the string
+    FlightHandle handle; // INVALID_FLIGHT_HANDLE marks an empty slot
+  };
+
+  std::vector<Flight *> chunks; // Raw storage for CHUNK_SIZE flights each
+  FlightHandle count;
+  std::vector<Slot> slots; // Size is 0 or a power of two
+  std::uint32_t mask;      // slots.size() - 1
+
+  // Slot holding flightId, or the empty slot where it would go
+  std::size_t probe(StringRef flightId, std::uint32_t hash) const;
+  void rehash(std::size_t slotCount);
+  // Grows the table if needed for one more flight, then probes
+  std::size_t prepareInsert(StringRef flightId, std::uint32_t hash);
+  void *allocateNext(); // Uninitialized storage for handle 'count'
+  FlightHandle commitInsert(std::size_t pos, std::uint32_t hash);
+
+public:
+  // Forward iterator over the stored flights in handle order
+  template <typename FlightT> class Iterator {
+  private:
+    Flight *const *chunks;
+    FlightHandle pos;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef FlightT value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef FlightT *pointer;
+    typedef FlightT &reference;
+
+    Iterator(Flight *const *c, FlightHandle p) : chunks(c), pos(p) {}
+    reference operator*() const {
+      return chunks[pos >> CHUNK_SHIFT][pos & (CHUNK_SIZE - 1)];
+    }
+    pointer operator->() const { return &**this; }
+    Iterator &operator++() {
+      ++pos;
+      return *this;
+    }
+    bool operator==(const Iterator &other) const { return pos == other.pos; }
+    bool operator!=(const Iterator &other) const { return pos != other.pos; }
+  };
+  typedef Iterator<Flight> iterator;
+  typedef Iterator<const Flight> const_iterator;
+
+  FlightIndex();
+  ~FlightIndex();
+
+  FlightIndex(const FlightIndex &) = delete;
+  FlightIndex &operator=(const FlightIndex &) = delete;
+
+  // Adds a flight unless one with the same ID exists. Returns the handle
+  // of the flight with that ID and whether it was inserted.
+  std::pair<FlightHandle, bool> insert(Flight flight);
+  // Same, but builds the flight directly in its final slot from the given
+  // fields, for bulk loads: the fields are copied once, into the Flight's
+  // inline codes, and nothing is built at all for a duplicate ID. Throws
+  // std::invalid_argument like the Flight constructor, leaving the index
+  // unchanged.
+  std::pair<FlightHandle, bool>
+  emplace(StringRef flightId, StringRef origin, StringRef destination,
+          int capacity,
+          WaitlistBackend waitlistBackend = WaitlistBackend::Binomial);
+  // INVALID_FLIGHT_HANDLE if no flight has this ID
+  FlightHandle find(StringRef flightId) const;
+  // Same, for callers that already computed hashId(flightId)
+  FlightHandle find(StringRef flightId, std::uint32_t hash) const;
+  static std::uint32_t hashId(StringRef flightId); // FNV-1a
+  // nullptr if no flight has this ID
+  Flight *lookup(const std::string &flightId);
+  const Flight *lookup(const std::string &flightId) const;
+
+  Flight &get(FlightHandle handle);
+  const Flight &get(FlightHandle handle) const;
+
+  void reserve(std::size_t flightCount); // Presizes the hash table
+  std::size_t size() const;
+  bool empty() const;
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+};
@@ -0,0 +1,24 @@
+// include/booking/FlightStatus.h
+#pragma once // Header guard
+
+#include "booking/Flight.h"
+#include <string>
+
+// Copy of the externally visible state of one flight, for callers that
+// must not hold on to the Flight itself (e.g. across a shard lock)
+struct FlightStatus {
+  std::string flightId;
+  std::string origin;
+  std::string destination;
+  int capacity;
+  int booked;
+  int waitlisted;
+  int held; // Seats held for checkout, neither free nor booked
+
+  FlightStatus() : capacity(0), booked(0), waitlisted(0), held(0) {}
+  explicit FlightStatus(const Flight &flight)
+      : flightId(flight.getFlightId().str()), origin(flight.getOrigin().str()),
+        destination(flight.getDestination().str()),
+        capacity(flight.getCapacity()), booked(flight.getBookedCount()),
+        waitlisted(flight.getWaitlistCount()), held(flight.getHeldCount()) {}
+};
@@ -0,0 +1,71 @@
+#pragma once // Header guard
+
+#include <atomic>
+
+// Link field for MpscQueue. Queued types derive from it, so pushing never
+// allocates.
+struct MpscNode {
+  std::atomic<MpscNode *> next;
+
+  MpscNode() : next(nullptr) {}
+};
+
+// Unbounded lock-free multi-producer/single-consumer intrusive queue
+// (Vyukov's algorithm). push() is one atomic exchange plus one store and
+// never blocks or fails. tryPop() is for the single consumer only. It may
+// briefly report empty while a concurrent push is half done, so consumers
+// that sleep must be woken by the producer after its push (see FlightActor).
+// T must derive from MpscNode and outlive its stay in the queue.
+template <typename T> class MpscQueue {
+private:
+  // Producers swing 'back'; the consumer alone reads from 'front'. The
+  // padding keeps the two ends off one cache line.
+  std::atomic<MpscNode *> back;
+  char padding[64];
+  MpscNode *front;
+  MpscNode stub; // Keeps the list non-empty
+
+  void pushNode(MpscNode *node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    MpscNode *prev = back.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+public:
+  MpscQueue() : back(&stub), front(&stub) {}
+
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+
+  // Producer side, any thread
+  void push(T *item) { pushNode(item); }
+
+  // Consumer side, one thread. nullptr if nothing can be taken right now.
+  T *tryPop() {
+    MpscNode *node = front;
+    MpscNode *next = node->next.load(std::memory_order_acquire);
+    if (node == &stub) {
+      if (next == nullptr) {
+        return nullptr; // Empty
+      }
+      front = next; // Skip the stub
+      node = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      front = next;
+      return static_cast<T *>(node);
+    }
+    if (node != back.load(std::memory_order_acquire)) {
+      return nullptr; // A producer has swung 'back' but not linked yet
+    }
+    // 'node' is the last element: re-insert the stub behind it
+    pushNode(&stub);
+    next = node->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      front = next;
+      return static_cast<T *>(node);
+    }
+    return nullptr;
+  }
+};
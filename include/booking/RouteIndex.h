@@ -0,0 +1,79 @@
+// include/booking/RouteIndex.h
+#pragma once // Header guard
+
+#include "common/StringRef.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One search hit: a flight with free seats on the requested route
+struct RouteAvailability {
+  StringRef flightId; // Borrowed from the caller of RouteIndex::add()
+  int seatsAvailable;
+};
+
+// Secondary index from (origin, destination) to flights with their number
+// of free seats, for availability search without touching any Flight.
+// Airport codes are interned to dense AirportIds, and each route keeps its
+// flights in one array partitioned into "seats left" and "full": a seat
+// count crossing zero swaps the entry over the boundary in O(1), so a
+// search returns the first part of the array in O(results).
+// Flights are identified by the dense Key that add() hands out; the index
+// never looks at them again, callers report every change of a seat count.
+class RouteIndex {
+public:
+  typedef std::uint32_t AirportId;
+  typedef std::uint32_t Key;
+  static const AirportId INVALID_AIRPORT = 0xFFFFFFFFu;
+  static const Key INVALID_KEY = 0xFFFFFFFFu;
+
+private:
+  struct Entry {
+    StringRef flightId;
+    int seatsAvailable;
+    Key key;
+  };
+  struct Route {
+    std::vector<Entry> flights; // [0, available) have seats left
+    std::size_t available;
+
+    Route() : available(0) {}
+  };
+  struct Location {
+    std::uint32_t route;
+    std::uint32_t position;
+  };
+
+  std::unordered_map<std::string, AirportId> airports;
+  std::unordered_map<std::uint64_t, std::uint32_t> routeIds; // Both airports
+  std::vector<Route> routes;
+  std::vector<Location> locations; // By Key
+
+  AirportId intern(StringRef code);
+  void swapEntries(Route &route, std::size_t a, std::size_t b);
+  static std::uint64_t routeId(AirportId origin, AirportId destination);
+
+public:
+  void reserve(std::size_t flightCount);
+  // Indexes a flight; 'flightId' must outlive the index. Keys count up
+  // from 0 in the order flights are added.
+  Key add(StringRef flightId, StringRef origin, StringRef destination,
+          int seatsAvailable);
+  void adjustSeats(Key key, int delta); // E.g. -1 for a confirmed booking
+  void setSeats(Key key, int seatsAvailable);
+  int getSeats(Key key) const;
+
+  // Appends the flights from 'origin' to 'destination' with at least one
+  // free seat to 'results', in no particular order; returns how many
+  std::size_t findAvailable(const std::string &origin,
+                            const std::string &destination,
+                            std::vector<RouteAvailability> &results) const;
+  AirportId findAirport(const std::string &code) const; // Or INVALID_AIRPORT
+
+  std::size_t size() const; // Flights indexed
+  std::size_t getAirportCount() const;
+  std::size_t getRouteCount() const;
+  void clear();
+};
@@ -0,0 +1,83 @@
+// include/booking/SeatHolds.h
+#pragma once // Header guard
+
+#include "common/Types.h"
+#include "heap/TimerWheel.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Expiry bookkeeping for seat holds. The seat itself is held by the
+// Flight (Flight::holdSeat); this only remembers when each hold runs out.
+// Flights are named by a caller-chosen 64-bit key (a FlightHandle, or
+// shard and handle). Deadlines sit in a TimerWheel of millisecond ticks,
+// so add() and remove() are O(1) and expire() touches only the holds that
+// are due, however many are outstanding. Not thread-safe.
+class SeatHolds {
+public:
+  using Clock = std::chrono::steady_clock;
+
+private:
+  struct Key {
+    std::uint64_t flight;
+    PassengerIdType passengerId;
+
+    bool operator==(const Key &other) const {
+      return flight == other.flight && passengerId == other.passengerId;
+    }
+  };
+  struct KeyHash {
+    std::size_t operator()(const Key &key) const {
+      return static_cast<std::size_t>(
+          (key.flight * 0x9E3779B97F4A7C15ull) ^
+          static_cast<std::uint32_t>(key.passengerId));
+    }
+  };
+  struct Record {
+    Key key;
+    TimerWheel::TimerId timer;
+  };
+
+  Clock::time_point epoch; // Tick 0 of the wheel
+  TimerWheel wheel;        // Payload: index into 'records'
+  std::vector<Record> records;
+  std::vector<std::uint32_t> freeRecords;
+  std::unordered_map<Key, std::uint32_t, KeyHash> index;
+
+  TimerWheel::Tick toTick(Clock::time_point time) const;
+
+public:
+  SeatHolds();
+
+  SeatHolds(const SeatHolds &) = delete;
+  SeatHolds &operator=(const SeatHolds &) = delete;
+
+  // False (and nothing changes) if the passenger already holds this flight
+  bool add(std::uint64_t flight, PassengerIdType passengerId,
+           Clock::time_point expiry);
+  bool remove(std::uint64_t flight, PassengerIdType passengerId);
+  bool contains(std::uint64_t flight, PassengerIdType passengerId) const;
+
+  // Removes every hold due by 'now' and calls fn(flight, passengerId) for
+  // each, earliest first; fn may add and remove holds
+  template <typename Fn> std::size_t expire(Clock::time_point now, Fn fn) {
+    return wheel.advance(toTick(now), [this, &fn](std::uint32_t slot) {
+      const Key key = records[slot].key;
+      index.erase(key);
+      freeRecords.push_back(slot);
+      fn(key.flight, key.passengerId);
+    });
+  }
+
+  // Calls fn(flight, passengerId) for every hold, in no particular order.
+  // fn must not add or remove holds.
+  template <typename Fn> void forEach(Fn fn) const {
+    for (const auto &entry : index) {
+      fn(entry.first.flight, entry.first.passengerId);
+    }
+  }
+
+  std::size_t size() const;
+};
@@ -0,0 +1,152 @@
+// include/booking/ShardedBookingEngine.h
+#pragma once // Header guard
+
+#include "booking/BookingEvents.h"
+#include "booking/BookingRequest.h"
+#include "booking/Flight.h"
+#include "booking/FlightIndex.h"
+#include "booking/FlightStatus.h"
+#include "booking/SeatHolds.h"
+#include "booking/StatusBoard.h"
+#include "common/Types.h"
+#include "core/PassengerRegistry.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Thread-safe booking core for concurrent callers (no TUI).
+// Flights are spread over a fixed number of shards by the hash of their ID.
+// Each shard is a FlightIndex behind its own mutex, so operations on flights
+// in different shards never contend. Use many more shards than cores to
+// keep hot routes apart. Operations on a single flight are serialized, as
+// the flight state requires.
+// Booking priorities and passenger IDs come from atomic counters, so
+// callers never take a global lock. Status queries take no lock at all:
+// every change to a flight is published to its StatusCell, which readers
+// find through the lock-free StatusBoard.
+class ShardedBookingEngine {
+private:
+  // Starts and ends on a cache line boundary, so no other shard or heap
+  // block shares the line of its mutex. C++11 new ignores extended
+  // alignment, hence the class allocation functions.
+  struct alignas(64) Shard {
+    std::mutex mutex;
+    FlightIndex flights;
+    std::vector<StatusCell *> status; // By FlightHandle, owned by the board
+
+    static void *operator new(std::size_t size);
+    static void operator delete(void *block) noexcept;
+  };
+
+  std::vector<std::unique_ptr<Shard>> shards;
+  std::atomic<PriorityType> nextBookingPriority;
+
+  PassengerRegistry passengers; // Lock-free ID checks
+
+  std::atomic<BookingEventSink *> eventSink; // Not owned, see setEventSink
+
+  StatusBoard statusBoard;
+
+  // Hold deadlines of all shards, keyed by holdKey(). Lock order: a shard
+  // mutex before holdsMutex, never the other way round.
+  mutable std::mutex holdsMutex;
+  SeatHolds holds;
+
+  static std::uint64_t holdKey(std::size_t shard, FlightHandle handle);
+  std::size_t shardIndex(std::uint32_t hash) const;
+  Shard &shardFor(std::uint32_t hash) const;
+
+public:
+  static const unsigned DEFAULT_SHARD_COUNT = 64;
+
+  explicit ShardedBookingEngine(unsigned shardCount = DEFAULT_SHARD_COUNT);
+
+  ShardedBookingEngine(const ShardedBookingEngine &) = delete;
+  ShardedBookingEngine &operator=(const ShardedBookingEngine &) = delete;
+
+  // Installs 'sink' (not owned, nullptr silences) on every current and
+  // future flight. The sink is invoked concurrently from the booking
+  // threads, under the lock of the flight's shard, so it must be
+  // thread-safe. Call it before booking starts.
+  void setEventSink(BookingEventSink *sink);
+
+  // --- All of the following are safe to call concurrently ---
+
+  // Returns false if a flight with this ID already exists. Throws
+  // std::invalid_argument if a field does not fit a FlightCode.
+  bool addFlight(const std::string &flightId, const std::string &origin,
+                 const std::string &destination, int capacity,
+                 WaitlistBackend waitlistBackend = WaitlistBackend::Binomial);
+  PassengerIdType addPassenger(const std::string &name); // Returns the new ID
+  bool hasPassenger(PassengerIdType passengerId) const;  // Lock-free
+  std::string getPassengerName(PassengerIdType passengerId) const;
+
+  // Priority is taken from the shared counter (first come, first served)
+  BookingResult book(PassengerIdType passengerId, const std::string &flightId);
+  BookingResult cancel(PassengerIdType passengerId,
+                       const std::string &flightId);
+  // One result per request, in input order. Each flight is locked once
+  // per run of consecutive requests for it, and priorities follow input
+  // order like in BookingSystem::bookBatch(), which also rejects
+  // out-of-range tiers the same way.
+  std::vector<BookingResult>
+  bookBatch(const std::vector<BookingRequest> &requests);
+  // Same grouping for cancellations
+  std::vector<BookingResult>
+  cancelBatch(const std::vector<BookingRequest> &requests);
+
+  // Confirms a seat on every flight in 'flightIds' or changes nothing (a
+  // full leg is never waitlisted). The shards of all legs are locked at
+  // once, in ascending shard order, so concurrent itineraries cannot
+  // deadlock and no other booking can take a seat between the check and
+  // the sale. Throws std::invalid_argument if 'flightIds' is empty or
+  // lists a flight twice.
+  ItineraryResult bookItinerary(PassengerIdType passengerId,
+                                const std::vector<std::string> &flightIds);
+
+  // Seat holds as in BookingSystem::holdSeat(), in memory only. An expired
+  // hold that was confirmed or re-held in the meantime is left alone.
+  BookingResult holdSeat(PassengerIdType passengerId,
+                         const std::string &flightId,
+                         std::chrono::milliseconds duration);
+  BookingResult confirmHold(PassengerIdType passengerId,
+                            const std::string &flightId);
+  BookingResult releaseHold(PassengerIdType passengerId,
+                            const std::string &flightId);
+  // Any thread may call this; the due holds are taken under holdsMutex,
+  // then each is released under its own shard lock
+  std::size_t expireHolds(SeatHolds::Clock::time_point now =
+                              SeatHolds::Clock::now());
+  std::size_t getHoldCount() const;
+
+  // Counters of the flight as of its last change, without taking its
+  // shard lock, so status reads scale with the readers and never hold up
+  // a booking. False for an unknown flight.
+  bool readStatus(const std::string &flightId, FlightCounters &counters) const;
+  // Same, with the flight's identity
+  bool queryFlight(const std::string &flightId, FlightStatus &status) const;
+
+  // Runs fn(const Flight &) under the flight's shard lock. Returns false
+  // (without calling fn) for an unknown flight. fn must not call back
+  // into the engine.
+  template <typename Fn>
+  bool withFlight(const std::string &flightId, Fn fn) const {
+    std::uint32_t hash = FlightIndex::hashId(flightId);
+    Shard &shard = shardFor(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    FlightHandle handle = shard.flights.find(flightId, hash);
+    if (handle == INVALID_FLIGHT_HANDLE) {
+      return false;
+    }
+    fn(static_cast<const Flight &>(shard.flights.get(handle)));
+    return true;
+  }
+
+  unsigned getShardCount() const;
+  std::size_t getFlightCount() const; // Locks every shard in turn
+};
@@ -0,0 +1,101 @@
+// include/booking/StatusBoard.h
+#pragma once // Header guard
+
+#include "booking/Flight.h"
+#include "common/InlineCode.h"
+#include "common/StringRef.h"
+#include "common/Types.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Counters of one flight as of one published version
+struct FlightCounters {
+  std::uint64_t version; // Grows with every publish(); equal means unchanged
+  int capacity;
+  int booked;
+  int waitlisted;
+  int held;
+  PassengerIdType nextWaitlistedId; // INVALID_PASSENGER_ID if none
+  PriorityType nextWaitlistedPriority; // MAX_PRIORITY if none
+
+  FlightCounters()
+      : version(0), capacity(0), booked(0), waitlisted(0), held(0),
+        nextWaitlistedId(INVALID_PASSENGER_ID),
+        nextWaitlistedPriority(MAX_PRIORITY) {}
+};
+
+// Read side of one flight for lock-free queries. The identity is fixed at
+// construction; the counters are a seqlock: the single writer (holding
+// the flight's lock) makes the sequence odd, stores, and makes it even
+// again, and a reader retries until it saw the same even sequence before
+// and after copying. Readers never block the writer and never write.
+class StatusCell {
+private:
+  const FlightCode flightId;
+  const FlightCode origin;
+  const FlightCode destination;
+  const std::uint32_t hash; // FlightIndex::hashId(flightId)
+
+  std::atomic<std::uint64_t> sequence; // Odd while a publish is under way
+  std::atomic<int> capacity;
+  std::atomic<int> booked;
+  std::atomic<int> waitlisted;
+  std::atomic<int> held;
+  std::atomic<PassengerIdType> nextWaitlistedId;
+  std::atomic<PriorityType> nextWaitlistedPriority;
+
+public:
+  explicit StatusCell(const Flight &flight);
+
+  StatusCell(const StatusCell &) = delete;
+  StatusCell &operator=(const StatusCell &) = delete;
+
+  // Copies the counters of 'flight'. Callers serialize publishes to a
+  // cell (the engine holds the shard lock).
+  void publish(const Flight &flight);
+  FlightCounters read() const; // Lock-free
+
+  const FlightCode &getFlightId() const;
+  const FlightCode &getOrigin() const;
+  const FlightCode &getDestination() const;
+  std::uint32_t getHash() const;
+};
+
+// Directory from flight ID to StatusCell that readers probe without a
+// lock. Insert-only: slots go from empty to a cell exactly once, with a
+// release store, so a reader sees either nothing or a complete cell. When
+// the table fills up a doubled copy is published; the old one stays
+// allocated (the tables add up to less than twice the current one) so
+// readers still probing it are safe without any reclamation scheme.
+class StatusBoard {
+private:
+  struct Table {
+    std::unique_ptr<std::atomic<StatusCell *>[]> slots;
+    std::uint32_t mask; // Slot count - 1, a power of two
+
+    explicit Table(std::size_t slotCount);
+    void insert(StatusCell *cell); // Writer only
+  };
+
+  std::mutex writerMutex; // Serializes add()
+  std::vector<std::unique_ptr<StatusCell>> cells;
+  std::vector<std::unique_ptr<Table>> tables; // Current one last
+  std::atomic<const Table *> current;
+
+public:
+  StatusBoard();
+
+  StatusBoard(const StatusBoard &) = delete;
+  StatusBoard &operator=(const StatusBoard &) = delete;
+
+  // Adds a cell for a flight ID not on the board yet and publishes it;
+  // the cell lives as long as the board
+  StatusCell *add(const Flight &flight);
+  // nullptr for an unknown flight. Lock-free.
+  const StatusCell *find(StringRef flightId, std::uint32_t hash) const;
+};
@@ -0,0 +1,59 @@
+// include/common/InlineCode.h
+#pragma once // Header guard
+
+#include "common/StringRef.h"
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <stdexcept> // For std::invalid_argument
+#include <string>
+
+// Short string of at most N - 1 characters stored in place: N bytes, no
+// allocation and no pointer to chase. Used for the identity of a flight
+// (ID, origin, destination), which is fixed once the flight exists.
+// Converts to StringRef, so it can be hashed, compared and written like
+// any other field. Longer text is rejected with std::invalid_argument;
+// input paths check fits() first.
+template <std::size_t N> class InlineCode {
+  static_assert(N >= 2 && N <= 256, "Length must fit the length byte");
+
+private:
+  char chars[N - 1];
+  unsigned char length;
+
+public:
+  static const std::size_t MAX_LENGTH = N - 1;
+
+  static bool fits(StringRef text) { return text.size <= MAX_LENGTH; }
+
+  InlineCode() : length(0) {}
+  InlineCode(StringRef text) : length(static_cast<unsigned char>(text.size)) {
+    if (!fits(text)) {
+      throw std::invalid_argument("'" + text.str() + "' is longer than " +
+                                  std::to_string(MAX_LENGTH) + " characters");
+    }
+    std::memcpy(chars, text.data, text.size);
+  }
+
+  const char *data() const { return chars; }
+  std::size_t size() const { return length; }
+  bool empty() const { return length == 0; }
+  std::string str() const { return std::string(chars, length); }
+  operator StringRef() const { return StringRef(chars, length); }
+
+  friend bool operator==(const InlineCode &code, StringRef text) {
+    return StringRef(code) == text;
+  }
+  friend bool operator!=(const InlineCode &code, StringRef text) {
+    return !(code == text);
+  }
+  // Honors the stream's width and fill, like a std::string
+  friend std::ostream &operator<<(std::ostream &out, const InlineCode &code) {
+    return out << code.str();
+  }
+};
+
+template <std::size_t N> const std::size_t InlineCode<N>::MAX_LENGTH;
+
+// Flight ID, origin and destination: up to 15 characters each
+using FlightCode = InlineCode<16>;
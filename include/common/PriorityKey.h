@@ -0,0 +1,88 @@
+// include/common/PriorityKey.h
+#pragma once // Header guard
+
+#include "common/Types.h"
+#include <cassert>
+#include <cstdint>
+#include <stdexcept> // For std::invalid_argument
+#include <string>
+
+// Waitlist priority keys. A key packs a tier and a booking sequence into one
+// signed 64-bit integer so that plain integer order is the serving order:
+//   key = sequence - tier * 2^SEQUENCE_BITS,  0 <= sequence < 2^SEQUENCE_BITS
+// A higher tier (fare class, loyalty level) sorts ahead of every lower one,
+// and within a tier earlier bookings come first. Standard tier keys are just
+// the sequence number handed out by the booking counter, so a waitlist that
+// never sees a tier is ordered exactly as before. Heaps compare keys as
+// integers and never unpack them.
+using PriorityTier = int;
+
+const int PRIORITY_SEQUENCE_BITS = 56;
+const PriorityTier STANDARD_TIER = 0;
+const PriorityTier MAX_TIER = 127; // MIN_PRIORITY stays below every tier
+const PriorityType PRIORITY_SEQUENCE_MASK =
+    (PriorityType(1) << PRIORITY_SEQUENCE_BITS) - 1;
+
+// Tiers below standard or above MAX_TIER would overflow the key
+inline bool isValidTier(PriorityTier tier) {
+  return tier >= STANDARD_TIER && tier <= MAX_TIER;
+}
+
+// For the public entry points that take a tier from the caller
+inline void requireValidTier(PriorityTier tier) {
+  if (!isValidTier(tier)) {
+    throw std::invalid_argument("Waitlist tier " + std::to_string(tier) +
+                                " is outside [0, " +
+                                std::to_string(MAX_TIER) + "]");
+  }
+}
+
+// Callers check the tier first (isValidTier)
+inline PriorityType makePriority(PriorityTier tier, PriorityType sequence) {
+  assert(isValidTier(tier));
+  // Multiply, not shift: left-shifting a negative value is undefined
+  return (sequence & PRIORITY_SEQUENCE_MASK) -
+         static_cast<PriorityType>(tier) *
+             (PriorityType(1) << PRIORITY_SEQUENCE_BITS);
+}
+
+inline PriorityType prioritySequence(PriorityType key) {
+  return key & PRIORITY_SEQUENCE_MASK;
+}
+
+inline PriorityTier priorityTier(PriorityType key) {
+  return static_cast<PriorityTier>(-((key - prioritySequence(key)) /
+                                     (PriorityType(1)
+                                      << PRIORITY_SEQUENCE_BITS)));
+}
+
+// Same booking sequence, moved to 'tier'
+inline PriorityType withTier(PriorityType key, PriorityTier tier) {
+  return makePriority(tier, prioritySequence(key));
+}
+
+// Reserved tier above MAX_TIER for confirmed passengers that
+// Flight::absorb() moves onto a full flight. Its keys start at
+// MIN_PRIORITY, so they are served ahead of every booking tier, and carry
+// a sequence from the booking counter like any other key.
+const PriorityTier BUMPED_TIER = MAX_TIER + 1;
+
+inline PriorityType makeBumpedPriority(PriorityType sequence) {
+  return MIN_PRIORITY + (sequence & PRIORITY_SEQUENCE_MASK);
+}
+
+// Orders in which a heap can serve keys, fixed at compile time. Only the
+// packed key order exists so far; another order is a new enumerator plus
+// its PriorityLess specialization.
+enum class PriorityOrder {
+  Tiered // Tier first, then booking sequence: the packed key order
+};
+
+// Strict weak ordering over keys, for heaps and sorts that are templated on
+// their comparator. Each order is its own specialization, so the compare
+// inlines to a single integer comparison with no runtime dispatch.
+template <PriorityOrder Order = PriorityOrder::Tiered> struct PriorityLess;
+
+template <> struct PriorityLess<PriorityOrder::Tiered> {
+  bool operator()(PriorityType a, PriorityType b) const { return a < b; }
+};
@@ -0,0 +1,108 @@
+// include/common/SmallVector.h
+#pragma once // Header guard
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib> // For std::malloc, std::free
+#include <cstring> // For std::memcpy
+#include <new>     // For std::bad_alloc
+#include <type_traits>
+
+// Vector of trivially copyable values that keeps up to N of them in place
+// and only allocates once it grows past N. The inline buffer shares its
+// bytes with the heap pointer, so for N * sizeof(T) <= 16 the whole object
+// is 24 bytes, the size of a std::vector. Elements are moved with memcpy
+// and growth doubles the capacity. Move-only.
+template <typename T, std::size_t N> class SmallVector {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SmallVector moves elements with memcpy");
+  static_assert(N > 0, "Use std::vector without an inline buffer");
+
+private:
+  std::uint32_t count;
+  std::uint32_t capacity; // N while inline
+  union {
+    T *heap;
+    T local[N];
+  };
+
+  bool isInline() const { return capacity == N; }
+
+  void grow() {
+    const std::size_t newCapacity = std::size_t(capacity) * 2;
+    T *grown = static_cast<T *>(std::malloc(newCapacity * sizeof(T)));
+    if (grown == nullptr) {
+      throw std::bad_alloc();
+    }
+    std::memcpy(grown, data(), count * sizeof(T));
+    release();
+    heap = grown;
+    capacity = static_cast<std::uint32_t>(newCapacity);
+  }
+
+  void release() {
+    if (!isInline()) {
+      std::free(heap);
+    }
+  }
+
+  void steal(SmallVector &other) {
+    count = other.count;
+    capacity = other.capacity;
+    if (other.isInline()) {
+      std::memcpy(local, other.local, count * sizeof(T));
+    } else {
+      heap = other.heap;
+    }
+    other.count = 0;
+    other.capacity = N;
+  }
+
+public:
+  typedef T value_type;
+  typedef T *iterator;
+  typedef const T *const_iterator;
+
+  SmallVector() : count(0), capacity(N) {}
+  ~SmallVector() { release(); }
+
+  SmallVector(const SmallVector &) = delete;
+  SmallVector &operator=(const SmallVector &) = delete;
+  SmallVector(SmallVector &&other) noexcept { steal(other); }
+  SmallVector &operator=(SmallVector &&other) noexcept {
+    if (this != &other) {
+      release();
+      steal(other);
+    }
+    return *this;
+  }
+
+  T *data() { return isInline() ? local : heap; }
+  const T *data() const { return isInline() ? local : heap; }
+  std::size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  bool isAllocated() const { return !isInline(); }
+
+  T &operator[](std::size_t i) { return data()[i]; }
+  const T &operator[](std::size_t i) const { return data()[i]; }
+  T &back() { return data()[count - 1]; }
+  const T &back() const { return data()[count - 1]; }
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + count; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + count; }
+
+  void push_back(const T &value) {
+    if (count == capacity) {
+      const T copy = value; // 'value' may live in the buffer being freed
+      grow();
+      data()[count++] = copy;
+      return;
+    }
+    data()[count++] = value;
+  }
+  void pop_back() { --count; }
+  // Keeps any allocated buffer, like std::vector::clear()
+  void clear() { count = 0; }
+};
@@ -0,0 +1,27 @@
+// include/common/StringRef.h
+#pragma once // Header guard
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+// Non-owning view of a character range (C++11 has no std::string_view).
+// Used by the bulk importers to hand out fields that still point into the
+// read buffer; valid only as long as that buffer is.
+struct StringRef {
+  const char *data;
+  std::size_t size;
+
+  StringRef() : data(""), size(0) {}
+  StringRef(const char *d, std::size_t n) : data(d), size(n) {}
+  StringRef(const char *s) : data(s), size(std::strlen(s)) {}
+  StringRef(const std::string &s) : data(s.data()), size(s.size()) {}
+
+  bool empty() const { return size == 0; }
+  std::string str() const { return std::string(data, size); }
+
+  bool operator==(const StringRef &other) const {
+    return size == other.size && std::memcmp(data, other.data, size) == 0;
+  }
+  bool operator!=(const StringRef &other) const { return !(*this == other); }
+};
@@ -1,12 +1,20 @@
 #pragma once // Header guard
 
+#include <cstdint>
 #include <limits>
 
 // Define common types used throughout the project
-using PriorityType = int; // Lower value means HIGHER priority
+// Lower value means HIGHER priority. Packs a tier and a booking sequence,
+// see common/PriorityKey.h
+using PriorityType = std::int64_t;
 using PassengerIdType = int;
 
 const PriorityType MAX_PRIORITY = std::numeric_limits<PriorityType>::max();
 const PriorityType MIN_PRIORITY =
     std::numeric_limits<PriorityType>::min(); // Useful for decreaseKey/delete
 const PassengerIdType INVALID_PASSENGER_ID = -1;
+
+// Interned flight ID: dense index of a flight in the FlightIndex
+using FlightHandle = std::uint32_t;
+const FlightHandle INVALID_FLIGHT_HANDLE =
+    std::numeric_limits<FlightHandle>::max();
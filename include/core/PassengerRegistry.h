@@ -0,0 +1,29 @@
+#pragma once // Header guard
+
+#include "common/Types.h"
+#include "core/PassengerTable.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+
+// Thread-safe wrapper around a PassengerTable for the concurrent engines.
+// Appends are serialized by a mutex; each new record is published through
+// an atomic next-ID so contains() is a lock-free acquire load that never
+// touches the table.
+class PassengerRegistry {
+private:
+  mutable std::mutex mutex;
+  PassengerTable table;
+  std::atomic<PassengerIdType> nextId; // Every ID below it is complete
+
+public:
+  PassengerRegistry();
+
+  PassengerRegistry(const PassengerRegistry &) = delete;
+  PassengerRegistry &operator=(const PassengerRegistry &) = delete;
+
+  PassengerIdType add(const std::string &name); // Returns the new ID
+  bool contains(PassengerIdType passengerId) const; // Lock-free
+  // Empty string for an unknown ID
+  std::string getName(PassengerIdType passengerId) const;
+};
@@ -0,0 +1,56 @@
+#pragma once // Header guard
+
+#include "common/StringRef.h"
+#include "common/Types.h" // Include common type definitions
+#include "core/Passenger.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Passenger records indexed by their dense, sequential IDs (struct of
+// arrays). Record i has ID firstId + i. All names live back to back in one
+// character arena; nameOffsets[i] .. nameOffsets[i + 1] is the name of
+// record i, so a passenger costs 8 bytes of index plus its name bytes and
+// there is no per-record allocation. Records are append-only.
+class PassengerTable {
+private:
+  PassengerIdType firstId;
+  std::vector<std::uint64_t> nameOffsets; // size() + 1 entries, starts at 0
+  std::string nameArena;
+
+  std::size_t indexOf(PassengerIdType id) const;
+
+public:
+  explicit PassengerTable(PassengerIdType firstId = 1);
+
+  // Appends a record and returns its ID (the next sequential one)
+  PassengerIdType add(StringRef name);
+  // O(1) range check, replaces a tree lookup
+  bool contains(PassengerIdType id) const;
+  PassengerIdType nextId() const; // ID the next add() will return
+
+  // Name accessors, callers check contains() first
+  const char *nameData(PassengerIdType id) const;
+  std::size_t nameLength(PassengerIdType id) const;
+  std::string getName(PassengerIdType id) const;
+  // Writes the name without building a std::string
+  void writeName(std::ostream &os, PassengerIdType id) const;
+  // Materializes a Passenger value (copies the name)
+  Passenger get(PassengerIdType id) const;
+
+  // Raw storage for bulk persistence: size() + 1 offsets into the arena
+  PassengerIdType getFirstId() const;
+  const std::uint64_t *getNameOffsets() const;
+  const char *getNameArena() const;
+  std::size_t getNameArenaSize() const;
+  // Replaces the contents with 'count' records copied from raw storage in
+  // that layout (offsets[0] == 0, non-decreasing). Two bulk copies.
+  void assign(PassengerIdType firstId, const std::uint64_t *offsets,
+              std::size_t count, const char *arena);
+
+  void reserve(std::size_t records, std::size_t nameBytes);
+  std::size_t size() const;
+  bool empty() const;
+};
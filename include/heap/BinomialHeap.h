@@ -2,31 +2,78 @@
 
 #pragma once // Header guard
 
+#include "common/PriorityKey.h" // Key order
 #include "common/Types.h"
 #include "heap/BinomialHeapNode.h" // Node definition
-#include <list>
-#include <stdexcept> // For runtime_error
-#include <utility>   // For std::pair
+#include "heap/NodePool.h"         // Slab allocator for nodes
+#include <stdexcept>               // For runtime_error
+#include <utility>                 // For std::pair
 #include <vector>
 
 class BinomialHeap {
+public:
+  // Returned by insert(), valid until the entry is extracted or erased
+  using Handle = BinomialHeapHandle *;
+  using Entry = std::pair<PriorityType, PassengerIdType>; // {priority, id}
+
+  // Eager: every insert is merged into the root list right away.
+  // Lazy: inserts only push a degree-0 root (O(1)); roots are consolidated
+  // on the next extractMin()/erase(). Suits bursts of inserts
+  // with few extractions, e.g. a cancellation storm filling waitlists.
+  enum class InsertMode { Eager, Lazy };
+
 private:
-  std::list<BinomialHeapNode *> roots; // Root list
+  // Root list, chained intrusively through BinomialHeapNode::sibling and kept
+  // in increasing order of degree. No separate list cells are allocated.
+  // In lazy mode the chain may additionally hold unsorted degree-0 roots
+  // until consolidation.
+  BinomialHeapNode *head;
+  BinomialHeapNode *minNode; // Root holding the minimum, nullptr when empty
+  bool hasPendingRoots;      // Lazy inserts not yet consolidated
+  int size;                  // Number of nodes, maintained incrementally
+  InsertMode insertMode;
+  std::vector<BinomialHeapNode *> degreeTable; // Reused consolidation scratch
+  NodePool<BinomialHeapNode> pool; // Owns the storage of every node
+  NodePool<BinomialHeapHandle> handlePool; // Owns the handle cells
+
+  // Packed tier + sequence keys: a single integer compare, inlined
+  using KeyLess = PriorityLess<PriorityOrder::Tiered>;
+  static bool before(const BinomialHeapNode *a, const BinomialHeapNode *b) {
+    return KeyLess()(a->priority, b->priority);
+  }
 
   // --- Private Helper Methods ---
-  // ADD DECLARATION HERE:
-  void link(BinomialHeapNode *y, BinomialHeapNode *z);
+  static void link(BinomialHeapNode *y, BinomialHeapNode *z);
 
-  void mergeRootLists(BinomialHeap &other_heap);
+  // Merges a degree-sorted root chain into this heap's root list (no linking)
+  void mergeRootLists(BinomialHeapNode *other_head);
+  // Links roots of equal degree until every degree occurs at most once
   void consolidate();
-  // Make findMinNodeIterator const as it doesn't modify state
-  std::list<BinomialHeapNode *>::const_iterator findMinNodeIterator() const;
-  void collectNodes(
-      BinomialHeapNode *node,
-      std::vector<BinomialHeapNode *> &nodes_list); // For destructor/clear
+  // Same, for an unsorted root chain (bucketed by degree); restores order
+  void consolidatePendingRoots();
+  // Eager insert: links the new head root with the next one while their
+  // degrees match and stops at the first mismatch, like the carry of a
+  // binary increment. Needs an otherwise consolidated chain.
+  void carryHead();
+  // Predecessor of a root in the chain (nullptr if it is the head)
+  BinomialHeapNode *findRootPredecessor(BinomialHeapNode *root) const;
+  void recomputeMin(); // Rescans the roots to refresh minNode
+  // Swaps payloads (key, data, handle) between a node and its parent
+  void swapWithParent(BinomialHeapNode *node);
+  // Unlinks a root, merges its children back and frees it
+  void removeRoot(BinomialHeapNode *root, BinomialHeapNode *prev);
+  // One binomial tree of the given order over 2^order consecutive entries,
+  // built depth-first; handles are written in entry order
+  BinomialHeapNode *buildTree(const Entry *entries, int order,
+                              Handle *handles);
+  // Trees for the set bits of 'count', as a chain of increasing degree
+  BinomialHeapNode *buildRootChain(const Entry *entries, std::size_t count,
+                                   Handle *handles);
+  static BinomialHeap buildRange(const Entry *entries, std::size_t count,
+                                 Handle *handles, InsertMode mode);
 
 public:
-  BinomialHeap();
+  explicit BinomialHeap(InsertMode mode = InsertMode::Eager);
   ~BinomialHeap();
 
   // Rule of 5/3: Prevent copying/assignment, allow moving
@@ -37,14 +84,57 @@ public:
 
   // --- Public Interface ---
   bool isEmpty() const;
-  void insert(PriorityType priority, PassengerIdType passengerId);
-  // ADD CONST HERE
-  PassengerIdType findMinPassengerId() const; // Throws if empty
-  // ADD CONST HERE
-  PriorityType findMinPriority() const; // Throws if empty
-  PassengerIdType extractMin();         // Throws if empty
-  int getSize() const;
-  void clear();
+  Handle insert(PriorityType priority, PassengerIdType passengerId);
+  // Bulk insert of {priority, id} entries in O(n). Eager mode builds the
+  // batch into binomial trees (see buildFrom) and merges them in once; lazy
+  // mode pushes degree-0 roots for the next consolidation. Handles are
+  // appended to handles_out in input order.
+  void insertBatch(
+      const std::vector<std::pair<PriorityType, PassengerIdType>> &entries,
+      std::vector<Handle> &handles_out);
+
+  // A heap holding 'entries', built in O(n) along the binary digits of n:
+  // each set bit 2^k gets the next 2^k entries as one tree of order k,
+  // linked pairwise depth-first. n - popcount(n) comparisons, no degree
+  // table, nodes allocated in tree order. Handles are appended to
+  // handles_out in input order.
+  static BinomialHeap buildFrom(const std::vector<Entry> &entries,
+                                std::vector<Handle> &handles_out,
+                                InsertMode mode = InsertMode::Eager);
+  // Same result, with the entries cut into up to 'threads' contiguous
+  // parts built on their own threads (each into its own node pool), then
+  // melded: mergeRootLists() + consolidate() per part. Parts below
+  // MIN_PARALLEL_ENTRIES are not worth a thread.
+  static BinomialHeap buildFromParallel(const std::vector<Entry> &entries,
+                                        std::vector<Handle> &handles_out,
+                                        unsigned threads,
+                                        InsertMode mode = InsertMode::Eager);
+  static const std::size_t MIN_PARALLEL_ENTRIES = 1 << 15;
+  // Union: takes over every node of 'other' with mergeRootLists() +
+  // consolidate(), O(log n) links. The node and handle slabs are adopted,
+  // not copied, so handles from 'other' stay valid and now refer to this
+  // heap. 'other' ends empty. Pending lazy roots on either side are
+  // consolidated first.
+  void meld(BinomialHeap &&other);
+  PassengerIdType findMinPassengerId() const; // O(1), throws if empty
+  PriorityType findMinPriority() const;       // O(1), throws if empty
+  PassengerIdType extractMin();               // Throws if empty
+  // Same as extractMin(), but also returns the priority: {priority, id}
+  std::pair<PriorityType, PassengerIdType> extractMinWithPriority();
+  // O(log n). Throws if newPriority is worse (larger) than the current one
+  void decreaseKey(Handle handle, PriorityType newPriority);
+  void erase(Handle handle); // O(log n), handle is invalid afterwards
+  PriorityType getPriority(Handle handle) const;
+  int getSize() const; // O(1), cached node count
+  InsertMode getInsertMode() const;
+  void setInsertMode(InsertMode mode); // Consolidates when leaving lazy mode
+  void clear();        // O(1) in the number of nodes, slabs are kept for reuse
+
+  // Non-destructive: the k best entries in priority order, {priority, id}.
+  // Walks the trees with a small frontier heap seeded from the roots, so it
+  // touches O(k log n) nodes and never copies or drains this heap.
+  std::vector<std::pair<PriorityType, PassengerIdType>>
+  topK(std::size_t k) const;
 
   std::vector<std::pair<PriorityType, PassengerIdType>>
   getWaitlistOrdered_destructive();
@@ -2,8 +2,17 @@
 
 #include "common/Types.h" // Include common type definitions
 
-// Forward declaration (optional, as it's self-referential)
-// struct BinomialHeapNode;
+struct BinomialHeapNode;
+
+// Stable handle cell for one heap entry. decreaseKey/erase move entries
+// around by swapping payloads between nodes, so callers hold on to this cell
+// (which always points at the node currently carrying their entry) rather
+// than to the node itself.
+struct BinomialHeapHandle {
+  BinomialHeapNode *node;
+
+  explicit BinomialHeapHandle(BinomialHeapNode *n) : node(n) {}
+};
 
 struct BinomialHeapNode {
   PriorityType priority;       // Priority key
@@ -12,10 +21,11 @@ struct BinomialHeapNode {
   BinomialHeapNode *parent;
   BinomialHeapNode *child;
   BinomialHeapNode *sibling;
+  BinomialHeapHandle *handle; // Back-pointer, travels with the payload
 
   BinomialHeapNode(PriorityType p, PassengerIdType data)
       : priority(p), passengerId(data), degree(0), parent(nullptr),
-        child(nullptr), sibling(nullptr) {}
+        child(nullptr), sibling(nullptr), handle(nullptr) {}
 
   // Prevent copying nodes directly - manage through heap operations
   BinomialHeapNode(const BinomialHeapNode &) = delete;
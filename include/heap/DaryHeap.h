@@ -0,0 +1,250 @@
+// include/heap/DaryHeap.h
+
+#pragma once // Header guard
+
+#include "common/PriorityKey.h" // For PriorityLess
+#include "common/Types.h"
+#include "heap/NodePool.h" // Stable handle cells
+#include <algorithm>       // For push_heap/pop_heap
+#include <cstddef>
+#include <stdexcept> // For runtime_error
+#include <utility>   // For std::pair
+#include <vector>
+
+// Stable handle cell of a DaryHeap entry: tracks where the entry currently
+// sits in the array as sifting moves it around.
+struct DaryHeapCell {
+  std::size_t position;
+
+  explicit DaryHeapCell(std::size_t pos) : position(pos) {}
+};
+
+// Implicit d-ary array heap waitlist backend, same interface as
+// BinomialHeap. All entries live in one contiguous vector; with Arity = 4
+// the keys of a node's children span one or two cache lines, and a
+// monotone insert (the common case here) never sifts at all. 'Less' orders
+// the keys (see common/PriorityKey.h) and is resolved at compile time.
+template <unsigned Arity, typename Less = PriorityLess<>> class DaryHeap {
+  static_assert(Arity >= 2, "DaryHeap needs at least two children per node");
+
+public:
+  using Handle = DaryHeapCell *;
+
+private:
+  struct Entry {
+    PriorityType priority;
+    PassengerIdType passengerId;
+    DaryHeapCell *cell;
+  };
+
+  std::vector<Entry> entries;
+  NodePool<DaryHeapCell> cellPool;
+
+  static bool before(PriorityType a, PriorityType b) { return Less()(a, b); }
+
+  void place(std::size_t pos, const Entry &entry) {
+    entries[pos] = entry;
+    entry.cell->position = pos;
+  }
+
+  void siftUp(std::size_t pos) {
+    Entry moving = entries[pos];
+    while (pos > 0) {
+      std::size_t parent = (pos - 1) / Arity;
+      // Lower priority value means higher actual priority
+      if (!before(moving.priority, entries[parent].priority))
+        break;
+      place(pos, entries[parent]);
+      pos = parent;
+    }
+    place(pos, moving);
+  }
+
+  void siftDown(std::size_t pos) {
+    const std::size_t n = entries.size();
+    Entry moving = entries[pos];
+    for (;;) {
+      std::size_t first = pos * Arity + 1;
+      if (first >= n)
+        break;
+      std::size_t last = std::min(first + Arity, n);
+      std::size_t best = first;
+      for (std::size_t c = first + 1; c < last; ++c) {
+        if (before(entries[c].priority, entries[best].priority))
+          best = c;
+      }
+      if (!before(entries[best].priority, moving.priority))
+        break;
+      place(pos, entries[best]);
+      pos = best;
+    }
+    place(pos, moving);
+  }
+
+  // Restores heap order after entries were appended from 'oldSize' on
+  void heapifyFrom(std::size_t oldSize) {
+    if (entries.size() - oldSize > oldSize) {
+      // Large batch: Floyd's bottom-up heapify of the whole array, O(n)
+      for (std::size_t pos = (entries.size() - 1) / Arity + 1; pos-- > 0;) {
+        siftDown(pos);
+      }
+    } else {
+      for (std::size_t pos = oldSize; pos < entries.size(); ++pos) {
+        siftUp(pos);
+      }
+    }
+  }
+
+  // Removes the entry at pos by moving the last entry into its place
+  void removeAt(std::size_t pos) {
+    cellPool.destroy(entries[pos].cell);
+    Entry last = entries.back();
+    entries.pop_back();
+    if (pos < entries.size()) {
+      PriorityType removed = entries[pos].priority;
+      place(pos, last);
+      if (before(last.priority, removed))
+        siftUp(pos);
+      else
+        siftDown(pos);
+    }
+  }
+
+public:
+  DaryHeap() = default;
+
+  DaryHeap(const DaryHeap &) = delete;
+  DaryHeap &operator=(const DaryHeap &) = delete;
+  DaryHeap(DaryHeap &&) noexcept = default;
+  DaryHeap &operator=(DaryHeap &&) noexcept = default;
+
+  // --- Public Interface ---
+  bool isEmpty() const { return entries.empty(); }
+
+  Handle insert(PriorityType priority, PassengerIdType passengerId) {
+    Entry entry;
+    entry.priority = priority;
+    entry.passengerId = passengerId;
+    entry.cell = cellPool.create(entries.size());
+    entries.push_back(entry);
+    siftUp(entries.size() - 1);
+    return entry.cell;
+  }
+
+  void insertBatch(
+      const std::vector<std::pair<PriorityType, PassengerIdType>> &batch,
+      std::vector<Handle> &handles_out) {
+    handles_out.reserve(handles_out.size() + batch.size());
+    const std::size_t oldSize = entries.size();
+    entries.reserve(oldSize + batch.size());
+    for (const auto &item : batch) {
+      Entry entry;
+      entry.priority = item.first;
+      entry.passengerId = item.second;
+      entry.cell = cellPool.create(entries.size());
+      entries.push_back(entry);
+      handles_out.push_back(entry.cell);
+    }
+    heapifyFrom(oldSize);
+  }
+
+  PassengerIdType findMinPassengerId() const {
+    if (entries.empty()) {
+      throw std::runtime_error("Heap is empty");
+    }
+    return entries.front().passengerId;
+  }
+
+  PriorityType findMinPriority() const {
+    if (entries.empty()) {
+      throw std::runtime_error("Heap is empty");
+    }
+    return entries.front().priority;
+  }
+
+  PassengerIdType extractMin() { return extractMinWithPriority().second; }
+
+  std::pair<PriorityType, PassengerIdType> extractMinWithPriority() {
+    if (entries.empty()) {
+      throw std::runtime_error("Cannot extract from empty heap");
+    }
+    std::pair<PriorityType, PassengerIdType> result(
+        entries.front().priority, entries.front().passengerId);
+    removeAt(0);
+    return result;
+  }
+
+  // O(log_d n). Throws if newPriority is worse (larger) than the current one
+  void decreaseKey(Handle handle, PriorityType newPriority) {
+    Entry &entry = entries[handle->position];
+    if (before(entry.priority, newPriority)) {
+      throw std::invalid_argument("decreaseKey: new priority is worse");
+    }
+    entry.priority = newPriority;
+    siftUp(handle->position);
+  }
+
+  void erase(Handle handle) { removeAt(handle->position); }
+
+  PriorityType getPriority(Handle handle) const {
+    return entries[handle->position].priority;
+  }
+
+  int getSize() const { return static_cast<int>(entries.size()); }
+
+  void clear() {
+    entries.clear();
+    cellPool.reset();
+  }
+
+  // Union: appends the entries of 'other' and re-heapifies, O(n + m) as
+  // an array heap cannot link. Cells are adopted, so handles from 'other'
+  // stay valid; 'other' ends empty.
+  void meld(DaryHeap &&other) {
+    if (this == &other || other.entries.empty()) {
+      return;
+    }
+    cellPool.adopt(std::move(other.cellPool));
+    const std::size_t oldSize = entries.size();
+    entries.reserve(oldSize + other.entries.size());
+    for (const Entry &entry : other.entries) {
+      entries.push_back(entry);
+      entry.cell->position = entries.size() - 1;
+    }
+    other.entries.clear();
+    heapifyFrom(oldSize);
+  }
+
+  // Non-destructive: the k best entries in priority order, {priority, id}.
+  // Frontier walk over array positions, O(k * d * log k).
+  std::vector<std::pair<PriorityType, PassengerIdType>>
+  topK(std::size_t k) const {
+    std::vector<std::pair<PriorityType, PassengerIdType>> result;
+    if (k > entries.size())
+      k = entries.size();
+    result.reserve(k);
+    if (k == 0)
+      return result;
+
+    auto worse = [this](std::size_t a, std::size_t b) {
+      return before(entries[b].priority, entries[a].priority);
+    };
+    std::vector<std::size_t> frontier(1, 0);
+    while (result.size() < k) {
+      std::pop_heap(frontier.begin(), frontier.end(), worse);
+      std::size_t pos = frontier.back();
+      frontier.pop_back();
+      result.emplace_back(entries[pos].priority, entries[pos].passengerId);
+      std::size_t first = pos * Arity + 1;
+      std::size_t last = std::min(first + Arity, entries.size());
+      for (std::size_t c = first; c < last; ++c) {
+        frontier.push_back(c);
+        std::push_heap(frontier.begin(), frontier.end(), worse);
+      }
+    }
+    return result;
+  }
+};
+
+// The cache-friendly variant shipped as a waitlist backend
+using QuaternaryHeap = DaryHeap<4>;
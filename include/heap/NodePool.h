@@ -0,0 +1,159 @@
+// include/heap/NodePool.h
+
+#pragma once // Header guard
+
+#include <cstddef>
+#include <iterator> // For std::make_move_iterator
+#include <memory>
+#include <new>         // For placement new
+#include <type_traits> // For aligned_storage, is_trivially_destructible
+#include <utility>     // For std::forward, std::move
+#include <vector>
+
+// Slab allocator for fixed-size heap nodes.
+// Nodes are carved out of geometrically growing slabs (MinSlab, 2*MinSlab, ...
+// up to MaxSlab nodes) so that the nodes of one heap sit close together in
+// memory and insert/extract never touch the global allocator once the pool
+// has warmed up. Freed nodes go onto an intrusive free list and are reused
+// first. Slabs are only returned to the system by release() or destruction.
+template <typename T, std::size_t MinSlab = 8, std::size_t MaxSlab = 4096>
+class NodePool {
+  static_assert(std::is_trivially_destructible<T>::value,
+                "NodePool::reset() drops nodes without running destructors");
+
+private:
+  union Slot {
+    Slot *next; // Valid while the slot is on the free list
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  struct Slab {
+    std::unique_ptr<Slot[]> slots;
+    std::size_t count;
+  };
+
+  std::vector<Slab> slabs;
+  Slot *freeList;          // Recycled slots
+  std::size_t activeSlab;  // Slab currently being bump-allocated from
+  std::size_t bumpIndex;   // Next untouched slot in slabs[activeSlab]
+  std::size_t liveCount;   // Nodes currently handed out
+
+  Slot *nextFreshSlot() {
+    while (activeSlab < slabs.size() &&
+           bumpIndex == slabs[activeSlab].count) {
+      activeSlab++; // Current slab used up, move to the next retained one
+      bumpIndex = 0;
+    }
+    if (activeSlab == slabs.size()) {
+      std::size_t count = slabs.empty() ? MinSlab : slabs.back().count * 2;
+      if (count > MaxSlab)
+        count = MaxSlab;
+      Slab slab;
+      slab.slots.reset(new Slot[count]);
+      slab.count = count;
+      slabs.push_back(std::move(slab));
+      bumpIndex = 0;
+    }
+    return &slabs[activeSlab].slots[bumpIndex++];
+  }
+
+public:
+  NodePool() : freeList(nullptr), activeSlab(0), bumpIndex(0), liveCount(0) {}
+
+  // Slabs are owned through unique_ptr, so moving the pool keeps every node
+  // address stable. Copying makes no sense for a pool.
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+  NodePool(NodePool &&other) noexcept
+      : slabs(std::move(other.slabs)), freeList(other.freeList),
+        activeSlab(other.activeSlab), bumpIndex(other.bumpIndex),
+        liveCount(other.liveCount) {
+    other.slabs.clear();
+    other.freeList = nullptr;
+    other.activeSlab = other.bumpIndex = other.liveCount = 0;
+  }
+  NodePool &operator=(NodePool &&other) noexcept {
+    if (this != &other) {
+      slabs = std::move(other.slabs);
+      freeList = other.freeList;
+      activeSlab = other.activeSlab;
+      bumpIndex = other.bumpIndex;
+      liveCount = other.liveCount;
+      other.slabs.clear();
+      other.freeList = nullptr;
+      other.activeSlab = other.bumpIndex = other.liveCount = 0;
+    }
+    return *this;
+  }
+
+  template <typename... Args> T *create(Args &&...args) {
+    Slot *slot = freeList;
+    if (slot != nullptr) {
+      freeList = slot->next;
+    } else {
+      slot = nextFreshSlot();
+    }
+    liveCount++;
+    return new (&slot->storage) T(std::forward<Args>(args)...);
+  }
+
+  void destroy(T *node) {
+    // T is trivially destructible, the slot can simply be recycled
+    Slot *slot = reinterpret_cast<Slot *>(node);
+    slot->next = freeList;
+    freeList = slot;
+    liveCount--;
+  }
+
+  // Takes over every slab of 'other' together with the nodes in it, which
+  // keep their addresses; 'other' is left empty. Slots it never handed out
+  // join the free list, so the adopted slabs sit before the active one and
+  // are never bump-allocated over. O(free slots of 'other').
+  void adopt(NodePool &&other) {
+    if (this == &other) {
+      return;
+    }
+    for (std::size_t s = other.activeSlab; s < other.slabs.size(); ++s) {
+      Slab &slab = other.slabs[s];
+      for (std::size_t i = s == other.activeSlab ? other.bumpIndex : 0;
+           i < slab.count; ++i) {
+        slab.slots[i].next = other.freeList;
+        other.freeList = &slab.slots[i];
+      }
+    }
+    if (other.freeList != nullptr) {
+      Slot *tail = other.freeList;
+      while (tail->next != nullptr) {
+        tail = tail->next;
+      }
+      tail->next = freeList;
+      freeList = other.freeList;
+    }
+    slabs.insert(slabs.begin() + static_cast<std::ptrdiff_t>(activeSlab),
+                 std::make_move_iterator(other.slabs.begin()),
+                 std::make_move_iterator(other.slabs.end()));
+    activeSlab += other.slabs.size();
+    liveCount += other.liveCount;
+    other.slabs.clear();
+    other.freeList = nullptr;
+    other.activeSlab = other.bumpIndex = other.liveCount = 0;
+  }
+
+  // Forget every node at once but keep the slabs for reuse. O(1) in the
+  // number of nodes, which is what lets BinomialHeap::clear() skip the walk.
+  void reset() {
+    freeList = nullptr;
+    activeSlab = 0;
+    bumpIndex = 0;
+    liveCount = 0;
+  }
+
+  // Forget every node and give the slabs back to the system.
+  void release() {
+    reset();
+    slabs.clear();
+    slabs.shrink_to_fit();
+  }
+
+  std::size_t size() const { return liveCount; }
+};
@@ -0,0 +1,85 @@
+// include/heap/PairingHeap.h
+
+#pragma once // Header guard
+
+#include "common/PriorityKey.h" // For PriorityLess
+#include "common/Types.h"
+#include "heap/NodePool.h" // Slab allocator for nodes
+#include <stdexcept>       // For runtime_error
+#include <utility>         // For std::pair
+#include <vector>
+
+struct PairingHeapNode {
+  PriorityType priority;       // Priority key
+  PassengerIdType passengerId; // Data (Passenger ID)
+  PairingHeapNode *child;      // Leftmost child
+  PairingHeapNode *sibling;    // Next sibling to the right
+  PairingHeapNode *prev;       // Left sibling, or parent for a leftmost child
+
+  PairingHeapNode(PriorityType p, PassengerIdType data)
+      : priority(p), passengerId(data), child(nullptr), sibling(nullptr),
+        prev(nullptr) {}
+
+  PairingHeapNode(const PairingHeapNode &) = delete;
+  PairingHeapNode &operator=(const PairingHeapNode &) = delete;
+};
+
+// Pairing heap waitlist backend, same interface as BinomialHeap.
+// Insert and decreaseKey are O(1) (a single link against the root), which
+// suits waitlists where nearly every insert carries the worst key. Entries
+// never move between nodes, so a handle is simply the node.
+class PairingHeap {
+public:
+  using Handle = PairingHeapNode *;
+
+private:
+  PairingHeapNode *root;
+  int size;
+  NodePool<PairingHeapNode> pool;
+  std::vector<PairingHeapNode *> pairScratch; // Reused by extractMin()
+
+  // Every key comparison goes through the packed-key order
+  using KeyLess = PriorityLess<PriorityOrder::Tiered>;
+  static bool before(PriorityType a, PriorityType b) { return KeyLess()(a, b); }
+
+  // Links two heap-ordered trees, returns the new root
+  static PairingHeapNode *meld(PairingHeapNode *a, PairingHeapNode *b);
+  // Two-pass pairing of a sibling list, returns the resulting root
+  PairingHeapNode *mergePairs(PairingHeapNode *first);
+  // Detaches a non-root subtree from its parent/siblings
+  static void cut(PairingHeapNode *node);
+
+public:
+  PairingHeap();
+
+  PairingHeap(const PairingHeap &) = delete;
+  PairingHeap &operator=(const PairingHeap &) = delete;
+  PairingHeap(PairingHeap &&other) noexcept;
+  PairingHeap &operator=(PairingHeap &&other) noexcept;
+
+  // --- Public Interface ---
+  bool isEmpty() const;
+  Handle insert(PriorityType priority, PassengerIdType passengerId);
+  void insertBatch(
+      const std::vector<std::pair<PriorityType, PassengerIdType>> &entries,
+      std::vector<Handle> &handles_out);
+  PassengerIdType findMinPassengerId() const; // O(1), throws if empty
+  PriorityType findMinPriority() const;       // O(1), throws if empty
+  PassengerIdType extractMin();               // Throws if empty
+  std::pair<PriorityType, PassengerIdType> extractMinWithPriority();
+  // O(1). Throws if newPriority is worse (larger) than the current one
+  void decreaseKey(Handle handle, PriorityType newPriority);
+  void erase(Handle handle); // Handle is invalid afterwards
+  PriorityType getPriority(Handle handle) const;
+  int getSize() const;
+  void clear();
+  // Union in O(1): one link of the two roots. Nodes (the handles) are
+  // adopted with their slabs and stay valid; 'other' ends empty.
+  void meld(PairingHeap &&other);
+
+  // Non-destructive: the k best entries in priority order, {priority, id}.
+  // Visits every child of each emitted node; right after a burst of inserts
+  // the root can have O(n) children, so this is slower than in BinomialHeap.
+  std::vector<std::pair<PriorityType, PassengerIdType>>
+  topK(std::size_t k) const;
+};
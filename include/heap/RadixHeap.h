@@ -0,0 +1,91 @@
+// include/heap/RadixHeap.h
+
+#pragma once // Header guard
+
+#include "common/Types.h"
+#include "heap/NodePool.h" // Stable handle cells
+#include <cstdint>
+#include <stdexcept> // For runtime_error
+#include <utility>   // For std::pair
+#include <vector>
+
+// Stable handle cell of a RadixHeap entry: which bucket, and where in it
+struct RadixHeapCell {
+  std::uint32_t bucket;
+  std::uint32_t index;
+
+  RadixHeapCell(std::uint32_t b, std::uint32_t i) : bucket(b), index(i) {}
+};
+
+// Monotone radix (bucket) queue waitlist backend for integer priorities,
+// same interface as BinomialHeap.
+// Bucket 0 holds entries equal to the current minimum 'last'; bucket i > 0
+// holds entries whose highest bit differing from 'last' is bit i-1. Inserts
+// append to a bucket in O(1) and every entry moves to a strictly lower
+// bucket at most 64 times over its lifetime, so extraction is amortized
+// O(log C) with no pointer chasing. Designed for keys that mostly grow, as
+// handed out by the booking counter. Inserting or decreasing a key below the
+// current minimum is allowed but rebuckets every entry (O(n)); a waitlist
+// that keeps receiving higher-tier keys is better served by another backend.
+class RadixHeap {
+public:
+  using Handle = RadixHeapCell *;
+
+private:
+  static const std::uint32_t BUCKET_COUNT = 65;
+
+  struct Entry {
+    std::uint64_t key; // Order-preserving unsigned image of the priority
+    PassengerIdType passengerId;
+    RadixHeapCell *cell;
+  };
+
+  std::vector<Entry> buckets[BUCKET_COUNT];
+  std::uint64_t last; // Current minimum key (valid while not empty)
+  int size;
+  NodePool<RadixHeapCell> cellPool;
+
+  static std::uint64_t toKey(PriorityType priority);
+  static PriorityType toPriority(std::uint64_t key);
+  std::uint32_t bucketFor(std::uint64_t key) const;
+  void push(const Entry &entry);  // Into the bucket matching its key
+  void unlink(RadixHeapCell *cell); // Swap-and-pop out of its bucket
+  // Moves the smallest keys into bucket 0 once it has run empty
+  void refill();
+  // Makes 'newLast' (below every key) the new minimum and rebuckets all
+  void rebase(std::uint64_t newLast);
+
+public:
+  RadixHeap();
+
+  RadixHeap(const RadixHeap &) = delete;
+  RadixHeap &operator=(const RadixHeap &) = delete;
+  RadixHeap(RadixHeap &&other) noexcept;
+  RadixHeap &operator=(RadixHeap &&other) noexcept;
+
+  // --- Public Interface ---
+  bool isEmpty() const;
+  Handle insert(PriorityType priority, PassengerIdType passengerId);
+  void insertBatch(
+      const std::vector<std::pair<PriorityType, PassengerIdType>> &entries,
+      std::vector<Handle> &handles_out);
+  PassengerIdType findMinPassengerId() const; // O(1), throws if empty
+  PriorityType findMinPriority() const;       // O(1), throws if empty
+  PassengerIdType extractMin();               // Throws if empty
+  std::pair<PriorityType, PassengerIdType> extractMinWithPriority();
+  // Throws if newPriority is worse (larger) than the current one
+  void decreaseKey(Handle handle, PriorityType newPriority);
+  void erase(Handle handle); // Handle is invalid afterwards
+  PriorityType getPriority(Handle handle) const;
+  int getSize() const;
+  void clear();
+  // Union: rebuckets the entries of 'other' against this heap's minimum,
+  // O(m). Cells are adopted, so handles from 'other' stay valid; 'other'
+  // ends empty.
+  void meld(RadixHeap &&other);
+
+  // Non-destructive: the k best entries in priority order, {priority, id}.
+  // Buckets cover increasing key ranges, so only the first few are sorted.
+  std::vector<std::pair<PriorityType, PassengerIdType>>
+  topK(std::size_t k) const;
+};
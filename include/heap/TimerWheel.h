@@ -0,0 +1,108 @@
+// include/heap/TimerWheel.h
+
+#pragma once // Header guard
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical timer wheel over integer ticks (the caller picks the unit;
+// seat holds use milliseconds). LEVELS wheels of SLOTS slots each: level L
+// holds the timers whose deadline first differs from the current tick in
+// bits [8L, 8L + 8), filed by those bits, so a level-0 slot holds exactly
+// one deadline. Deadlines more than 2^32 ticks out wait in an overflow
+// list. When the clock enters the range of a higher slot, that slot is
+// cascaded: its timers are refiled one level down or more.
+//
+// arm() and cancel() are O(1): timers are intrusive doubly-linked list
+// nodes in a pool, addressed by TimerId. advance() costs O(timers fired)
+// plus O(1) per cascaded timer (each cascades at most LEVELS times) and
+// jumps straight to the next non-empty slot through per-level occupancy
+// bitmaps, so idle stretches cost nothing.
+class TimerWheel {
+public:
+  using Tick = std::uint64_t;
+  // Pool index + 1 in the low half, the slot's generation in the high half,
+  // so a stale ID never cancels a later timer in the same slot
+  using TimerId = std::uint64_t;
+  static const TimerId INVALID_TIMER = 0;
+
+  static const int LEVEL_BITS = 8;
+  static const std::size_t SLOTS = std::size_t(1) << LEVEL_BITS;
+  static const int LEVELS = 4;
+
+private:
+  static const std::uint32_t NIL = 0xFFFFFFFFu;
+  static const std::uint32_t FREE = 0xFFFFFFFFu; // Timer::list when unused
+  static const std::size_t LIST_COUNT = LEVELS * SLOTS + 1; // + overflow
+  static const std::size_t WORDS = SLOTS / 64;
+
+  struct Timer {
+    Tick deadline;
+    std::uint32_t payload;
+    std::uint32_t generation;
+    std::uint32_t list; // Index into 'heads', or FREE
+    std::uint32_t prev, next; // Pool indexes; 'next' links the free list
+  };
+
+  std::vector<Timer> timers;
+  std::uint32_t freeHead;
+  std::uint32_t heads[LIST_COUNT];
+  std::uint64_t occupied[LEVELS][WORDS]; // Non-empty slots per level
+  Tick now;
+  std::size_t armed;
+
+  std::uint32_t listFor(Tick deadline) const;
+  void link(std::uint32_t index, std::uint32_t list);
+  void unlink(std::uint32_t index);
+  void release(std::uint32_t index);
+  // Earliest tick at which a slot must be cascaded or fired
+  Tick nextEvent() const;
+  void cascade(std::uint32_t list); // Refiles every timer of 'list'
+  // Unlinks and frees the first timer of slot 'list'; NIL if it is empty
+  std::uint32_t popFired(std::uint32_t list, std::uint32_t &payload);
+  // Moves the clock to 'tick' (no later than nextEvent()) and cascades
+  // whatever the move brought into range
+  void moveTo(Tick tick);
+
+public:
+  explicit TimerWheel(Tick start = 0);
+
+  TimerWheel(const TimerWheel &) = delete;
+  TimerWheel &operator=(const TimerWheel &) = delete;
+
+  // Fires at the first advance() that reaches 'deadline'; a deadline not
+  // after the current tick means the next tick
+  TimerId arm(Tick deadline, std::uint32_t payload);
+  // False if the timer already fired or was cancelled
+  bool cancel(TimerId id);
+
+  // Moves the clock forward to 'tick' and calls fn(payload) for every
+  // timer due by then, in deadline order. fn may arm and cancel timers;
+  // new ones come due at later ticks.
+  template <typename Fn> std::size_t advance(Tick tick, Fn fn) {
+    std::size_t fired = 0;
+    while (now < tick) {
+      if (armed == 0) {
+        now = tick;
+        break;
+      }
+      const Tick next = nextEvent();
+      if (next > tick) {
+        moveTo(tick); // Nothing due; only cascades what comes in range
+        break;
+      }
+      moveTo(next);
+      const std::uint32_t slot = static_cast<std::uint32_t>(now % SLOTS);
+      std::uint32_t payload = 0;
+      while (popFired(slot, payload) != NIL) {
+        ++fired;
+        fn(payload);
+      }
+    }
+    return fired;
+  }
+
+  Tick getNow() const;
+  std::size_t size() const; // Armed timers
+};
@@ -0,0 +1,94 @@
+// include/heap/Waitlist.h
+
+#pragma once // Header guard
+
+#include "common/Types.h"
+#include "heap/BinomialHeap.h"
+#include "heap/DaryHeap.h"
+#include "heap/PairingHeap.h"
+#include "heap/RadixHeap.h"
+#include <utility> // For std::pair
+#include <vector>
+
+// Priority queue implementations a waitlist can be backed by. Every backend
+// class provides the same interface (the one Waitlist forwards below):
+//   Handle insert(priority, id);  insertBatch(entries, handles_out);
+//   findMinPassengerId(), findMinPriority(), extractMin(),
+//   extractMinWithPriority(), decreaseKey(handle, p), erase(handle),
+//   getPriority(handle), isEmpty(), getSize(), clear(), topK(k) const,
+//   meld(other&&).
+// Handles stay valid until their entry is extracted or erased, also across
+// a meld into another heap; lower priority values are served first.
+enum class WaitlistBackend {
+  Binomial,   // BinomialHeap, supports lazy insert mode
+  Pairing,    // PairingHeap, O(1) insert and decreaseKey
+  Quaternary, // DaryHeap<4>, contiguous array
+  Radix       // RadixHeap, monotone integer bucket queue
+};
+
+const char *toString(WaitlistBackend backend);
+
+// A waitlist whose backend is picked at runtime (per route), so Flight and
+// BookingSystem stay non-template. Forwards to the backend with a switch,
+// no virtual calls. Most flights never overflow, so the backend is only
+// allocated by the first insert: until then a waitlist is two enums and a
+// null pointer and costs no heap memory. clear() returns it to that state.
+// Moves just hand the backend over.
+class Waitlist {
+public:
+  // Opaque handle, one of the backend handle types behind a void pointer
+  using Handle = void *;
+
+private:
+  WaitlistBackend backend;
+  BinomialHeap::InsertMode insertMode; // Applied when materialized
+  union Storage {
+    void *any; // nullptr until the first insert
+    BinomialHeap *binomial;
+    PairingHeap *pairing;
+    QuaternaryHeap *quaternary;
+    RadixHeap *radix;
+  } storage;
+
+  void materialize(); // Allocates the backend; caller checks it is missing
+  void destroy();     // Frees the backend, if any
+
+public:
+  explicit Waitlist(
+      WaitlistBackend kind = WaitlistBackend::Binomial,
+      BinomialHeap::InsertMode mode = BinomialHeap::InsertMode::Eager);
+  ~Waitlist();
+
+  Waitlist(const Waitlist &) = delete;
+  Waitlist &operator=(const Waitlist &) = delete;
+  Waitlist(Waitlist &&other) noexcept;
+  Waitlist &operator=(Waitlist &&other) noexcept;
+
+  WaitlistBackend getBackend() const;
+  bool isMaterialized() const; // False while no backend is allocated
+
+  // --- Public Interface (see the backend contract above) ---
+  bool isEmpty() const;
+  Handle insert(PriorityType priority, PassengerIdType passengerId);
+  void insertBatch(
+      const std::vector<std::pair<PriorityType, PassengerIdType>> &entries,
+      std::vector<Handle> &handles_out);
+  PassengerIdType findMinPassengerId() const;
+  PriorityType findMinPriority() const;
+  PassengerIdType extractMin();
+  std::pair<PriorityType, PassengerIdType> extractMinWithPriority();
+  void decreaseKey(Handle handle, PriorityType newPriority);
+  void erase(Handle handle);
+  PriorityType getPriority(Handle handle) const;
+  int getSize() const;
+  void clear(); // Also frees the backend
+  std::vector<std::pair<PriorityType, PassengerIdType>>
+  topK(std::size_t k) const;
+  // Moves every entry of 'other' into this waitlist with the backend's
+  // union; handles from 'other' then refer to this waitlist. False (and
+  // nothing moved) if the backends differ.
+  bool meld(Waitlist &&other);
+
+  // Only meaningful for the binomial backend, ignored by the others
+  void setInsertMode(BinomialHeap::InsertMode mode);
+};
@@ -0,0 +1,78 @@
+// include/metrics/LogHistogram.h
+#pragma once // Header guard
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// HDR-style log-linear histogram of non-negative integers (latencies in
+// timer ticks, or plain counts). Values below 2 * SUB_BUCKETS get a bucket
+// each; above that every power of two is split into SUB_BUCKETS equal
+// buckets, so any recorded value is known to within 1 / SUB_BUCKETS (about
+// 3%) at a fixed 8 KB. Values from MAX_VALUE up land in the last bucket.
+//
+// One thread records, any thread may read: counters are relaxed atomics
+// updated with a plain load and store (no locked instruction), and a
+// reader sees each counter either before or after an update.
+class LogHistogram {
+public:
+  static const int SUB_BITS = 5;
+  static const std::size_t SUB_BUCKETS = std::size_t(1) << SUB_BITS;
+  static const int MAX_MAGNITUDE = 36; // 2^36 ticks: about 20 s at 3.5 GHz
+  static const std::uint64_t MAX_VALUE = std::uint64_t(1) << MAX_MAGNITUDE;
+  static const std::size_t BUCKET_COUNT =
+      (MAX_MAGNITUDE - SUB_BITS + 1) * SUB_BUCKETS;
+
+  static std::size_t bucketIndex(std::uint64_t value) {
+    if (value >= MAX_VALUE) {
+      value = MAX_VALUE - 1;
+    }
+    if (value < 2 * SUB_BUCKETS) {
+      return static_cast<std::size_t>(value);
+    }
+    const int shift = 63 - __builtin_clzll(value) - SUB_BITS;
+    return static_cast<std::size_t>(shift) * SUB_BUCKETS +
+           static_cast<std::size_t>(value >> shift);
+  }
+  static std::uint64_t bucketUpperBound(std::size_t index); // Inclusive
+
+private:
+  std::atomic<std::uint64_t> counts[BUCKET_COUNT];
+  std::atomic<std::uint64_t> sum; // Unclamped
+
+  static void increment(std::atomic<std::uint64_t> &counter,
+                        std::uint64_t by) {
+    counter.store(counter.load(std::memory_order_relaxed) + by,
+                  std::memory_order_relaxed);
+  }
+
+public:
+  LogHistogram();
+
+  LogHistogram(const LogHistogram &) = delete;
+  LogHistogram &operator=(const LogHistogram &) = delete;
+
+  // Only the owning thread may record
+  void record(std::uint64_t value) {
+    increment(counts[bucketIndex(value)], 1);
+    increment(sum, value);
+  }
+
+  std::uint64_t getBucket(std::size_t index) const;
+  std::uint64_t getSum() const;
+};
+
+// Plain sum of several LogHistograms (e.g. one per thread), for reporting
+struct HistogramTotals {
+  std::vector<std::uint64_t> counts; // BUCKET_COUNT entries
+  std::uint64_t count;
+  std::uint64_t sum;
+
+  HistogramTotals();
+  void add(const LogHistogram &histogram);
+  // Smallest bucket bound with at least q * count values at or below it
+  std::uint64_t valueAtQuantile(double q) const;
+  // Number of values at or below 'limit', counted by whole buckets
+  std::uint64_t countAtOrBelow(std::uint64_t limit) const;
+};
@@ -0,0 +1,125 @@
+// include/metrics/Metrics.h
+#pragma once // Header guard
+
+#include "metrics/LogHistogram.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // For __rdtsc
+#endif
+
+// Hot-path instrumentation. Built with -DBOOKING_METRICS (make METRICS=1)
+// the METRIC_* macros below time operations with the TSC and record into
+// per-thread LogHistograms; without it they expand to nothing, so the
+// default build carries no code, data or branches for them.
+// writePrometheus() reports the totals in the Prometheus text format.
+
+// Timed operations; the label of each is in Metrics.cpp
+enum class LatencyMetric {
+  FlightBook,           // Flight::book, behind addPassenger
+  FlightCancel,         // Flight::cancel without a waitlist promotion
+  FlightCancelPromoted, // Flight::cancel that promoted a waitlisted passenger
+  FlightLookup,         // BookingSystem::resolveFlight
+  HeapInsert,           // BinomialHeap::insert
+  HeapExtractMin,       // BinomialHeap::extractMinWithPriority
+  HeapConsolidate,      // BinomialHeap::consolidate (sorted root chain)
+  HeapConsolidateLazy,  // BinomialHeap::consolidatePendingRoots
+  Count
+};
+
+// Recorded distributions of plain values
+enum class ValueMetric {
+  HeapRootListLength, // Roots when a consolidation starts
+  Count
+};
+
+enum class CounterMetric {
+  HeapDegreeTableResizes, // consolidatePendingRoots() grew its table
+  Count
+};
+
+// One thread's metrics. Blocks are owned by the registry in Metrics.cpp;
+// a thread takes a free one on first use and hands it back when it exits,
+// so its counts are kept and a later thread carries on in the same block.
+struct MetricsBlock {
+  LogHistogram latency[static_cast<std::size_t>(LatencyMetric::Count)];
+  LogHistogram values[static_cast<std::size_t>(ValueMetric::Count)];
+  std::atomic<std::uint64_t> counters[static_cast<std::size_t>(
+      CounterMetric::Count)];
+  std::atomic<bool> inUse;
+
+  MetricsBlock();
+};
+
+// The calling thread's block (acquired on first use)
+MetricsBlock &localMetrics();
+
+// Timer ticks: the TSC on x86 (constant rate on every CPU this targets),
+// steady_clock nanoseconds elsewhere. Converted to seconds only on export.
+inline std::uint64_t readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+// Ticks per second, calibrated against steady_clock since startup
+double ticksPerSecond();
+
+inline void recordLatency(LatencyMetric metric, std::uint64_t ticks) {
+  localMetrics().latency[static_cast<std::size_t>(metric)].record(ticks);
+}
+inline void recordValue(ValueMetric metric, std::uint64_t value) {
+  localMetrics().values[static_cast<std::size_t>(metric)].record(value);
+}
+inline void incrementCounter(CounterMetric metric) {
+  std::atomic<std::uint64_t> &counter =
+      localMetrics().counters[static_cast<std::size_t>(metric)];
+  counter.store(counter.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+}
+
+// Records the ticks from construction to destruction. The metric may be
+// changed before the scope ends, once the outcome is known.
+class ScopedLatencyTimer {
+private:
+  LatencyMetric metric;
+  std::uint64_t start;
+
+public:
+  explicit ScopedLatencyTimer(LatencyMetric m)
+      : metric(m), start(readTicks()) {}
+  ~ScopedLatencyTimer() { recordLatency(metric, readTicks() - start); }
+
+  ScopedLatencyTimer(const ScopedLatencyTimer &) = delete;
+  ScopedLatencyTimer &operator=(const ScopedLatencyTimer &) = delete;
+
+  void setMetric(LatencyMetric m) { metric = m; }
+};
+
+#ifdef BOOKING_METRICS
+#define METRIC_TIMER(name, metric) ScopedLatencyTimer name(metric)
+#define METRIC_TIMER_SET(name, metric) (name).setMetric(metric)
+#define METRIC_RECORD(metric, value) recordValue(metric, value)
+#define METRIC_INCREMENT(metric) incrementCounter(metric)
+#else
+// Arguments are not evaluated
+#define METRIC_TIMER(name, metric) ((void)0)
+#define METRIC_TIMER_SET(name, metric) ((void)0)
+#define METRIC_RECORD(metric, value) ((void)0)
+#define METRIC_INCREMENT(metric) ((void)0)
+#endif
+
+// True if this build records metrics (-DBOOKING_METRICS)
+bool metricsEnabled();
+
+// Text exposition format 0.0.4 of every metric, summed over all threads:
+// latency histograms in seconds with an 'op' label, their HDR quantiles
+// as a gauge, the value histograms and the counters. A build without
+// metrics writes only booking_metrics_enabled 0.
+void writePrometheus(std::ostream &out);
@@ -0,0 +1,116 @@
+// include/server/BookingService.h
+#pragma once // Header guard
+
+#include "booking/BookingRequest.h"
+#include "booking/FlightStatus.h"
+#include "common/Types.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+class BookingSystem;
+class ShardedBookingEngine;
+
+// The booking operations the request server needs, so one front end can
+// drive either core. Batches carry every book or cancel request of one
+// event loop round.
+class BookingService {
+public:
+  virtual ~BookingService() {}
+
+  // Whether several server threads may call in at the same time
+  virtual bool isThreadSafe() const = 0;
+
+  // 'results' gets one entry per request, in input order
+  virtual void bookBatch(const std::vector<BookingRequest> &requests,
+                         std::vector<BookingResult> &results) = 0;
+  virtual void cancelBatch(const std::vector<BookingRequest> &requests,
+                           std::vector<BookingResult> &results) = 0;
+  // All-or-nothing multi-leg booking; 'flightIds' is not empty and lists
+  // each flight once
+  virtual ItineraryResult
+  bookItinerary(PassengerIdType passengerId,
+                const std::vector<std::string> &flightIds) = 0;
+  // Seat holds: Held / Confirmed / HoldReleased, or why not
+  virtual BookingResult holdSeat(PassengerIdType passengerId,
+                                 const std::string &flightId,
+                                 std::chrono::milliseconds duration) = 0;
+  virtual BookingResult confirmHold(PassengerIdType passengerId,
+                                    const std::string &flightId) = 0;
+  virtual BookingResult releaseHold(PassengerIdType passengerId,
+                                    const std::string &flightId) = 0;
+  // Releases the holds that are due; called at the start of every round
+  // and at least every RequestServer::HOLD_EXPIRY_INTERVAL_MS
+  virtual void expireHolds() = 0;
+  virtual bool queryFlight(const std::string &flightId,
+                           FlightStatus &status) = 0;
+  virtual PassengerIdType addPassenger(const std::string &name) = 0;
+  virtual bool addFlight(const std::string &flightId,
+                         const std::string &origin,
+                         const std::string &destination, int capacity) = 0;
+  // Called after each round of requests, before its responses are sent:
+  // whatever was answered must be durable by the time the client reads it
+  virtual void commit() {}
+};
+
+// Single-threaded, persistent when the system has a data directory. One
+// journal sync per round covers every booking in it.
+class BookingSystemService : public BookingService {
+private:
+  BookingSystem &system;
+
+public:
+  explicit BookingSystemService(BookingSystem &bookingSystem);
+
+  bool isThreadSafe() const override;
+  void bookBatch(const std::vector<BookingRequest> &requests,
+                 std::vector<BookingResult> &results) override;
+  void cancelBatch(const std::vector<BookingRequest> &requests,
+                   std::vector<BookingResult> &results) override;
+  ItineraryResult
+  bookItinerary(PassengerIdType passengerId,
+                const std::vector<std::string> &flightIds) override;
+  BookingResult holdSeat(PassengerIdType passengerId,
+                         const std::string &flightId,
+                         std::chrono::milliseconds duration) override;
+  BookingResult confirmHold(PassengerIdType passengerId,
+                            const std::string &flightId) override;
+  BookingResult releaseHold(PassengerIdType passengerId,
+                            const std::string &flightId) override;
+  void expireHolds() override;
+  bool queryFlight(const std::string &flightId, FlightStatus &status) override;
+  PassengerIdType addPassenger(const std::string &name) override;
+  bool addFlight(const std::string &flightId, const std::string &origin,
+                 const std::string &destination, int capacity) override;
+  void commit() override;
+};
+
+// In memory and thread-safe: every server thread books concurrently
+class ShardedEngineService : public BookingService {
+private:
+  ShardedBookingEngine &engine;
+
+public:
+  explicit ShardedEngineService(ShardedBookingEngine &bookingEngine);
+
+  bool isThreadSafe() const override;
+  void bookBatch(const std::vector<BookingRequest> &requests,
+                 std::vector<BookingResult> &results) override;
+  void cancelBatch(const std::vector<BookingRequest> &requests,
+                   std::vector<BookingResult> &results) override;
+  ItineraryResult
+  bookItinerary(PassengerIdType passengerId,
+                const std::vector<std::string> &flightIds) override;
+  BookingResult holdSeat(PassengerIdType passengerId,
+                         const std::string &flightId,
+                         std::chrono::milliseconds duration) override;
+  BookingResult confirmHold(PassengerIdType passengerId,
+                            const std::string &flightId) override;
+  BookingResult releaseHold(PassengerIdType passengerId,
+                            const std::string &flightId) override;
+  void expireHolds() override;
+  bool queryFlight(const std::string &flightId, FlightStatus &status) override;
+  PassengerIdType addPassenger(const std::string &name) override;
+  bool addFlight(const std::string &flightId, const std::string &origin,
+                 const std::string &destination, int capacity) override;
+};
@@ -0,0 +1,88 @@
+// include/server/RequestServer.h
+#pragma once // Header guard
+
+#include "server/BookingService.h"
+#include <string>
+
+// Headless front end: a line protocol over TCP and/or a Unix domain socket,
+// served by epoll event loops (Linux). One request per line, one response
+// line per request (metrics excepted), in request order; clients may
+// pipeline freely.
+//   book <passenger-id> <flight-id>    -> result, e.g. "confirmed"
+//   cancel <passenger-id> <flight-id>  -> result, e.g. "cancelled"
+//   itinerary <passenger-id> <flight-id>...  -> "confirmed" once every leg
+//                          has a seat, else nothing is booked and the reply
+//                          names the first failing leg, e.g. "sold_out LH716";
+//                          a flight listed twice is "error bad_arguments"
+//   hold <passenger-id> <flight-id> <seconds>  -> "held", or e.g. "sold_out";
+//                          the seat is the passenger's until confirmed,
+//                          released, or the seconds (1 day at most) are up
+//   confirm <passenger-id> <flight-id>  -> "confirmed" or "not_held"
+//   release <passenger-id> <flight-id>  -> "hold_released" or "not_held"
+//   query <flight-id>   -> "flight <id> <origin> <destination> <capacity>
+//                           <booked> <waitlisted> <held>" or "unknown_flight"
+//   passenger <name>    -> "passenger <id>" (the name is the rest of the line)
+//   flight <id> <origin> <destination> <capacity>  -> "ok" or "exists"
+//   ping                -> "pong"
+//   metrics             -> Prometheus text exposition (metrics/Metrics.h),
+//                          several lines ending with "# EOF"
+// A malformed request gets "error <reason>". A line longer than
+// MAX_LINE_BYTES gets "error line_too_long" and the connection is closed.
+//
+// Each loop round reads what every ready connection has sent, then runs
+// the requests in arrival order, handing each run of consecutive book (or
+// cancel) requests to the service as one batch. The service commits once
+// per round, and only then is each connection's output written, in one
+// send. Under load this turns many small requests into a few large
+// batches and one journal sync. Due holds are released at the start of
+// every round; an idle loop wakes up every HOLD_EXPIRY_INTERVAL_MS for it.
+struct ServerOptions {
+  std::string host; // TCP listen address (numeric)
+  int port;         // TCP port, 0 picks a free one, -1 disables TCP
+  std::string unixPath; // Unix socket path, empty disables it
+  unsigned threads;     // Event loops; more than 1 needs a thread-safe service
+
+  ServerOptions() : host("127.0.0.1"), port(-1), threads(1) {}
+};
+
+class RequestServer {
+private:
+  struct Connection;
+  class EventLoop;
+
+  BookingService &service;
+  ServerOptions options;
+  int tcpListener;  // -1 if disabled
+  int unixListener; // -1 if disabled
+  int wakeFd;       // eventfd signalled by stop()
+  int boundPort;
+
+  void listenTcp();
+  void listenUnix();
+  void closeSockets();
+
+public:
+  static const std::size_t MAX_LINE_BYTES = 4096;
+  static const std::size_t READ_BUDGET_BYTES = 64 << 10; // Per round
+  // Reading from a connection pauses while this much output is unsent
+  static const std::size_t MAX_PENDING_OUTPUT = 1 << 20;
+  static const int HOLD_EXPIRY_INTERVAL_MS = 100;
+  static const int MAX_HOLD_SECONDS = 24 * 60 * 60;
+
+  // Binds and listens on the configured sockets. Throws
+  // std::invalid_argument for a bad configuration and std::runtime_error
+  // if a socket cannot be set up.
+  RequestServer(BookingService &bookingService, const ServerOptions &opts);
+  ~RequestServer();
+
+  RequestServer(const RequestServer &) = delete;
+  RequestServer &operator=(const RequestServer &) = delete;
+
+  // Serves until stop(); the calling thread runs one of the event loops.
+  // Open connections are closed on return.
+  void run();
+  // Makes run() return. Async-signal-safe, callable from any thread.
+  void stop();
+
+  int getPort() const; // Bound TCP port (useful with port 0), or -1
+};
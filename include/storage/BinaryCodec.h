@@ -0,0 +1,97 @@
+// include/storage/BinaryCodec.h
+#pragma once // Header guard
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Fixed-width little-endian encoding shared by the WAL and snapshot files.
+// Strings are a u32 length followed by the raw bytes.
+
+// CRC-32 (IEEE, as in zlib). Pass the previous result as 'crc' to checksum
+// data that arrives in pieces.
+std::uint32_t crc32(const void *data, std::size_t length,
+                    std::uint32_t crc = 0);
+
+// Appends encoded values to a caller-owned buffer
+class ByteWriter {
+private:
+  std::string &out;
+
+public:
+  explicit ByteWriter(std::string &buffer) : out(buffer) {}
+
+  void u8(std::uint8_t value) { out.push_back(static_cast<char>(value)); }
+  void u32(std::uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) {
+      bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    out.append(bytes, 4);
+  }
+  void u64(std::uint64_t value) {
+    u32(static_cast<std::uint32_t>(value));
+    u32(static_cast<std::uint32_t>(value >> 32));
+  }
+  void i32(std::int32_t value) { u32(static_cast<std::uint32_t>(value)); }
+  void i64(std::int64_t value) { u64(static_cast<std::uint64_t>(value)); }
+  void str(const char *data, std::size_t length) {
+    u32(static_cast<std::uint32_t>(length));
+    out.append(data, length);
+  }
+  void str(const std::string &value) { str(value.data(), value.size()); }
+};
+
+// Decodes from a byte range it does not own. Reading past the end yields
+// zeros and clears good(), so callers check once after a whole record.
+class ByteReader {
+private:
+  const unsigned char *pos;
+  const unsigned char *end;
+  bool ok;
+
+  bool take(std::size_t n) {
+    if (static_cast<std::size_t>(end - pos) < n) {
+      ok = false;
+      pos = end;
+      return false;
+    }
+    return true;
+  }
+
+public:
+  ByteReader(const void *data, std::size_t length)
+      : pos(static_cast<const unsigned char *>(data)), end(pos + length),
+        ok(true) {}
+
+  std::uint8_t u8() { return take(1) ? *pos++ : 0; }
+  std::uint32_t u32() {
+    if (!take(4)) {
+      return 0;
+    }
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+      value |= static_cast<std::uint32_t>(pos[i]) << (8 * i);
+    }
+    pos += 4;
+    return value;
+  }
+  std::uint64_t u64() {
+    std::uint64_t low = u32();
+    return low | (static_cast<std::uint64_t>(u32()) << 32);
+  }
+  std::int32_t i32() { return static_cast<std::int32_t>(u32()); }
+  std::int64_t i64() { return static_cast<std::int64_t>(u64()); }
+  void str(std::string &value) {
+    std::uint32_t length = u32();
+    if (take(length)) {
+      value.assign(reinterpret_cast<const char *>(pos), length);
+      pos += length;
+    } else {
+      value.clear();
+    }
+  }
+
+  bool good() const { return ok; }
+  std::size_t remaining() const { return static_cast<std::size_t>(end - pos); }
+};
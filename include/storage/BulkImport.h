@@ -0,0 +1,135 @@
+// include/storage/BulkImport.h
+#pragma once // Header guard
+
+#include "common/StringRef.h"
+#include "heap/Waitlist.h" // For WaitlistBackend
+#include "storage/FileHandle.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Streaming readers for flight schedules and passenger manifests. The file
+// is read in large chunks into one fixed buffer. Rows are handed out as
+// StringRefs into that buffer, valid until the next call to next(). Memory
+// use stays at the buffer size, whatever the size of the file.
+//
+// The format is picked by the first four bytes:
+//   "BSCH" / "BMAN"  binary schedule / manifest, then records back to back:
+//     schedule: u16 idLen, u16 originLen, u16 destLen, u8 backend, u8 pad,
+//               i32 capacity, then the three strings
+//     manifest: u16 nameLen, u16 flightLen, then the two strings
+//   anything else    CSV, one row per line (LF or CRLF). A first row whose
+//                    first field is the column name ("flight_id", "name")
+//                    is skipped. Fields may be quoted ("a,b", "say ""hi""")
+//                    but not span lines.
+//     schedule: flight_id,origin,destination,capacity[,backend]
+//               backend is binomial (default), pairing, quaternary or radix
+//     manifest: name[,flight_id]  a flight ID also books the passenger
+// Integers in binary files are in host byte order.
+//
+// A malformed row is skipped and counted (see getRejectedCount() and
+// getFirstError()), so one bad line does not abort a multi-gigabyte load.
+// A flight ID, origin or destination longer than FlightCode::MAX_LENGTH
+// (common/InlineCode.h) makes a schedule row malformed.
+// I/O errors and a truncated binary record throw std::runtime_error.
+
+struct ScheduleRow {
+  StringRef flightId;
+  StringRef origin;
+  StringRef destination;
+  int capacity;
+  WaitlistBackend backend;
+};
+
+struct ManifestRow {
+  StringRef name;
+  StringRef flightId; // Empty: register the passenger only
+};
+
+// Buffered row source shared by both readers
+class BulkReader {
+private:
+  FileHandle file;
+  std::vector<char> buffer;
+  std::size_t begin; // Unread bytes are buffer[begin, end)
+  std::size_t end;
+  bool atEof;
+  bool binary;
+  bool sampling; // Only parse what is already buffered, never read
+  std::size_t sampleStart;
+  std::uint64_t fileSize;
+  std::uint64_t rowNumber; // Line (CSV) or record (binary) just read
+  std::size_t rejected;
+  std::string firstError;
+  std::string scratch; // Unescaped quoted fields of the current row
+  std::size_t sampleRows;
+  std::size_t sampleBytes;
+
+  // Makes at least 'count' unread bytes available unless the file ends
+  // first; returns whether it could
+  bool fill(std::size_t count);
+
+protected:
+  std::vector<StringRef> fields; // Fields of the current CSV row
+
+  BulkReader();
+  // Opens 'path' and reads its first chunk. The file is binary if it
+  // starts with 'magic'.
+  void open(const std::string &path, const char *magic);
+  bool isBinary() const;
+  // Next CSV row split into 'fields'; false at end of file. A first row
+  // whose first field equals 'headerName' is skipped.
+  bool nextCsvRow(const char *headerName);
+  // Next 'length' bytes of a binary record. nullptr at end of file if
+  // 'recordStart' (the previous record was the last); throws if the file
+  // ends inside a record.
+  const char *nextBytes(std::size_t length, bool recordStart);
+  void reject(const char *reason); // Counts the current row as skipped
+
+  // Rows parsed between these two calls come from the first chunk only
+  // and are then read again; they calibrate the size estimates
+  void beginSample();
+  void endSample(std::size_t rows);
+  // Scales a quantity measured over the sample to the whole file
+  std::size_t extrapolate(std::size_t sampled) const;
+
+public:
+  static const std::size_t CHUNK_BYTES = 4 << 20;
+
+  BulkReader(const BulkReader &) = delete;
+  BulkReader &operator=(const BulkReader &) = delete;
+
+  // Rows to expect, extrapolated from the first chunk; for presizing
+  std::size_t estimatedRows() const;
+  std::uint64_t getRowNumber() const;
+  std::size_t getRejectedCount() const;
+  const std::string &getFirstError() const; // Empty if nothing was rejected
+};
+
+class ScheduleReader : public BulkReader {
+public:
+  explicit ScheduleReader(const std::string &path);
+  bool next(ScheduleRow &row); // False at end of file
+};
+
+class ManifestReader : public BulkReader {
+private:
+  std::size_t sampleNameBytes;
+
+public:
+  explicit ManifestReader(const std::string &path);
+  bool next(ManifestRow &row); // False at end of file
+  std::size_t estimatedNameBytes() const; // For PassengerTable::reserve
+};
+
+// Outcome of BookingSystem::importSchedule / importManifest
+struct ImportStats {
+  std::size_t imported;     // Flights added, or passengers registered
+  std::size_t booked;       // Manifest bookings made
+  std::size_t skipped;      // Duplicate flight IDs, unknown flights
+  std::size_t rejected;     // Malformed rows
+  std::string firstProblem; // First skipped row, else first rejected one
+
+  ImportStats() : imported(0), booked(0), skipped(0), rejected(0) {}
+};
@@ -0,0 +1,70 @@
+// include/storage/FileHandle.h
+#pragma once // Header guard
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Move-only owner of a POSIX file descriptor with the few operations the
+// WAL and snapshots need. Every failure throws std::runtime_error naming
+// the file; a storage error is never silently ignored.
+class FileHandle {
+private:
+  friend class MappedFile; // Maps through the descriptor
+  int fd;
+  std::string path;
+
+public:
+  FileHandle();
+  // 'flags' as for open(2); O_CLOEXEC is always added
+  FileHandle(const std::string &path, int flags);
+  ~FileHandle();
+
+  FileHandle(FileHandle &&other);
+  FileHandle &operator=(FileHandle &&other);
+  FileHandle(const FileHandle &) = delete;
+  FileHandle &operator=(const FileHandle &) = delete;
+
+  bool isOpen() const;
+  const std::string &getPath() const;
+  void close();
+
+  void writeAll(const void *data, std::size_t length); // Retries short writes
+  // Reads up to 'length' bytes, fewer only at end of file
+  std::size_t readSome(void *data, std::size_t length);
+  void sync(); // fdatasync where available: data is on stable storage
+  void truncate(std::uint64_t length);
+  std::uint64_t size() const;
+  void seekToEnd();
+  // Positional write, leaves the file offset alone
+  void writeAt(std::uint64_t offset, const void *data, std::size_t length);
+};
+
+// Whole file mapped read-only and shared, so the pages come straight from
+// the page cache and are only read when touched. Move-only.
+class MappedFile {
+private:
+  const char *data;
+  std::size_t length;
+
+public:
+  MappedFile();
+  explicit MappedFile(const std::string &path); // Throws on failure
+  ~MappedFile();
+
+  MappedFile(MappedFile &&other);
+  MappedFile &operator=(MappedFile &&other);
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *getData() const; // nullptr when nothing is mapped
+  std::size_t getSize() const;
+  void unmap();
+};
+
+// True if 'path' names an existing file or directory
+bool pathExists(const std::string &path);
+// Creates the directory if it does not exist yet (not its parents)
+void makeDirectory(const std::string &path);
+// Replaces 'to' by 'from' atomically and makes the rename itself durable
+void renameDurably(const std::string &from, const std::string &to);
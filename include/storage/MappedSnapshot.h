@@ -0,0 +1,133 @@
+// include/storage/MappedSnapshot.h
+#pragma once // Header guard
+
+#include "booking/Flight.h"
+#include "common/StringRef.h"
+#include "common/Types.h"
+#include "heap/Waitlist.h" // For WaitlistBackend
+#include "storage/FileHandle.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Snapshot file layout (version 3). Everything is addressed by file offset
+// or array index, never by pointer, so the file can be mapped anywhere and
+// used in place. Integers are in host byte order; 'endianTag' rejects a
+// file written on a machine of the other order. Sections start 8-byte
+// aligned, in this order:
+//   u64 passengerNameOffsets[passengerCount + 1]  (PassengerTable layout)
+//   char passengerNames[namesSize]
+//   SnapshotFlightRecord flights[flightCount]     (listing order)
+//   u32 flightSlots[hashSlots]  open addressing on FlightIndex::hashId,
+//                               record index + 1, 0 = empty
+//   char strings[stringsSize]   id, origin, destination of each flight
+//   i32 seats[seatCount]        per flight, in seat order
+//   SnapshotWaitlistEntry waitlist[waitlistCount]  per flight, sorted
+struct SnapshotHeader {
+  char magic[4]; // "BSNP"
+  std::uint32_t version;
+  std::uint32_t headerSize;
+  std::uint32_t endianTag; // 0x01020304
+  std::uint64_t lsn;       // Last WAL record reflected in the snapshot
+  std::int64_t nextBookingPriority;
+  std::int32_t firstPassengerId;
+  std::uint32_t reserved; // Zero
+  std::uint64_t passengerCount;
+  std::uint64_t flightCount;
+  std::uint64_t hashSlots; // Power of two, at least 2 * flightCount
+  std::uint64_t namesOffset, namesSize;
+  std::uint64_t passengerOffsetsOffset;
+  std::uint64_t flightsOffset;
+  std::uint64_t slotsOffset;
+  std::uint64_t stringsOffset, stringsSize;
+  std::uint64_t seatsOffset, seatCount;
+  std::uint64_t waitlistOffset, waitlistCount;
+  std::uint64_t fileSize;
+  std::uint32_t bodyCrc;   // CRC-32 of everything after the header
+  std::uint32_t headerCrc; // CRC-32 of the header up to this field
+};
+
+struct SnapshotFlightRecord {
+  std::uint64_t stringsBegin; // Index into strings: id, origin, destination
+  std::uint64_t seatsBegin;   // Index into seats
+  std::uint64_t waitlistBegin; // Index into waitlist
+  std::uint32_t idLength, originLength, destinationLength;
+  std::int32_t capacity;
+  std::uint32_t seatCount;
+  std::uint32_t waitlistCount;
+  std::uint8_t backend; // WaitlistBackend
+  std::uint8_t padding[7];
+};
+
+struct SnapshotWaitlistEntry {
+  std::int64_t priority; // Packed key, see common/PriorityKey.h
+  std::int32_t passengerId;
+  std::uint32_t padding; // Zero
+};
+
+// One flight of a mapped snapshot, read in place. Pointers stay valid while
+// the MappedSnapshot is open.
+struct SnapshotFlightView {
+  const char *id;
+  std::size_t idLength;
+  const char *origin;
+  std::size_t originLength;
+  const char *destination;
+  std::size_t destinationLength;
+  int capacity;
+  WaitlistBackend backend;
+  const std::int32_t *seats; // Seat order
+  std::size_t seatCount;
+  const SnapshotWaitlistEntry *waitlist; // Priority order
+  std::size_t waitlistCount;
+};
+
+// Read-only snapshot used straight from the page cache. open() checks the
+// header and that every section lies inside the file, then it is ready:
+// no flight, heap or hash table is built. Lookups hash into the stored
+// slot table. A Flight is only built by materialize(), when the flight is
+// first changed. verify() checks the body checksum (reads every page)
+// for callers that can afford it.
+class MappedSnapshot {
+private:
+  MappedFile file;
+  SnapshotHeader header;
+  const std::uint64_t *nameOffsets;
+  const char *names;
+  const SnapshotFlightRecord *flights;
+  const std::uint32_t *slots;
+  const char *strings;
+  const std::int32_t *seats;
+  const SnapshotWaitlistEntry *waitlist;
+
+  [[noreturn]] void corrupt() const;
+  const SnapshotFlightRecord &record(std::uint32_t index) const;
+
+public:
+  static const std::uint32_t VERSION = 3;
+  static const std::uint32_t NOT_FOUND = 0xFFFFFFFFu;
+
+  MappedSnapshot();
+
+  // False if there is no file at 'path'. Throws std::runtime_error if it
+  // is not a usable snapshot of this VERSION.
+  bool open(const std::string &path);
+  bool isOpen() const;
+  void close();
+  void verify() const; // Throws std::runtime_error on a checksum mismatch
+
+  std::uint64_t getLsn() const;
+  PriorityType getNextBookingPriority() const;
+
+  PassengerIdType getFirstPassengerId() const;
+  std::size_t getPassengerCount() const;
+  // PassengerTable-compatible name storage (getPassengerCount() + 1 offsets)
+  const std::uint64_t *getNameOffsets() const;
+  const char *getNames() const;
+
+  std::size_t getFlightCount() const;
+  std::uint32_t find(StringRef flightId) const; // Or NOT_FOUND
+  SnapshotFlightView getFlight(std::uint32_t index) const;
+  // Builds the mutable Flight (no event sink) for a record
+  Flight materialize(std::uint32_t index) const;
+};
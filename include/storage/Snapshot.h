@@ -0,0 +1,38 @@
+// include/storage/Snapshot.h
+#pragma once // Header guard
+
+#include "booking/FlightIndex.h"
+#include "common/Types.h"
+#include "core/PassengerTable.h"
+#include "storage/MappedSnapshot.h"
+#include <cstdint>
+#include <string>
+
+// Compact point-in-time image of a booking system, the base that the WAL
+// tail is replayed onto at startup. The file layout is described in
+// MappedSnapshot.h; only who holds a seat and the waitlist order are
+// stored, never heap shapes or hash tables of the live objects.
+struct SnapshotInfo {
+  std::uint64_t lsn; // Last WAL record reflected in the snapshot
+  PriorityType nextBookingPriority;
+
+  SnapshotInfo() : lsn(0), nextBookingPriority(1) {}
+};
+
+// Writes to path + ".tmp", syncs it and renames it over 'path', so a crash
+// leaves either the old or the new snapshot. Flights come from 'flights'
+// and, if given, from the records of 'baseline' that have no live copy in
+// 'flights' (they are copied without being materialized). Throws
+// std::runtime_error on I/O errors.
+void writeSnapshot(const std::string &path, const SnapshotInfo &info,
+                   const PassengerTable &passengers,
+                   const FlightIndex &flights,
+                   const MappedSnapshot *baseline = nullptr);
+
+// Eager load: verifies the checksum and materializes every flight into
+// 'flights' (which must hold no flights yet), replacing 'passengers'.
+// Returns false if there is no snapshot at 'path'; throws
+// std::runtime_error if it is unreadable or corrupt. Restored flights have
+// no event sink. MappedSnapshot is the lazy alternative.
+bool loadSnapshot(const std::string &path, SnapshotInfo &info,
+                  PassengerTable &passengers, FlightIndex &flights);
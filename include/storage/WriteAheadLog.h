@@ -0,0 +1,119 @@
+// include/storage/WriteAheadLog.h
+#pragma once // Header guard
+
+#include "common/StringRef.h"
+#include "common/Types.h"
+#include "heap/Waitlist.h" // For WaitlistBackend
+#include "storage/FileHandle.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// One decoded journal entry. Which fields are set depends on the type.
+struct WalRecord {
+  enum class Type : std::uint8_t {
+    AddPassenger = 1, // passengerId, name
+    AddFlight,        // flightId, name (origin), destination, capacity, backend
+    Booked,           // flightId, passengerId, priority (seat or waitlist)
+    Cancelled,        // flightId, passengerId (seat or waitlist entry)
+    Promoted,         // flightId, passengerId, priority; implied by Cancelled
+                      // or HoldReleased
+    Upgraded,         // flightId, passengerId, priority (the new one)
+    Held,             // flightId, passengerId (seat held for checkout)
+    HoldConfirmed,    // flightId, passengerId
+    HoldReleased      // flightId, passengerId (given up or expired)
+  };
+
+  Type type;
+  std::uint64_t lsn; // Log sequence number, strictly increasing from 1
+  PassengerIdType passengerId;
+  PriorityType priority;
+  std::string flightId;
+  std::string name;
+  std::string destination;
+  int capacity;
+  WaitlistBackend backend;
+
+  WalRecord()
+      : type(Type::Booked), lsn(0), passengerId(INVALID_PASSENGER_ID),
+        priority(MAX_PRIORITY), capacity(0),
+        backend(WaitlistBackend::Binomial) {}
+};
+
+// Append-only binary journal of state changes with group commit.
+//
+// File: "BWAL" magic and a u32 version, then records framed as
+//   u32 payload length | u32 CRC-32 of payload | payload
+// where the payload is u8 type, u64 lsn and the type's fields. A crash can
+// leave a torn record at the tail; open() stops replay at the first frame
+// that is short or fails its checksum and cuts the file back to there.
+//
+// Appends only encode into an in-memory buffer. The buffer is written and
+// fdatasync'ed once 'groupRecords' records are pending, or on the first
+// append after 'groupDelay' has passed since the oldest pending one, or on
+// commit(). One fsync thus covers a whole group of bookings; records of
+// the current group are lost on a crash, never half applied. Between
+// holdCommits() and releaseCommits() no limit triggers a commit, so
+// records that must survive together land in the same group.
+class WriteAheadLog {
+public:
+  using Clock = std::chrono::steady_clock;
+  static const std::size_t DEFAULT_GROUP_RECORDS = 4096;
+  static const unsigned DEFAULT_GROUP_DELAY_MS = 10;
+
+private:
+  FileHandle file;
+  std::string pending; // Encoded frames not yet written
+  std::size_t pendingRecords;
+  Clock::time_point pendingSince;
+  std::uint64_t nextLsn;
+  std::size_t groupRecords;
+  Clock::duration groupDelay;
+  std::uint64_t commitCount; // fsyncs issued, for tests and stats
+  unsigned holdDepth;        // Nested holdCommits() calls still open
+
+  std::size_t beginRecord(WalRecord::Type type); // Returns frame offset
+  void endRecord(std::size_t frameOffset);
+  bool groupIsDue() const; // A group limit has been reached
+
+public:
+  explicit WriteAheadLog(std::size_t groupRecords = DEFAULT_GROUP_RECORDS,
+                         unsigned groupDelayMs = DEFAULT_GROUP_DELAY_MS);
+  ~WriteAheadLog(); // Commits whatever is pending
+
+  WriteAheadLog(const WriteAheadLog &) = delete;
+  WriteAheadLog &operator=(const WriteAheadLog &) = delete;
+
+  // Opens (or creates) the journal at 'path', calls replay for every intact
+  // record with an LSN above 'afterLsn' (records up to it are already in
+  // the snapshot), drops a torn tail and positions for appending. Returns
+  // the number of records replayed.
+  std::size_t open(const std::string &path, std::uint64_t afterLsn,
+                   const std::function<void(const WalRecord &)> &replay);
+  bool isOpen() const;
+
+  // --- Appends (buffered, see the class comment) ---
+  void logPassenger(PassengerIdType passengerId, const char *name,
+                    std::size_t nameLength);
+  void logFlight(const std::string &flightId, const std::string &origin,
+                 const std::string &destination, int capacity,
+                 WaitlistBackend backend);
+  void logBooking(WalRecord::Type type, StringRef flightId,
+                  PassengerIdType passengerId, PriorityType priority);
+
+  void commit(); // Writes and syncs the pending group, if any
+  // Defers the automatic commits of endRecord() until the matching
+  // releaseCommits(), which commits if a limit was crossed meanwhile.
+  // Nests; an explicit commit() still goes through.
+  void holdCommits();
+  void releaseCommits();
+  // After a snapshot covering lastLsn() is durable: commits, then empties
+  // the file. LSNs keep counting up.
+  void reset();
+
+  std::uint64_t lastLsn() const; // LSN of the newest appended record
+  std::size_t pendingCount() const;
+  std::uint64_t getCommitCount() const;
+};
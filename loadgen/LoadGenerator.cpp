@@ -0,0 +1,376 @@
+// loadgen/LoadGenerator.cpp
+#include "LoadGenerator.h"
+#include <algorithm> // For std::lower_bound, std::shuffle
+#include <atomic>
+#include <chrono>
+#include <cmath>     // For std::pow, std::ceil
+#include <exception> // For std::exception_ptr
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::size_t RESULT_KINDS =
+    static_cast<std::size_t>(BookingResult::AlreadyHeld) + 1;
+const std::size_t PHASE_COUNT = static_cast<std::size_t>(LoadPhase::Count);
+
+// Flight indexes by Zipf rank. cdf[k] is the probability of ranks 0..k, so
+// sampling from the top 'ranks' only rescales the uniform draw.
+class ZipfFlights {
+private:
+  std::vector<double> cdf;
+  std::vector<std::size_t> flightOfRank; // Shuffled, spreads hot flights
+
+public:
+  ZipfFlights(std::size_t flights, double exponent, std::uint64_t seed)
+      : cdf(flights), flightOfRank(flights) {
+    double total = 0;
+    for (std::size_t k = 0; k < flights; ++k) {
+      total += 1.0 / std::pow(static_cast<double>(k + 1), exponent);
+      cdf[k] = total;
+      flightOfRank[k] = k;
+    }
+    for (double &c : cdf) {
+      c /= total;
+    }
+    std::mt19937_64 rng(seed);
+    std::shuffle(flightOfRank.begin(), flightOfRank.end(), rng);
+  }
+
+  std::size_t sample(std::mt19937_64 &rng, std::size_t ranks) const {
+    std::uniform_real_distribution<double> uniform(0.0, cdf[ranks - 1]);
+    std::size_t rank = static_cast<std::size_t>(
+        std::lower_bound(cdf.begin(), cdf.begin() + ranks, uniform(rng)) -
+        cdf.begin());
+    return flightOfRank[std::min(rank, ranks - 1)];
+  }
+};
+
+// Everything one client thread keeps across phases
+struct Client {
+  std::unique_ptr<LoadSession> session;
+  std::mt19937_64 rng;
+  const PassengerIdType *passengers; // This client's slice
+  std::size_t nextPassenger;
+  // Own bookings still standing: {passenger, flight}. A waitlisted one
+  // may since have been promoted; that only shows when it is cancelled.
+  std::vector<std::pair<PassengerIdType, std::size_t>> seats;
+  std::vector<std::pair<PassengerIdType, std::size_t>> waiting;
+  std::unique_ptr<LogHistogram> latency[PHASE_COUNT];
+  std::uint64_t results[PHASE_COUNT][RESULT_KINDS];
+  std::size_t ops[PHASE_COUNT];
+  std::size_t bookOps[PHASE_COUNT];
+  std::exception_ptr error;
+
+  Client() : passengers(nullptr), nextPassenger(0) {
+    for (std::size_t p = 0; p < PHASE_COUNT; ++p) {
+      latency[p].reset(new LogHistogram());
+      std::fill(results[p], results[p] + RESULT_KINDS, 0);
+      ops[p] = 0;
+      bookOps[p] = 0;
+    }
+  }
+};
+
+std::pair<PassengerIdType, std::size_t>
+takeRandom(std::vector<std::pair<PassengerIdType, std::size_t>> &bookings,
+           std::mt19937_64 &rng) {
+  std::size_t i = std::uniform_int_distribution<std::size_t>(
+      0, bookings.size() - 1)(rng);
+  std::pair<PassengerIdType, std::size_t> taken = bookings[i];
+  bookings[i] = bookings.back();
+  bookings.pop_back();
+  return taken;
+}
+
+// Generates and runs one client's share of a phase, a window at a time
+void runClient(Client &client, LoadPhase phase, const LoadProfile &profile,
+               const ZipfFlights &zipf) {
+  const std::size_t p = static_cast<std::size_t>(phase);
+  std::size_t total = 0;
+  switch (phase) {
+  case LoadPhase::Steady:
+    total = profile.steadyOps;
+    break;
+  case LoadPhase::SaleLaunch:
+    total = profile.burstOps;
+    break;
+  case LoadPhase::CancellationWave:
+    total = static_cast<std::size_t>(
+        std::ceil(profile.waveFraction * client.seats.size()));
+    break;
+  case LoadPhase::Count:
+    break;
+  }
+  const std::size_t hot =
+      std::max<std::size_t>(1, std::min<std::size_t>(profile.hotFlights,
+                                                     profile.flights));
+  std::bernoulli_distribution cancelDraw(profile.cancelRatio);
+  std::vector<LoadOp> window;
+  std::vector<BookingResult> results;
+  std::vector<std::uint64_t> latencies;
+
+  for (std::size_t done = 0; done < total;) {
+    window.clear();
+    const std::size_t count =
+        std::min<std::size_t>(std::max(profile.depth, 1u), total - done);
+    for (std::size_t i = 0; i < count; ++i) {
+      LoadOp op;
+      op.cancel = phase == LoadPhase::CancellationWave ||
+                  (phase == LoadPhase::Steady &&
+                   (!client.seats.empty() || !client.waiting.empty()) &&
+                   cancelDraw(client.rng));
+      if (op.cancel) {
+        // The wave gives back seats; steady cancellations pick either kind
+        const bool fromSeats =
+            phase == LoadPhase::CancellationWave || client.waiting.empty() ||
+            (!client.seats.empty() &&
+             std::bernoulli_distribution(0.5)(client.rng));
+        std::vector<std::pair<PassengerIdType, std::size_t>> &bookings =
+            fromSeats ? client.seats : client.waiting;
+        if (bookings.empty()) {
+          break; // The wave ran out of seats to give back
+        }
+        std::pair<PassengerIdType, std::size_t> booking =
+            takeRandom(bookings, client.rng);
+        op.passengerId = booking.first;
+        op.flight = booking.second;
+      } else {
+        op.passengerId = client.passengers[client.nextPassenger++];
+        op.flight = zipf.sample(client.rng, phase == LoadPhase::SaleLaunch
+                                                ? hot
+                                                : profile.flights);
+      }
+      window.push_back(op);
+    }
+    if (window.empty()) {
+      break;
+    }
+    client.session->execute(window, results, latencies);
+    for (std::size_t i = 0; i < window.size(); ++i) {
+      client.latency[p]->record(latencies[i]);
+      ++client.results[p][static_cast<std::size_t>(results[i])];
+      if (window[i].cancel) {
+        continue;
+      }
+      ++client.bookOps[p];
+      std::pair<PassengerIdType, std::size_t> booking(window[i].passengerId,
+                                                      window[i].flight);
+      if (results[i] == BookingResult::Confirmed) {
+        client.seats.push_back(booking);
+      } else if (results[i] == BookingResult::Waitlisted) {
+        client.waiting.push_back(booking);
+      }
+    }
+    client.ops[p] += window.size();
+    done += window.size();
+  }
+}
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double micros(std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; }
+
+} // namespace
+
+LoadProfile::LoadProfile()
+    : threads(std::max(1u, std::thread::hardware_concurrency())),
+      flights(10000), capacity(180), zipfExponent(1.1), steadyOps(100000),
+      cancelRatio(0.2), burstOps(50000), hotFlights(100), waveFraction(0.5),
+      depth(1), seed(42) {}
+
+const char *toString(LoadPhase phase) {
+  switch (phase) {
+  case LoadPhase::Steady:
+    return "steady";
+  case LoadPhase::SaleLaunch:
+    return "sale_launch";
+  case LoadPhase::CancellationWave:
+    return "cancellation_wave";
+  case LoadPhase::Count:
+    break;
+  }
+  return "unknown";
+}
+
+PhaseReport::PhaseReport()
+    : phase(LoadPhase::Steady), ops(0), bookOps(0), seconds(0),
+      results(RESULT_KINDS, 0) {}
+
+LoadReport runLoad(LoadTarget &target, const LoadProfile &profile) {
+  LoadReport report;
+  const unsigned threads = std::max(profile.threads, 1u);
+  std::vector<std::string> flightIds;
+  flightIds.reserve(profile.flights);
+  for (unsigned f = 0; f < profile.flights; ++f) {
+    flightIds.push_back("LG" + std::to_string(f));
+  }
+
+  const Clock::time_point setupStart = Clock::now();
+  const std::size_t perClient = profile.steadyOps + profile.burstOps;
+  std::vector<PassengerIdType> passengerIds;
+  target.setup(flightIds, profile.capacity, perClient * threads,
+               passengerIds);
+  std::vector<Client> clients(threads);
+  for (unsigned t = 0; t < threads; ++t) {
+    clients[t].session = target.connect(flightIds);
+    clients[t].rng.seed(profile.seed + 1 + t);
+    clients[t].passengers = passengerIds.data() + perClient * t;
+  }
+  report.setupSeconds = secondsSince(setupStart);
+  std::cout << "Set up " << profile.flights << " flights and "
+            << passengerIds.size() << " passengers in " << std::fixed
+            << std::setprecision(2) << report.setupSeconds << " s\n";
+
+  const ZipfFlights zipf(profile.flights, profile.zipfExponent, profile.seed);
+  for (std::size_t p = 0; p < PHASE_COUNT; ++p) {
+    const LoadPhase phase = static_cast<LoadPhase>(p);
+    // Threads are started first and released together, so a sale launch
+    // really hits the hot flights from every client at once
+    std::atomic<bool> go(false);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+      workers.emplace_back([&, t]() {
+        while (!go.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        try {
+          runClient(clients[t], phase, profile, zipf);
+        } catch (...) {
+          clients[t].error = std::current_exception();
+        }
+      });
+    }
+    const Clock::time_point start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
+
+    PhaseReport phaseReport;
+    phaseReport.phase = phase;
+    phaseReport.seconds = secondsSince(start);
+    for (Client &client : clients) {
+      if (client.error) {
+        std::rethrow_exception(client.error);
+      }
+      phaseReport.ops += client.ops[p];
+      phaseReport.bookOps += client.bookOps[p];
+      phaseReport.latencyNs.add(*client.latency[p]);
+      for (std::size_t r = 0; r < RESULT_KINDS; ++r) {
+        phaseReport.results[r] += client.results[p][r];
+      }
+    }
+    std::cout << "Phase " << toString(phase) << ": " << phaseReport.ops
+              << " requests in " << std::setprecision(2)
+              << phaseReport.seconds << " s" << std::endl; // Show progress
+    report.phases.push_back(std::move(phaseReport));
+  }
+  return report;
+}
+
+bool readMemoryUsage(int pid, std::uint64_t &rssKb, std::uint64_t &peakKb) {
+  std::ifstream status(pid == 0 ? std::string("/proc/self/status")
+                                : "/proc/" + std::to_string(pid) +
+                                      "/status");
+  std::string key;
+  bool haveRss = false;
+  bool havePeak = false;
+  while (status >> key) {
+    if (key == "VmRSS:") {
+      haveRss = static_cast<bool>(status >> rssKb);
+    } else if (key == "VmHWM:") {
+      havePeak = static_cast<bool>(status >> peakKb);
+    }
+    status.ignore(1 << 10, '\n');
+  }
+  return haveRss && havePeak;
+}
+
+void printReport(const LoadReport &report) {
+  std::cout << std::left << std::setw(20) << "Phase" << std::right
+            << std::setw(10) << "requests" << std::setw(12) << "req/s"
+            << std::setw(12) << "book/s" << std::setw(10) << "p50 us"
+            << std::setw(10) << "p99 us" << std::setw(10) << "p999 us"
+            << std::setw(10) << "max us" << "\n";
+  for (const PhaseReport &phase : report.phases) {
+    const double seconds = phase.seconds > 0 ? phase.seconds : 1e-9;
+    std::cout << std::left << std::setw(20) << toString(phase.phase)
+              << std::right << std::setw(10) << phase.ops << std::fixed
+              << std::setprecision(0) << std::setw(12) << phase.ops / seconds
+              << std::setw(12) << phase.bookOps / seconds
+              << std::setprecision(1) << std::setw(10)
+              << micros(phase.latencyNs.valueAtQuantile(0.5)) << std::setw(10)
+              << micros(phase.latencyNs.valueAtQuantile(0.99))
+              << std::setw(10)
+              << micros(phase.latencyNs.valueAtQuantile(0.999))
+              << std::setw(10)
+              << micros(phase.latencyNs.valueAtQuantile(1.0)) << "\n";
+    std::cout << "  ";
+    for (std::size_t r = 0; r < RESULT_KINDS; ++r) {
+      if (phase.results[r] != 0) {
+        std::cout << ' ' << toString(static_cast<BookingResult>(r)) << '='
+                  << phase.results[r];
+      }
+    }
+    std::cout << "\n";
+  }
+}
+
+bool writeJson(const LoadReport &report, const LoadProfile &profile,
+               const std::string &description, int memoryPid,
+               const std::string &path) {
+  std::ofstream out(path.c_str());
+  if (!out) {
+    return false;
+  }
+  out << "{\n  \"context\": {\"target\": \"" << description
+      << "\", \"threads\": " << profile.threads
+      << ", \"flights\": " << profile.flights
+      << ", \"capacity\": " << profile.capacity
+      << ", \"zipf\": " << profile.zipfExponent
+      << ", \"depth\": " << profile.depth << ", \"seed\": " << profile.seed
+      << "},\n";
+  std::uint64_t rssKb = 0;
+  std::uint64_t peakKb = 0;
+  if (readMemoryUsage(memoryPid, rssKb, peakKb)) {
+    out << "  \"memory\": {\"rss_kb\": " << rssKb
+        << ", \"peak_rss_kb\": " << peakKb << "},\n";
+  }
+  out << "  \"phases\": [\n" << std::fixed << std::setprecision(2);
+  for (std::size_t i = 0; i < report.phases.size(); ++i) {
+    const PhaseReport &phase = report.phases[i];
+    const double seconds = phase.seconds > 0 ? phase.seconds : 1e-9;
+    out << "    {\"name\": \"" << toString(phase.phase)
+        << "\", \"requests\": " << phase.ops
+        << ", \"bookings\": " << phase.bookOps
+        << ", \"seconds\": " << phase.seconds
+        << ", \"requests_per_sec\": " << phase.ops / seconds
+        << ", \"bookings_per_sec\": " << phase.bookOps / seconds
+        << ", \"p50_us\": " << micros(phase.latencyNs.valueAtQuantile(0.5))
+        << ", \"p99_us\": " << micros(phase.latencyNs.valueAtQuantile(0.99))
+        << ", \"p999_us\": "
+        << micros(phase.latencyNs.valueAtQuantile(0.999))
+        << ", \"max_us\": " << micros(phase.latencyNs.valueAtQuantile(1.0))
+        << ", \"results\": {";
+    bool first = true;
+    for (std::size_t r = 0; r < RESULT_KINDS; ++r) {
+      if (phase.results[r] != 0) {
+        out << (first ? "" : ", ") << '"'
+            << toString(static_cast<BookingResult>(r))
+            << "\": " << phase.results[r];
+        first = false;
+      }
+    }
+    out << "}}" << (i + 1 < report.phases.size() ? ",\n" : "\n");
+  }
+  out << "  ]\n}\n";
+  return static_cast<bool>(out);
+}
@@ -0,0 +1,145 @@
+// loadgen/LoadGenerator.h
+
+#pragma once // Header guard
+
+#include "booking/BookingRequest.h"
+#include "common/Types.h"
+#include "metrics/LogHistogram.h"
+#include "server/BookingService.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Shape of the synthetic traffic. Flight popularity follows a Zipf law
+// (rank k is booked with weight 1 / k^zipfExponent); ranks are shuffled
+// over the flight list so the hot flights land in different shards. Every
+// booking is made by a fresh passenger, so no request is a duplicate.
+struct LoadProfile {
+  unsigned threads;    // Client threads, each with its own session
+  unsigned flights;
+  int capacity;        // Seats per flight
+  double zipfExponent; // 0 is uniform
+  // Steady phase: per thread, a mix of bookings and cancellations of the
+  // thread's own earlier bookings
+  std::size_t steadyOps;
+  double cancelRatio;
+  // Sale launch: per thread, bookings only, on the 'hotFlights' most
+  // popular flights, all threads released at once
+  std::size_t burstOps;
+  unsigned hotFlights;
+  // Cancellation wave: every thread cancels this share of the seats it
+  // holds; on oversold flights each one promotes a waitlisted passenger
+  double waveFraction;
+  // Requests per service call in process, requests in flight per
+  // connection against a server
+  unsigned depth;
+  std::uint64_t seed;
+
+  LoadProfile();
+};
+
+enum class LoadPhase { Steady, SaleLaunch, CancellationWave, Count };
+
+const char *toString(LoadPhase phase);
+
+// One generated request; 'flight' indexes the target's flight list
+struct LoadOp {
+  bool cancel;
+  PassengerIdType passengerId;
+  std::size_t flight;
+};
+
+// One client thread's line to the system under test. execute() runs the
+// ops in order and fills in each one's result and latency (nanoseconds).
+class LoadSession {
+public:
+  virtual ~LoadSession() {}
+  virtual void execute(const std::vector<LoadOp> &ops,
+                       std::vector<BookingResult> &results,
+                       std::vector<std::uint64_t> &latenciesNs) = 0;
+};
+
+// System under test: creates the flights and passengers, then hands out a
+// session per client thread
+class LoadTarget {
+public:
+  virtual ~LoadTarget() {}
+  // Appends the IDs of 'passengers' new passengers to passengerIds
+  virtual void setup(const std::vector<std::string> &flightIds, int capacity,
+                     std::size_t passengers,
+                     std::vector<PassengerIdType> &passengerIds) = 0;
+  virtual std::unique_ptr<LoadSession>
+  connect(const std::vector<std::string> &flightIds) = 0;
+};
+
+// Calls a BookingService directly. Each window of ops is split into runs
+// of bookings or cancellations, one batch call each, followed by commit()
+// like a server round; every op of a call gets the call's latency. A
+// service that is not thread-safe is called under one lock.
+class InProcessTarget : public LoadTarget {
+private:
+  BookingService &service;
+  std::mutex serviceMutex;
+
+public:
+  explicit InProcessTarget(BookingService &bookingService);
+  void setup(const std::vector<std::string> &flightIds, int capacity,
+             std::size_t passengers,
+             std::vector<PassengerIdType> &passengerIds) override;
+  std::unique_ptr<LoadSession>
+  connect(const std::vector<std::string> &flightIds) override;
+};
+
+// Talks the request server's line protocol (server/RequestServer.h) over
+// a Unix domain socket (unixPath) or TCP. A session keeps up to 'depth'
+// requests in flight; a request's latency runs from sending its window
+// to reading its reply line. Throws std::runtime_error if the server
+// cannot be reached or answers with an error.
+class SocketTarget : public LoadTarget {
+private:
+  std::string unixPath; // Empty for TCP
+  std::string host;
+  int port;
+
+public:
+  SocketTarget(std::string path, std::string tcpHost, int tcpPort);
+  void setup(const std::vector<std::string> &flightIds, int capacity,
+             std::size_t passengers,
+             std::vector<PassengerIdType> &passengerIds) override;
+  std::unique_ptr<LoadSession>
+  connect(const std::vector<std::string> &flightIds) override;
+};
+
+// Outcome of one phase, summed over the client threads
+struct PhaseReport {
+  LoadPhase phase;
+  std::size_t ops;
+  std::size_t bookOps;
+  double seconds; // Wall time from releasing the threads to the last one
+  HistogramTotals latencyNs;
+  std::vector<std::uint64_t> results; // Count per BookingResult
+
+  PhaseReport();
+};
+
+struct LoadReport {
+  std::vector<PhaseReport> phases;
+  double setupSeconds;
+};
+
+// Sets up the target, then runs the steady, sale launch and cancellation
+// wave phases in turn with profile.threads clients. Progress goes to
+// stdout.
+LoadReport runLoad(LoadTarget &target, const LoadProfile &profile);
+
+// Resident and peak resident set size of a process, in KiB, from
+// /proc/<pid>/status (pid 0: this process). False if unavailable.
+bool readMemoryUsage(int pid, std::uint64_t &rssKb, std::uint64_t &peakKb);
+
+void printReport(const LoadReport &report);
+bool writeJson(const LoadReport &report, const LoadProfile &profile,
+               const std::string &description, int memoryPid,
+               const std::string &path);
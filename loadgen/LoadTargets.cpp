@@ -0,0 +1,308 @@
+// loadgen/LoadTargets.cpp
+// The two ways of reaching the system under test: direct BookingService
+// calls, and the request server's line protocol over a socket.
+#include "LoadGenerator.h"
+#include <algorithm> // For std::min
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdlib> // For std::atoi
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::uint64_t nanosSince(Clock::time_point start) {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() -
+                                                           start)
+          .count());
+}
+
+// --- In Process ---
+
+class InProcessSession : public LoadSession {
+private:
+  BookingService &service;
+  std::mutex *serviceMutex; // nullptr for a thread-safe service
+  const std::vector<std::string> &flightIds;
+  std::vector<BookingRequest> batch;
+  std::vector<BookingResult> batchResults;
+
+public:
+  InProcessSession(BookingService &bookingService, std::mutex *mutex,
+                   const std::vector<std::string> &flights)
+      : service(bookingService), serviceMutex(mutex), flightIds(flights) {}
+
+  void execute(const std::vector<LoadOp> &ops,
+               std::vector<BookingResult> &results,
+               std::vector<std::uint64_t> &latenciesNs) override {
+    results.resize(ops.size());
+    latenciesNs.resize(ops.size());
+    std::size_t first = 0;
+    while (first < ops.size()) {
+      // A run of bookings or of cancellations is one batch call
+      std::size_t last = first + 1;
+      while (last < ops.size() && ops[last].cancel == ops[first].cancel) {
+        ++last;
+      }
+      batch.clear();
+      for (std::size_t i = first; i < last; ++i) {
+        batch.emplace_back(ops[i].passengerId, flightIds[ops[i].flight]);
+      }
+      const Clock::time_point start = Clock::now();
+      {
+        std::unique_lock<std::mutex> lock;
+        if (serviceMutex != nullptr) {
+          lock = std::unique_lock<std::mutex>(*serviceMutex);
+        }
+        if (ops[first].cancel) {
+          service.cancelBatch(batch, batchResults);
+        } else {
+          service.bookBatch(batch, batchResults);
+        }
+        service.commit();
+      }
+      const std::uint64_t elapsed = nanosSince(start);
+      for (std::size_t i = first; i < last; ++i) {
+        results[i] = batchResults[i - first];
+        latenciesNs[i] = elapsed;
+      }
+      first = last;
+    }
+  }
+};
+
+// --- Socket ---
+
+const BookingResult ALL_RESULTS[] = {
+    BookingResult::Confirmed,        BookingResult::Waitlisted,
+    BookingResult::AlreadyConfirmed, BookingResult::AlreadyWaitlisted,
+    BookingResult::Cancelled,        BookingResult::RemovedFromWaitlist,
+    BookingResult::NotBooked,        BookingResult::UnknownFlight,
+    BookingResult::UnknownPassenger, BookingResult::SoldOut,
+    BookingResult::Held,             BookingResult::HoldReleased,
+    BookingResult::NotHeld,          BookingResult::AlreadyHeld};
+
+BookingResult parseResult(const std::string &line) {
+  for (BookingResult result : ALL_RESULTS) {
+    if (line == toString(result)) {
+      return result;
+    }
+  }
+  throw std::runtime_error("Unexpected reply from the server: '" + line +
+                           "'");
+}
+
+// Blocking connection with a line reader
+class LineSocket {
+private:
+  int fd;
+  std::string input;
+  std::size_t inputPos;
+
+public:
+  LineSocket(const std::string &unixPath, const std::string &host, int port)
+      : fd(-1), inputPos(0) {
+    if (!unixPath.empty()) {
+      sockaddr_un address;
+      std::memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      if (unixPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Unix socket path too long: " + unixPath);
+      }
+      std::strcpy(address.sun_path, unixPath.c_str());
+      fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&address),
+                              sizeof(address)) != 0) {
+        close();
+        throw std::runtime_error("Cannot connect to " + unixPath);
+      }
+      return;
+    }
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    if (::inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+      throw std::runtime_error("Not a numeric IPv4 address: " + host);
+    }
+    fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&address),
+                            sizeof(address)) != 0) {
+      close();
+      throw std::runtime_error("Cannot connect to " + host + ':' +
+                               std::to_string(port));
+    }
+    int noDelay = 1; // Windows are sent whole, do not hold back the tail
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+  }
+
+  ~LineSocket() { close(); }
+
+  LineSocket(const LineSocket &) = delete;
+  LineSocket &operator=(const LineSocket &) = delete;
+
+  void close() {
+    if (fd >= 0) {
+      ::close(fd);
+      fd = -1;
+    }
+  }
+
+  void sendAll(const std::string &data) {
+    std::size_t sent = 0;
+    while (sent < data.size()) {
+      ssize_t n = ::send(fd, data.data() + sent, data.size() - sent,
+                         MSG_NOSIGNAL);
+      if (n <= 0) {
+        throw std::runtime_error("Connection to the server lost");
+      }
+      sent += static_cast<std::size_t>(n);
+    }
+  }
+
+  // Next reply line without its '\n'
+  void readLine(std::string &line) {
+    for (;;) {
+      std::size_t newline = input.find('\n', inputPos);
+      if (newline != std::string::npos) {
+        line.assign(input, inputPos, newline - inputPos);
+        inputPos = newline + 1;
+        return;
+      }
+      input.erase(0, inputPos);
+      inputPos = 0;
+      char buffer[1 << 16];
+      ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+      if (n <= 0) {
+        throw std::runtime_error("Connection to the server lost");
+      }
+      input.append(buffer, static_cast<std::size_t>(n));
+    }
+  }
+};
+
+class SocketSession : public LoadSession {
+private:
+  LineSocket socket;
+  const std::vector<std::string> &flightIds;
+  std::string requests;
+  std::string line;
+
+public:
+  SocketSession(const std::string &unixPath, const std::string &host,
+                int port, const std::vector<std::string> &flights)
+      : socket(unixPath, host, port), flightIds(flights) {}
+
+  void execute(const std::vector<LoadOp> &ops,
+               std::vector<BookingResult> &results,
+               std::vector<std::uint64_t> &latenciesNs) override {
+    results.resize(ops.size());
+    latenciesNs.resize(ops.size());
+    requests.clear();
+    for (const LoadOp &op : ops) {
+      requests += op.cancel ? "cancel " : "book ";
+      requests += std::to_string(op.passengerId);
+      requests += ' ';
+      requests += flightIds[op.flight];
+      requests += '\n';
+    }
+    const Clock::time_point start = Clock::now();
+    socket.sendAll(requests);
+    for (std::size_t i = 0; i < ops.size(); ++i) {
+      socket.readLine(line);
+      latenciesNs[i] = nanosSince(start);
+      results[i] = parseResult(line);
+    }
+  }
+};
+
+// Requests sent ahead of their replies during setup
+const std::size_t SETUP_WINDOW = 4096;
+
+} // namespace
+
+// --- InProcessTarget ---
+
+InProcessTarget::InProcessTarget(BookingService &bookingService)
+    : service(bookingService) {}
+
+void InProcessTarget::setup(const std::vector<std::string> &flightIds,
+                            int capacity, std::size_t passengers,
+                            std::vector<PassengerIdType> &passengerIds) {
+  for (const std::string &flightId : flightIds) {
+    service.addFlight(flightId, "Origin", "Destination", capacity);
+  }
+  passengerIds.reserve(passengerIds.size() + passengers);
+  for (std::size_t i = 0; i < passengers; ++i) {
+    passengerIds.push_back(service.addPassenger("Load" + std::to_string(i)));
+  }
+  service.commit();
+}
+
+std::unique_ptr<LoadSession>
+InProcessTarget::connect(const std::vector<std::string> &flightIds) {
+  return std::unique_ptr<LoadSession>(new InProcessSession(
+      service, service.isThreadSafe() ? nullptr : &serviceMutex, flightIds));
+}
+
+// --- SocketTarget ---
+
+SocketTarget::SocketTarget(std::string path, std::string tcpHost,
+                           int tcpPort)
+    : unixPath(std::move(path)), host(std::move(tcpHost)), port(tcpPort) {}
+
+void SocketTarget::setup(const std::vector<std::string> &flightIds,
+                         int capacity, std::size_t passengers,
+                         std::vector<PassengerIdType> &passengerIds) {
+  LineSocket socket(unixPath, host, port);
+  std::string requests;
+  std::string line;
+  // A flight left over from an earlier run ("exists") is used as is
+  for (std::size_t first = 0; first < flightIds.size();
+       first += SETUP_WINDOW) {
+    const std::size_t last = std::min(first + SETUP_WINDOW, flightIds.size());
+    requests.clear();
+    for (std::size_t i = first; i < last; ++i) {
+      requests += "flight " + flightIds[i] + " Origin Destination " +
+                  std::to_string(capacity) + '\n';
+    }
+    socket.sendAll(requests);
+    for (std::size_t i = first; i < last; ++i) {
+      socket.readLine(line);
+      if (line != "ok" && line != "exists") {
+        throw std::runtime_error("Cannot add flight " + flightIds[i] + ": " +
+                                 line);
+      }
+    }
+  }
+  passengerIds.reserve(passengerIds.size() + passengers);
+  for (std::size_t first = 0; first < passengers; first += SETUP_WINDOW) {
+    const std::size_t last = std::min(first + SETUP_WINDOW, passengers);
+    requests.clear();
+    for (std::size_t i = first; i < last; ++i) {
+      requests += "passenger Load" + std::to_string(i) + '\n';
+    }
+    socket.sendAll(requests);
+    for (std::size_t i = first; i < last; ++i) {
+      socket.readLine(line);
+      if (line.compare(0, 10, "passenger ") != 0) {
+        throw std::runtime_error("Cannot add a passenger: " + line);
+      }
+      passengerIds.push_back(std::atoi(line.c_str() + 10));
+    }
+  }
+}
+
+std::unique_ptr<LoadSession>
+SocketTarget::connect(const std::vector<std::string> &flightIds) {
+  return std::unique_ptr<LoadSession>(
+      new SocketSession(unixPath, host, port, flightIds));
+}
@@ -0,0 +1,192 @@
+// loadgen/loadgen_main.cpp
+//
+// End-to-end load generator: synthetic traffic against a booking core in
+// process or through the request server.
+// Usage: booking_loadgen [--target=inproc|server] [--engine=sharded|system]
+//                        [--data-dir=DIR] [--server-threads=N]
+//                        [--connect=HOST:PORT] [--unix=PATH] [--pid=PID]
+//                        [--threads=N] [--flights=N] [--capacity=N]
+//                        [--zipf=S] [--steady-ops=N] [--cancel-ratio=R]
+//                        [--burst-ops=N] [--hot-flights=N] [--wave=F]
+//                        [--depth=N] [--seed=N] [--json=FILE]
+// --target=server starts a RequestServer on a Unix socket in this process
+// unless --connect or --unix names a running one (airline_booking --serve);
+// --pid then points the memory report at the server process. --engine
+// picks the core for in-process runs and the started server: the sharded
+// engine (thread-safe, memory only) or BookingSystem (one lock, journaled
+// to --data-dir if given). Ops counts are per client thread.
+#include "LoadGenerator.h"
+#include "booking/BookingSystem.h"
+#include "booking/ShardedBookingEngine.h"
+#include "server/RequestServer.h"
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+int usage(const std::string &arg) {
+  std::cerr << "Unknown or invalid argument: " << arg << "\n";
+  return 2;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  LoadProfile profile;
+  std::string targetName = "inproc";
+  std::string engineName = "sharded";
+  std::string dataDir;
+  std::string connect;
+  std::string unixPath;
+  unsigned serverThreads = 0; // 0: one per client thread (sharded only)
+  int memoryPid = 0;
+  std::string jsonPath = "loadgen_results.json";
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    std::string value = arg.substr(arg.find('=') + 1);
+    const char *number = value.c_str();
+    if (arg.compare(0, 9, "--target=") == 0) {
+      targetName = value;
+    } else if (arg.compare(0, 9, "--engine=") == 0) {
+      engineName = value;
+    } else if (arg.compare(0, 11, "--data-dir=") == 0) {
+      dataDir = value;
+    } else if (arg.compare(0, 17, "--server-threads=") == 0) {
+      serverThreads = static_cast<unsigned>(std::atoi(number));
+    } else if (arg.compare(0, 10, "--connect=") == 0) {
+      connect = value;
+    } else if (arg.compare(0, 7, "--unix=") == 0) {
+      unixPath = value;
+    } else if (arg.compare(0, 6, "--pid=") == 0) {
+      memoryPid = std::atoi(number);
+    } else if (arg.compare(0, 10, "--threads=") == 0) {
+      profile.threads = static_cast<unsigned>(std::atoi(number));
+    } else if (arg.compare(0, 10, "--flights=") == 0) {
+      profile.flights = static_cast<unsigned>(std::atoi(number));
+    } else if (arg.compare(0, 11, "--capacity=") == 0) {
+      profile.capacity = std::atoi(number);
+    } else if (arg.compare(0, 7, "--zipf=") == 0) {
+      profile.zipfExponent = std::atof(number);
+    } else if (arg.compare(0, 13, "--steady-ops=") == 0) {
+      profile.steadyOps = std::strtoull(number, nullptr, 10);
+    } else if (arg.compare(0, 15, "--cancel-ratio=") == 0) {
+      profile.cancelRatio = std::atof(number);
+    } else if (arg.compare(0, 12, "--burst-ops=") == 0) {
+      profile.burstOps = std::strtoull(number, nullptr, 10);
+    } else if (arg.compare(0, 14, "--hot-flights=") == 0) {
+      profile.hotFlights = static_cast<unsigned>(std::atoi(number));
+    } else if (arg.compare(0, 7, "--wave=") == 0) {
+      profile.waveFraction = std::atof(number);
+    } else if (arg.compare(0, 8, "--depth=") == 0) {
+      profile.depth = static_cast<unsigned>(std::atoi(number));
+    } else if (arg.compare(0, 7, "--seed=") == 0) {
+      profile.seed = std::strtoull(number, nullptr, 10);
+    } else if (arg.compare(0, 7, "--json=") == 0) {
+      jsonPath = value;
+    } else {
+      return usage(arg);
+    }
+  }
+  if ((targetName != "inproc" && targetName != "server") ||
+      (engineName != "sharded" && engineName != "system") ||
+      profile.threads == 0 || profile.flights == 0 || profile.depth == 0 ||
+      profile.cancelRatio < 0 || profile.cancelRatio > 1 ||
+      profile.waveFraction < 0 || profile.waveFraction > 1) {
+    return usage(targetName + " / " + engineName + " / profile");
+  }
+
+  try {
+    const bool external = !connect.empty() ||
+                          (targetName == "server" && !unixPath.empty());
+    std::string description;
+    std::unique_ptr<LoadTarget> target;
+    // Only built when this process hosts the core under test
+    std::unique_ptr<ShardedBookingEngine> engine;
+    std::unique_ptr<BookingSystem> system;
+    std::unique_ptr<BookingService> service;
+    if (!external) {
+      if (engineName == "sharded") {
+        engine.reset(new ShardedBookingEngine());
+        service.reset(new ShardedEngineService(*engine));
+      } else {
+        system.reset(new BookingSystem(dataDir));
+        system->setEventSink(nullptr); // No console output per booking
+        service.reset(new BookingSystemService(*system));
+      }
+    }
+
+    std::unique_ptr<RequestServer> server;
+    std::thread serverLoop;
+    if (external) {
+      std::string host;
+      int port = -1;
+      if (!connect.empty()) {
+        std::size_t colon = connect.rfind(':');
+        if (colon == std::string::npos) {
+          return usage("--connect=" + connect);
+        }
+        host = connect.substr(0, colon);
+        port = std::atoi(connect.c_str() + colon + 1);
+        unixPath.clear();
+      }
+      target.reset(new SocketTarget(unixPath, host, port));
+      description = "server " + (connect.empty() ? unixPath : connect);
+    } else if (targetName == "server") {
+      ServerOptions options;
+      options.unixPath =
+          "/tmp/booking_loadgen_" + std::to_string(::getpid()) + ".sock";
+      options.threads = serverThreads != 0 ? serverThreads
+                        : service->isThreadSafe() ? profile.threads
+                                                  : 1;
+      server.reset(new RequestServer(*service, options));
+      RequestServer *running = server.get();
+      serverLoop = std::thread([running] { running->run(); });
+      target.reset(new SocketTarget(options.unixPath, "", -1));
+      description = "server " + engineName + " (" +
+                    std::to_string(options.threads) + " loops)";
+    } else {
+      target.reset(new InProcessTarget(*service));
+      description = "inproc " + engineName;
+    }
+
+    std::cout << "Load on " << description << ": " << profile.threads
+              << " clients, depth " << profile.depth << "\n";
+    LoadReport report;
+    try {
+      report = runLoad(*target, profile);
+    } catch (...) {
+      if (server) {
+        server->stop();
+        serverLoop.join();
+      }
+      throw;
+    }
+    if (server) {
+      server->stop();
+      serverLoop.join();
+    }
+
+    printReport(report);
+    std::uint64_t rssKb = 0;
+    std::uint64_t peakKb = 0;
+    if (readMemoryUsage(memoryPid, rssKb, peakKb)) {
+      std::cout << "Memory" << (memoryPid != 0 ? " of the server" : "")
+                << ": RSS " << rssKb << " KiB, peak " << peakKb << " KiB\n";
+    }
+    if (!writeJson(report, profile, description, memoryPid, jsonPath)) {
+      std::cerr << "Could not write " << jsonPath << "\n";
+      return 1;
+    }
+    std::cout << "Results written to " << jsonPath << "\n";
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
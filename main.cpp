@@ -1,11 +1,145 @@
 #include "booking/BookingSystem.h" // Include the main system class header
+#include "booking/ShardedBookingEngine.h"
+#include "server/RequestServer.h"
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
 
-int main() {
-  // Create the booking system object (loads sample data in constructor)
-  BookingSystem airlineSystem;
+// Usage: airline_booking [data-dir]
+//        airline_booking --serve [--host ADDR] [--port N] [--unix PATH]
+//                        [--threads N] [data-dir]
+// Without a data directory nothing is persisted and the sample data is
+// loaded on every start. --serve runs the request server (protocol in
+// server/RequestServer.h) instead of the menu, until SIGINT or SIGTERM.
+// With more than one thread it serves an in-memory ShardedBookingEngine
+// that starts empty, so it takes no data directory.
 
-  // Run the main application loop (TUI)
-  airlineSystem.run();
+namespace {
+
+RequestServer *runningServer = nullptr;
+
+// Far more event loops than cores only adds contention
+const long MAX_SERVER_THREADS = 1024;
+
+extern "C" void stopServer(int) {
+  if (runningServer != nullptr) {
+    runningServer->stop();
+  }
+}
+
+int usage() {
+  std::cerr << "Usage: airline_booking [data-dir]\n"
+               "       airline_booking --serve [--host ADDR] [--port N] "
+               "[--unix PATH] [--threads N] [data-dir]\n";
+  return 2;
+}
+
+// Whole-string decimal in [min, max]; reports a bad value like a bad option
+bool parseOption(const char *option, const char *text, long min, long max,
+                 long &value) {
+  char *end = nullptr;
+  errno = 0;
+  value = std::strtol(text, &end, 10);
+  if (end == text || *end != '\0' || errno == ERANGE || value < min ||
+      value > max) {
+    std::cerr << "Invalid value for " << option << ": '" << text
+              << "' (expected " << min << " to " << max << ")\n";
+    return false;
+  }
+  return true;
+}
+
+void serve(BookingService &service, const ServerOptions &options) {
+  RequestServer server(service, options);
+  runningServer = &server;
+  std::signal(SIGINT, stopServer);
+  std::signal(SIGTERM, stopServer);
+  if (server.getPort() >= 0) {
+    std::cout << "Listening on " << options.host << ':' << server.getPort()
+              << '\n';
+  }
+  if (!options.unixPath.empty()) {
+    std::cout << "Listening on " << options.unixPath << '\n';
+  }
+  std::cout.flush();
+  server.run();
+  runningServer = nullptr;
+}
+
+int serveMain(int argc, char *argv[]) {
+  ServerOptions options;
+  std::string dataDir;
+  for (int i = 2; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    long number = 0;
+    if (std::strcmp(argv[i], "--host") == 0 && hasValue) {
+      options.host = argv[++i];
+    } else if (std::strcmp(argv[i], "--port") == 0 && hasValue) {
+      if (!parseOption("--port", argv[++i], 0, 65535, number)) {
+        return usage();
+      }
+      options.port = static_cast<int>(number);
+    } else if (std::strcmp(argv[i], "--unix") == 0 && hasValue) {
+      options.unixPath = argv[++i];
+    } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+      if (!parseOption("--threads", argv[++i], 1, MAX_SERVER_THREADS,
+                       number)) {
+        return usage();
+      }
+      options.threads = static_cast<unsigned>(number);
+    } else if (argv[i][0] != '-' && dataDir.empty()) {
+      dataDir = argv[i];
+    } else {
+      return usage();
+    }
+  }
+  if (options.port < 0 && options.unixPath.empty()) {
+    options.port = 7070;
+  }
+
+  if (options.threads > 1) {
+    if (!dataDir.empty()) {
+      std::cerr << "Error: --threads above 1 serves memory only, without a "
+                   "data directory\n";
+      return 2;
+    }
+    ShardedBookingEngine engine;
+    ShardedEngineService service(engine);
+    serve(service, options);
+    return 0;
+  }
+  BookingSystem system(dataDir);
+  system.setEventSink(nullptr); // No console output per booking
+  BookingSystemService service(system);
+  serve(service, options);
+  system.checkpoint(); // Next start loads the snapshot, nothing to replay
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  try {
+    if (argc > 1 && std::strcmp(argv[1], "--serve") == 0) {
+      return serveMain(argc, argv);
+    }
+    if (argc > 2) {
+      return usage();
+    }
+    // Create the booking system object (loads sample data or recovers the
+    // saved state in the constructor)
+    BookingSystem airlineSystem(argc > 1 ? argv[1] : "");
+
+    // Run the main application loop (TUI)
+    airlineSystem.run();
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << '\n';
+    return 1;
+  }
 
   return 0;
 }
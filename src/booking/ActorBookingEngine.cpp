@@ -0,0 +1,142 @@
+// src/booking/ActorBookingEngine.cpp
+#include "booking/ActorBookingEngine.h"
+#include "booking/FlightIndex.h" // For FlightIndex::hashId
+#include <thread>
+#include <utility>
+
+// --- Private Helper Method Implementations ---
+
+FlightActor &ActorBookingEngine::actorFor(const std::string &flightId) const {
+  // Same high-bit partitioning as ShardedBookingEngine
+  std::uint64_t hash = FlightIndex::hashId(flightId);
+  return *actors[static_cast<std::size_t>((hash * actors.size()) >> 32)];
+}
+
+std::future<BookingResult>
+ActorBookingEngine::rejected(BookingResult result) const {
+  std::promise<BookingResult> promise;
+  promise.set_value(result);
+  return promise.get_future();
+}
+
+BookingCommand *ActorBookingEngine::makeCommand(BookingCommand::Kind kind,
+                                                PassengerIdType passengerId,
+                                                const std::string &flightId) {
+  BookingCommand *command = new BookingCommand(kind);
+  command->passengerId = passengerId;
+  command->flightId = flightId;
+  if (kind == BookingCommand::Kind::Book) {
+    command->priority =
+        nextBookingPriority.fetch_add(1, std::memory_order_relaxed);
+  }
+  return command;
+}
+
+// --- Constructor / Destructor ---
+
+ActorBookingEngine::ActorBookingEngine(unsigned actorCount,
+                                       BookingEventSink *sink)
+    : nextBookingPriority(1) {
+  if (actorCount == 0) {
+    actorCount = std::thread::hardware_concurrency();
+    if (actorCount == 0) {
+      actorCount = 1; // Unknown
+    }
+  }
+  actors.reserve(actorCount);
+  for (unsigned i = 0; i < actorCount; ++i) {
+    actors.push_back(std::unique_ptr<FlightActor>(new FlightActor(sink)));
+  }
+}
+
+ActorBookingEngine::~ActorBookingEngine() {
+  actors.clear(); // Each actor drains its mailbox, then joins
+}
+
+// --- Concurrent Operations ---
+
+bool ActorBookingEngine::addFlight(const std::string &flightId,
+                                   const std::string &origin,
+                                   const std::string &destination,
+                                   int capacity,
+                                   WaitlistBackend waitlistBackend) {
+  // Built before the command: the constructor throws for over-long codes
+  std::unique_ptr<Flight> flight(
+      new Flight(flightId, origin, destination, capacity, waitlistBackend));
+  BookingCommand *command = makeCommand(BookingCommand::Kind::AddFlight,
+                                        INVALID_PASSENGER_ID, flightId);
+  command->newFlight = std::move(flight);
+  std::promise<bool> done;
+  std::future<bool> added = done.get_future();
+  command->done = &done;
+  actorFor(flightId).post(command);
+  return added.get();
+}
+
+PassengerIdType ActorBookingEngine::addPassenger(const std::string &name) {
+  return passengers.add(name);
+}
+
+bool ActorBookingEngine::hasPassenger(PassengerIdType passengerId) const {
+  return passengers.contains(passengerId);
+}
+
+std::string
+ActorBookingEngine::getPassengerName(PassengerIdType passengerId) const {
+  return passengers.getName(passengerId);
+}
+
+std::future<BookingResult>
+ActorBookingEngine::book(PassengerIdType passengerId,
+                         const std::string &flightId) {
+  if (!passengers.contains(passengerId)) {
+    return rejected(BookingResult::UnknownPassenger);
+  }
+  BookingCommand *command =
+      makeCommand(BookingCommand::Kind::Book, passengerId, flightId);
+  std::future<BookingResult> result = command->result.get_future();
+  actorFor(flightId).post(command);
+  return result;
+}
+
+std::future<BookingResult>
+ActorBookingEngine::cancel(PassengerIdType passengerId,
+                           const std::string &flightId) {
+  if (!passengers.contains(passengerId)) {
+    return rejected(BookingResult::UnknownPassenger);
+  }
+  BookingCommand *command =
+      makeCommand(BookingCommand::Kind::Cancel, passengerId, flightId);
+  std::future<BookingResult> result = command->result.get_future();
+  actorFor(flightId).post(command);
+  return result;
+}
+
+void ActorBookingEngine::book(PassengerIdType passengerId,
+                              const std::string &flightId, Callback onDone) {
+  if (!passengers.contains(passengerId)) {
+    onDone(BookingResult::UnknownPassenger);
+    return;
+  }
+  BookingCommand *command =
+      makeCommand(BookingCommand::Kind::Book, passengerId, flightId);
+  command->callback = std::move(onDone);
+  actorFor(flightId).post(command);
+}
+
+void ActorBookingEngine::cancel(PassengerIdType passengerId,
+                                const std::string &flightId,
+                                Callback onDone) {
+  if (!passengers.contains(passengerId)) {
+    onDone(BookingResult::UnknownPassenger);
+    return;
+  }
+  BookingCommand *command =
+      makeCommand(BookingCommand::Kind::Cancel, passengerId, flightId);
+  command->callback = std::move(onDone);
+  actorFor(flightId).post(command);
+}
+
+unsigned ActorBookingEngine::getActorCount() const {
+  return static_cast<unsigned>(actors.size());
+}
@@ -0,0 +1,125 @@
+#include "booking/BookingEvents.h"
+#include "booking/Flight.h"
+#include <algorithm> // For std::find
+#include <ostream>
+#include <stdexcept>
+
+const std::size_t ItineraryResult::NO_LEG;
+
+void requireDistinctLegs(const std::vector<std::string> &flightIds) {
+  if (flightIds.empty()) {
+    throw std::invalid_argument("Itinerary has no flights");
+  }
+  for (std::size_t leg = 1; leg < flightIds.size(); ++leg) {
+    if (std::find(flightIds.begin(), flightIds.begin() + leg,
+                  flightIds[leg]) != flightIds.begin() + leg) {
+      throw std::invalid_argument("Itinerary lists flight '" +
+                                  flightIds[leg] + "' twice");
+    }
+  }
+}
+
+const char *toString(BookingResult result) {
+  switch (result) {
+  case BookingResult::Confirmed:
+    return "confirmed";
+  case BookingResult::Waitlisted:
+    return "waitlisted";
+  case BookingResult::AlreadyConfirmed:
+    return "already_confirmed";
+  case BookingResult::AlreadyWaitlisted:
+    return "already_waitlisted";
+  case BookingResult::Cancelled:
+    return "cancelled";
+  case BookingResult::RemovedFromWaitlist:
+    return "removed_from_waitlist";
+  case BookingResult::NotBooked:
+    return "not_booked";
+  case BookingResult::UnknownFlight:
+    return "unknown_flight";
+  case BookingResult::UnknownPassenger:
+    return "unknown_passenger";
+  case BookingResult::SoldOut:
+    return "sold_out";
+  case BookingResult::Held:
+    return "held";
+  case BookingResult::HoldReleased:
+    return "hold_released";
+  case BookingResult::NotHeld:
+    return "not_held";
+  case BookingResult::AlreadyHeld:
+    return "already_held";
+  }
+  return "unknown";
+}
+
+ConsoleEventSink::ConsoleEventSink(std::ostream &os) : out(os) {}
+
+void ConsoleEventSink::onEvent(const BookingEvent &event) {
+  const FlightCode &flightId = event.flight->getFlightId();
+  switch (event.type) {
+  case BookingEventType::Confirmed:
+    out << "Booking confirmed for Passenger " << event.passengerId
+        << " on flight " << flightId << ".\n";
+    break;
+  case BookingEventType::Waitlisted:
+    out << "Flight " << flightId << " is full. Passenger " << event.passengerId
+        << " added to waitlist (Priority: " << event.priority << ").\n";
+    break;
+  case BookingEventType::Promoted:
+    out << "Passenger " << event.passengerId
+        << " moved from waitlist to confirmed seat on flight " << flightId
+        << ".\n";
+    break;
+  case BookingEventType::Cancelled:
+    out << "Booking cancelled for Passenger " << event.passengerId
+        << " on flight " << flightId << ".\n";
+    break;
+  case BookingEventType::RemovedFromWaitlist:
+    out << "Passenger " << event.passengerId
+        << " removed from the waitlist for flight " << flightId << ".\n";
+    break;
+  case BookingEventType::AlreadyConfirmed:
+    out << "Passenger " << event.passengerId
+        << " is already confirmed on flight " << flightId << ".\n";
+    break;
+  case BookingEventType::AlreadyWaitlisted:
+    out << "Passenger " << event.passengerId
+        << " is already on the waitlist for flight " << flightId << ".\n";
+    break;
+  case BookingEventType::NotBooked:
+    out << "Passenger " << event.passengerId
+        << " not found in confirmed bookings or waitlist for flight "
+        << flightId << ".\n";
+    break;
+  case BookingEventType::PriorityUpgraded:
+    out << "Passenger " << event.passengerId
+        << " moved up the waitlist for flight " << flightId
+        << " (Priority: " << event.priority << ").\n";
+    break;
+  case BookingEventType::Held:
+    out << "Seat held for Passenger " << event.passengerId << " on flight "
+        << flightId << ".\n";
+    break;
+  case BookingEventType::HoldConfirmed:
+    out << "Held seat confirmed for Passenger " << event.passengerId
+        << " on flight " << flightId << ".\n";
+    break;
+  case BookingEventType::HoldReleased:
+    out << "Held seat released for Passenger " << event.passengerId
+        << " on flight " << flightId << ".\n";
+    break;
+  case BookingEventType::AlreadyHeld:
+    out << "Passenger " << event.passengerId
+        << " is already holding a seat on flight " << flightId << ".\n";
+    break;
+  case BookingEventType::NotHeld:
+    out << "Passenger " << event.passengerId
+        << " holds no seat on flight " << flightId << ".\n";
+    break;
+  case BookingEventType::SoldOut:
+    out << "Flight " << flightId << " has no seat to hold for Passenger "
+        << event.passengerId << ".\n";
+    break;
+  }
+}
@@ -1,6 +1,10 @@
 #include "booking/BookingSystem.h"
 #include "booking/Flight.h" // Include full definitions now
-#include "core/Passenger.h" // Include full definitions now
+#include "core/PassengerTable.h" // Include full definitions now
+#include "metrics/Metrics.h"
+#include "storage/FileHandle.h"  // For makeDirectory
+#include "storage/Snapshot.h"
+#include <algorithm>        // For std::stable_sort, std::max
 #include <cstdlib>          // For system()
 #include <iomanip>          // For std::setw, std::left
 #include <iostream>
@@ -8,8 +12,373 @@
 #include <stdexcept> // For error handling (optional)
 
 // --- Constructor ---
-BookingSystem::BookingSystem() : nextPassengerId(1), nextBookingPriority(1) {
-  loadSampleData();
+BookingSystem::BookingSystem(const std::string &directory)
+    : nextBookingPriority(1), consoleSink(std::cout), eventSink(nullptr),
+      muted(false), routesBuilt(false), dataDir(directory), journalSink(*this),
+      checkpointLsn(0), checkpointInterval(DEFAULT_CHECKPOINT_INTERVAL) {
+  if (dataDir.empty()) {
+    loadSampleData(); // Silent: flights have no sink yet
+  } else {
+    recover();
+  }
+  setEventSink(&consoleSink);
+}
+
+void BookingSystem::setEventSink(BookingEventSink *sink) {
+  eventSink = sink;
+  for (Flight &flight : flights) {
+    flight.setEventSink(flightSink());
+  }
+}
+
+// --- Flight Lookup ---
+
+FlightHandle BookingSystem::resolveFlight(StringRef flightId) {
+  METRIC_TIMER(timer, LatencyMetric::FlightLookup);
+  FlightHandle handle = flights.find(flightId);
+  if (handle != INVALID_FLIGHT_HANDLE) {
+    return handle;
+  }
+  std::uint32_t index = baseline.find(flightId);
+  if (index == MappedSnapshot::NOT_FOUND) {
+    return INVALID_FLIGHT_HANDLE;
+  }
+  // First touch: build the mutable flight from its snapshot record
+  handle = flights.insert(baseline.materialize(index)).first;
+  flights.get(handle).setEventSink(flightSink());
+  if (routesBuilt) {
+    routeKeys.resize(handle + 1, RouteIndex::INVALID_KEY);
+    routeKeys[handle] = index; // Same seats as the record
+  }
+  return handle;
+}
+
+Flight *BookingSystem::findFlight(const std::string &flightId) {
+  FlightHandle handle = resolveFlight(flightId);
+  return handle == INVALID_FLIGHT_HANDLE ? nullptr : &flights.get(handle);
+}
+
+bool BookingSystem::hasFlight(const std::string &flightId) const {
+  return flights.find(flightId) != INVALID_FLIGHT_HANDLE ||
+         baseline.find(flightId) != MappedSnapshot::NOT_FOUND;
+}
+
+// --- Route Search ---
+
+void BookingSystem::buildRoutes() {
+  routes.clear();
+  routes.reserve(baseline.getFlightCount() + flights.size());
+  routeKeys.assign(flights.size(), RouteIndex::INVALID_KEY);
+  // Snapshot records first, so record i gets key i
+  for (std::size_t i = 0; i < baseline.getFlightCount(); ++i) {
+    SnapshotFlightView view = baseline.getFlight(static_cast<std::uint32_t>(i));
+    StringRef id(view.id, view.idLength);
+    int seats = view.capacity - static_cast<int>(view.seatCount);
+    FlightHandle live = flights.find(id);
+    if (live != INVALID_FLIGHT_HANDLE) {
+      const Flight &flight = flights.get(live);
+      seats = flight.getCapacity() - flight.getBookedCount() -
+              flight.getHeldCount();
+      routeKeys[live] = static_cast<RouteIndex::Key>(i);
+    }
+    routes.add(id, StringRef(view.origin, view.originLength),
+               StringRef(view.destination, view.destinationLength), seats);
+  }
+  routesBuilt = true;
+  for (FlightHandle handle = 0; handle < flights.size(); ++handle) {
+    if (routeKeys[handle] == RouteIndex::INVALID_KEY) {
+      indexRoute(handle);
+    }
+  }
+}
+
+void BookingSystem::indexRoute(FlightHandle handle) {
+  if (!routesBuilt) {
+    return;
+  }
+  const Flight &flight = flights.get(handle);
+  if (routeKeys.size() <= handle) {
+    routeKeys.resize(handle + 1, RouteIndex::INVALID_KEY);
+  }
+  routeKeys[handle] =
+      routes.add(flight.getFlightId(), flight.getOrigin(),
+                 flight.getDestination(),
+                 flight.getCapacity() - flight.getBookedCount() -
+                     flight.getHeldCount());
+}
+
+void BookingSystem::noteSeatChange(const BookingEvent &event) {
+  int delta = 0;
+  switch (event.type) {
+  case BookingEventType::Confirmed:
+  case BookingEventType::Promoted:
+  case BookingEventType::Held:
+    delta = -1;
+    break;
+  case BookingEventType::Cancelled:
+  case BookingEventType::HoldReleased:
+    delta = 1;
+    break;
+  default:
+    return; // Waitlist changes and confirmed holds leave the seats alone
+  }
+  FlightHandle handle = flights.find(event.flight->getFlightId());
+  routes.adjustSeats(routeKeys[handle], delta);
+}
+
+std::size_t
+BookingSystem::findAvailableFlights(const std::string &origin,
+                                    const std::string &destination,
+                                    std::vector<RouteAvailability> &results) {
+  if (!routesBuilt) {
+    buildRoutes();
+  }
+  return routes.findAvailable(origin, destination, results);
+}
+
+std::size_t BookingSystem::getFlightCount() const {
+  std::size_t count = baseline.getFlightCount();
+  for (const Flight &flight : flights) {
+    if (baseline.find(flight.getFlightId()) == MappedSnapshot::NOT_FOUND) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+bool BookingSystem::queryFlight(const std::string &flightId,
+                                FlightStatus &status) const {
+  FlightHandle handle = flights.find(flightId);
+  if (handle != INVALID_FLIGHT_HANDLE) {
+    status = FlightStatus(flights.get(handle));
+    return true;
+  }
+  std::uint32_t index = baseline.find(flightId);
+  if (index == MappedSnapshot::NOT_FOUND) {
+    return false;
+  }
+  SnapshotFlightView view = baseline.getFlight(index);
+  status.flightId.assign(view.id, view.idLength);
+  status.origin.assign(view.origin, view.originLength);
+  status.destination.assign(view.destination, view.destinationLength);
+  status.capacity = view.capacity;
+  status.booked = static_cast<int>(view.seatCount);
+  status.waitlisted = static_cast<int>(view.waitlistCount);
+  status.held = 0; // A flight with holds is always live
+  return true;
+}
+
+// --- Persistence ---
+
+BookingEventSink *BookingSystem::flightSink() { return &journalSink; }
+
+void BookingSystem::JournalSink::onEvent(const BookingEvent &event) {
+  owner.journalEvent(event);
+}
+
+void BookingSystem::journalEvent(const BookingEvent &event) {
+  if (routesBuilt) {
+    noteSeatChange(event); // Also for imports, which are muted
+  }
+  if (muted || !journal.isOpen()) {
+    if (!muted && eventSink != nullptr) {
+      eventSink->onEvent(event);
+    }
+    return;
+  }
+  // Only changes are journaled; duplicates and misses are not
+  WalRecord::Type type = WalRecord::Type::Booked;
+  bool changed = true;
+  switch (event.type) {
+  case BookingEventType::Confirmed:
+  case BookingEventType::Waitlisted:
+    type = WalRecord::Type::Booked;
+    break;
+  case BookingEventType::Cancelled:
+  case BookingEventType::RemovedFromWaitlist:
+    type = WalRecord::Type::Cancelled;
+    break;
+  case BookingEventType::Promoted:
+    type = WalRecord::Type::Promoted;
+    break;
+  case BookingEventType::PriorityUpgraded:
+    type = WalRecord::Type::Upgraded;
+    break;
+  case BookingEventType::Held:
+    type = WalRecord::Type::Held;
+    break;
+  case BookingEventType::HoldConfirmed:
+    type = WalRecord::Type::HoldConfirmed;
+    break;
+  case BookingEventType::HoldReleased:
+    type = WalRecord::Type::HoldReleased;
+    break;
+  default:
+    changed = false;
+    break;
+  }
+  if (changed) {
+    journal.logBooking(type, event.flight->getFlightId(), event.passengerId,
+                       event.priority);
+  }
+  if (eventSink != nullptr) {
+    eventSink->onEvent(event);
+  }
+}
+
+void BookingSystem::recover() {
+  makeDirectory(dataDir);
+  SnapshotInfo info;
+  // Mapped, not loaded: flights stay in the file until first changed
+  const bool restored = baseline.open(dataDir + "/bookings.snap");
+  if (restored) {
+    info.lsn = baseline.getLsn();
+    nextBookingPriority = baseline.getNextBookingPriority();
+    passengers.assign(baseline.getFirstPassengerId(),
+                      baseline.getNameOffsets(), baseline.getPassengerCount(),
+                      baseline.getNames());
+  }
+  // Muted, so replayed changes are not journaled a second time
+  muted = true;
+  std::size_t replayed = journal.open(
+      dataDir + "/bookings.wal", info.lsn,
+      [this](const WalRecord &record) { applyJournalRecord(record); });
+  muted = false;
+  checkpointLsn = info.lsn;
+  // Hold deadlines do not survive a restart; whoever was paying has to
+  // start over, and the seats go to the waitlists now
+  releaseAllHolds();
+
+  if (!restored && replayed == 0) {
+    loadSampleData();
+    checkpoint(); // The seed data becomes the first snapshot
+  } else {
+    std::cout << "\nRecovered " << getFlightCount() << " flights and "
+              << passengers.size() << " passengers from " << dataDir << " ("
+              << replayed << " journal records replayed).\n";
+  }
+}
+
+void BookingSystem::applyJournalRecord(const WalRecord &record) {
+  if (record.type == WalRecord::Type::AddPassenger) {
+    if (record.passengerId != passengers.nextId()) {
+      throw std::runtime_error("Journal passenger IDs out of sequence in " +
+                               dataDir);
+    }
+    passengers.add(record.name);
+    return;
+  }
+  if (record.type == WalRecord::Type::AddFlight) {
+    // addFlight() never journals these; the Flight constructor would throw
+    if (!FlightCode::fits(record.flightId) || !FlightCode::fits(record.name) ||
+        !FlightCode::fits(record.destination)) {
+      throw std::runtime_error("Corrupt journal record for flight '" +
+                               record.flightId + "' in " + dataDir);
+    }
+    std::pair<FlightHandle, bool> inserted =
+        flights.insert(Flight(record.flightId, record.name,
+                              record.destination, record.capacity,
+                              record.backend));
+    if (inserted.second) {
+      indexRoute(inserted.first);
+    }
+    return;
+  }
+
+  FlightHandle handle = resolveFlight(record.flightId);
+  if (handle == INVALID_FLIGHT_HANDLE) {
+    return; // The flight never made it into this state
+  }
+  Flight *flight = &flights.get(handle);
+  switch (record.type) {
+  case WalRecord::Type::Booked:
+    flight->book(record.passengerId, record.priority);
+    nextBookingPriority = std::max(nextBookingPriority,
+                                   prioritySequence(record.priority) + 1);
+    break;
+  case WalRecord::Type::Cancelled:
+    flight->cancel(record.passengerId); // Re-derives the promotion
+    break;
+  case WalRecord::Type::Upgraded:
+    flight->upgradeWaitlistPriority(record.passengerId, record.priority);
+    break;
+  case WalRecord::Type::Held:
+    // Already held if the record was logged again before a checkpoint
+    if (flight->holdSeat(record.passengerId) == BookingResult::Held) {
+      holds.add(handle, record.passengerId, SeatHolds::Clock::now());
+    }
+    break;
+  case WalRecord::Type::HoldConfirmed:
+    flight->confirmHold(record.passengerId);
+    holds.remove(handle, record.passengerId);
+    break;
+  case WalRecord::Type::HoldReleased:
+    flight->releaseHold(record.passengerId); // Re-derives the promotion
+    holds.remove(handle, record.passengerId);
+    break;
+  default:
+    break; // Promoted: already applied by the record before it
+  }
+}
+
+void BookingSystem::journalHolds() {
+  holds.forEach([this](std::uint64_t handle, PassengerIdType passengerId) {
+    journal.logBooking(WalRecord::Type::Held,
+                       flights.get(static_cast<FlightHandle>(handle))
+                           .getFlightId(),
+                       passengerId, MAX_PRIORITY);
+  });
+}
+
+void BookingSystem::releaseAllHolds() {
+  std::vector<std::pair<std::uint64_t, PassengerIdType>> held;
+  held.reserve(holds.size());
+  holds.forEach([&held](std::uint64_t handle, PassengerIdType passengerId) {
+    held.emplace_back(handle, passengerId);
+  });
+  for (const auto &hold : held) {
+    holds.remove(hold.first, hold.second);
+    flights.get(static_cast<FlightHandle>(hold.first))
+        .releaseHold(hold.second);
+  }
+}
+
+void BookingSystem::syncJournal() { journal.commit(); }
+
+void BookingSystem::checkpoint() {
+  if (!journal.isOpen()) {
+    return;
+  }
+  journal.commit();
+  SnapshotInfo info;
+  info.lsn = journal.lastLsn();
+  info.nextBookingPriority = nextBookingPriority;
+  // The snapshot leaves held seats free, so the holds must stay in the
+  // journal: logged past info.lsn before the snapshot is written (replayed
+  // should the reset below never happen), and again into the emptied file
+  journalHolds();
+  journal.commit();
+  // Untouched flights are copied from the mapping. It stays valid after
+  // the rename (the old inode lives on until unmapped) and still matches.
+  writeSnapshot(dataDir + "/bookings.snap", info, passengers, flights,
+                &baseline);
+  journal.reset(); // Only once the snapshot is durable
+  journalHolds();
+  journal.commit(); // No-op without holds
+  checkpointLsn = journal.lastLsn();
+}
+
+void BookingSystem::setCheckpointInterval(std::uint64_t records) {
+  checkpointInterval = records;
+}
+
+// Called between operations, never in the middle of one, so a snapshot
+// cannot split a cancellation from the promotion it causes
+void BookingSystem::maybeCheckpoint() {
+  if (journal.isOpen() &&
+      journal.lastLsn() - checkpointLsn >= checkpointInterval) {
+    checkpoint();
+  }
 }
 
 // --- Private TUI Helper Method Implementations ---
@@ -18,12 +387,13 @@ void BookingSystem::clearScreen() {
 #ifdef _WIN32
   system("cls");
 #else
-  // Assume POSIX
-  system("clear");
+  // ANSI clear + home: no shell is forked on every menu redraw
+  std::cout << "\033[2J\033[H" << std::flush;
 #endif
 }
 
 void BookingSystem::pressEnterToContinue() {
+  syncJournal(); // Whatever the screen just confirmed is now durable
   std::cout << "\nPress Enter to continue...";
   // Clear the input buffer before waiting
   std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -42,15 +412,25 @@ void BookingSystem::displayMainMenu() {
   std::cout << "4. Book Ticket\n";
   std::cout << "5. Cancel Booking\n";
   std::cout << "6. Add New Flight (Admin)\n";
+  std::cout << "7. Import Schedule / Manifest (Admin)\n";
+  std::cout << "8. Search Flights With Free Seats\n";
   std::cout << "0. Exit\n";
   std::cout << "----------------------------------------\n";
   std::cout << "Enter your choice: ";
 }
 
+void BookingSystem::printFlightRow(const Flight &f) {
+  std::cout << std::left << std::setw(10) << f.getFlightId() << std::setw(15)
+            << f.getOrigin() << std::setw(15) << f.getDestination()
+            << std::setw(10) << f.getBookedCount() << std::setw(10)
+            << f.getCapacity() << std::setw(10) << f.getWaitlistCount()
+            << std::endl;
+}
+
 void BookingSystem::listAllFlights() {
   clearScreen();
   std::cout << "--- Available Flights ---\n";
-  if (flights.empty()) {
+  if (getFlightCount() == 0) {
     std::cout << "No flights available.\n";
   } else {
     std::cout << std::left << std::setw(10) << "Flight ID" << std::setw(15)
@@ -59,13 +439,29 @@ void BookingSystem::listAllFlights() {
               << "Waitlist" << std::endl;
     std::cout << std::setw(70) << std::setfill('-') << "" << std::setfill(' ')
               << std::endl; // Divider line
-    for (const auto &pair : flights) {
-      const Flight &f = pair.second;
-      std::cout << std::left << std::setw(10) << f.getFlightId()
-                << std::setw(15) << f.getOrigin() << std::setw(15)
-                << f.getDestination() << std::setw(10) << f.getBookedCount()
-                << std::setw(10) << f.getCapacity() << std::setw(10)
-                << f.getWaitlistCount() << std::endl;
+    // Snapshot flights in snapshot order (live copy if touched), then
+    // the flights added since
+    for (std::size_t i = 0; i < baseline.getFlightCount(); ++i) {
+      SnapshotFlightView view =
+          baseline.getFlight(static_cast<std::uint32_t>(i));
+      FlightHandle live = flights.find(StringRef(view.id, view.idLength));
+      if (live != INVALID_FLIGHT_HANDLE) {
+        printFlightRow(flights.get(live));
+        continue;
+      }
+      std::cout << std::left << std::setw(10)
+                << std::string(view.id, view.idLength) << std::setw(15)
+                << std::string(view.origin, view.originLength)
+                << std::setw(15)
+                << std::string(view.destination, view.destinationLength)
+                << std::setw(10) << view.seatCount << std::setw(10)
+                << view.capacity << std::setw(10) << view.waitlistCount
+                << std::endl;
+    }
+    for (const Flight &f : flights) {
+      if (baseline.find(f.getFlightId()) == MappedSnapshot::NOT_FOUND) {
+        printFlightRow(f);
+      }
     }
   }
   pressEnterToContinue();
@@ -80,10 +476,10 @@ void BookingSystem::viewFlightDetails() {
   // Clear buffer after reading string/number before potential getline
   std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
-  auto it = flights.find(flightId);
-  if (it != flights.end()) {
-    // Pass the passenger map to the display function
-    it->second.displayStatus(passengers);
+  const Flight *flight = findFlight(flightId);
+  if (flight != nullptr) {
+    // Pass the passenger table to the display function
+    flight->displayStatus(passengers);
   } else {
     std::cout << "Flight ID '" << flightId << "' not found.\n";
   }
@@ -101,8 +497,7 @@ void BookingSystem::addNewPassenger() {
   if (name.empty()) {
     std::cout << "Passenger name cannot be empty.\n";
   } else {
-    PassengerIdType newId = nextPassengerId++;
-    passengers.emplace(newId, Passenger(newId, name));
+    PassengerIdType newId = addPassenger(name);
     std::cout << "Passenger '" << name << "' added with ID: " << newId
               << std::endl;
   }
@@ -117,7 +512,7 @@ void BookingSystem::bookTicket() {
 
   std::cout << "Enter Passenger ID: ";
   while (!(std::cin >> passengerId) ||
-         passengers.find(passengerId) == passengers.end()) {
+         !passengers.contains(passengerId)) {
     std::cout << "Invalid or unknown Passenger ID. Please try again: ";
     std::cin.clear();
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -130,13 +525,13 @@ void BookingSystem::bookTicket() {
   std::cin.ignore(std::numeric_limits<std::streamsize>::max(),
                   '\n'); // Consume newline
 
-  auto flightIt = flights.find(flightId);
-  if (flightIt == flights.end()) {
+  Flight *flight = findFlight(flightId);
+  if (flight == nullptr) {
     std::cout << "Flight ID '" << flightId << "' not found.\n";
   } else {
     // Assign priority based on booking sequence
     PriorityType currentPriority = nextBookingPriority++;
-    flightIt->second.addPassenger(passengerId, currentPriority);
+    flight->addPassenger(passengerId, currentPriority);
   }
   pressEnterToContinue();
 }
@@ -149,7 +544,7 @@ void BookingSystem::cancelBooking() {
 
   std::cout << "Enter Passenger ID to cancel booking for: ";
   while (!(std::cin >> passengerId) ||
-         passengers.find(passengerId) == passengers.end()) {
+         !passengers.contains(passengerId)) {
     std::cout << "Invalid or unknown Passenger ID. Please try again: ";
     std::cin.clear();
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -162,11 +557,11 @@ void BookingSystem::cancelBooking() {
   std::cin.ignore(std::numeric_limits<std::streamsize>::max(),
                   '\n'); // Consume newline
 
-  auto flightIt = flights.find(flightId);
-  if (flightIt == flights.end()) {
+  Flight *flight = findFlight(flightId);
+  if (flight == nullptr) {
     std::cout << "Flight ID '" << flightId << "' not found.\n";
   } else {
-    flightIt->second.cancelBooking(passengerId);
+    flight->cancelBooking(passengerId);
   }
   pressEnterToContinue();
 }
@@ -182,17 +577,29 @@ void BookingSystem::addNewFlight() {
   std::cin.ignore(std::numeric_limits<std::streamsize>::max(),
                   '\n'); // Consume newline
                          // Check if ID already exists
-  if (flights.count(id)) {
+  if (hasFlight(id)) {
     std::cout << "Flight ID '" << id << "' already exists.\n";
     pressEnterToContinue();
     return;
   }
+  if (!FlightCode::fits(id)) {
+    std::cout << "Flight ID is longer than " << FlightCode::MAX_LENGTH
+              << " characters.\n";
+    pressEnterToContinue();
+    return;
+  }
 
   std::cout << "Enter Origin: ";
   std::getline(std::cin,
                origin); // Use getline for potentially multi-word names
   std::cout << "Enter Destination: ";
   std::getline(std::cin, dest);
+  if (!FlightCode::fits(origin) || !FlightCode::fits(dest)) {
+    std::cout << "Origin and destination can have at most "
+              << FlightCode::MAX_LENGTH << " characters.\n";
+    pressEnterToContinue();
+    return;
+  }
 
   std::cout << "Enter Capacity: ";
   while (!(std::cin >> capacity) ||
@@ -204,62 +611,438 @@ void BookingSystem::addNewFlight() {
   std::cin.ignore(std::numeric_limits<std::streamsize>::max(),
                   '\n'); // Consume newline
 
-  // Use emplace for efficiency
-  flights.emplace(std::piecewise_construct, std::forward_as_tuple(id),
-                  std::forward_as_tuple(id, origin, dest, capacity));
+  addFlight(id, origin, dest, capacity);
 
   std::cout << "Flight " << id << " added successfully.\n";
   pressEnterToContinue();
 }
 
+void BookingSystem::importData() {
+  clearScreen();
+  std::cout << "--- Import Schedule / Manifest (Admin) ---\n";
+  std::cout << "1. Flight schedule\n2. Passenger manifest\n";
+  std::cout << "Enter your choice: ";
+  int kind = 0;
+  while (!(std::cin >> kind) || (kind != 1 && kind != 2)) {
+    std::cout << "Invalid choice. Please enter 1 or 2: ";
+    std::cin.clear();
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  }
+  std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+  std::string path;
+  std::cout << "Enter file path (CSV or binary): ";
+  std::getline(std::cin, path);
+
+  try {
+    ImportStats stats =
+        kind == 1 ? importSchedule(path) : importManifest(path);
+    if (kind == 1) {
+      std::cout << "Imported " << stats.imported << " flights.\n";
+    } else {
+      std::cout << "Imported " << stats.imported << " passengers, "
+                << stats.booked << " bookings.\n";
+    }
+    if (stats.skipped + stats.rejected > 0) {
+      std::cout << "Skipped " << stats.skipped << " rows, rejected "
+                << stats.rejected << " malformed rows (first: "
+                << stats.firstProblem << ").\n";
+    }
+  } catch (const std::runtime_error &e) {
+    std::cout << "Import failed: " << e.what() << '\n';
+  }
+  pressEnterToContinue();
+}
+
+void BookingSystem::searchFlights() {
+  clearScreen();
+  std::cout << "--- Search Flights With Free Seats ---\n";
+  std::string origin, destination;
+  std::cout << "Enter Origin: ";
+  std::cin >> origin;
+  std::cout << "Enter Destination: ";
+  std::cin >> destination;
+  std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+  std::vector<RouteAvailability> results;
+  if (findAvailableFlights(origin, destination, results) == 0) {
+    std::cout << "No flights with free seats from " << origin << " to "
+              << destination << ".\n";
+  } else {
+    std::cout << std::left << std::setw(10) << "Flight ID" << std::setw(10)
+              << "Free" << std::endl;
+    for (const RouteAvailability &hit : results) {
+      std::cout << std::left << std::setw(10) << hit.flightId.str()
+                << std::setw(10) << hit.seatsAvailable << std::endl;
+    }
+  }
+  pressEnterToContinue();
+}
+
 void BookingSystem::loadSampleData() {
   // Add sample passengers
-  passengers.emplace(nextPassengerId, Passenger(nextPassengerId, "Alice"));
-  nextPassengerId++;
-  passengers.emplace(nextPassengerId, Passenger(nextPassengerId, "Bob"));
-  nextPassengerId++;
-  passengers.emplace(nextPassengerId, Passenger(nextPassengerId, "Charlie"));
-  nextPassengerId++;
-  passengers.emplace(nextPassengerId, Passenger(nextPassengerId, "David"));
-  nextPassengerId++;
-  passengers.emplace(nextPassengerId, Passenger(nextPassengerId, "Eve"));
-  nextPassengerId++;
-  passengers.emplace(nextPassengerId, Passenger(nextPassengerId, "Frank"));
-  nextPassengerId++;
-
-  // Add sample flights using emplace
-  // Use piecewise_construct to construct Flight in place
-  flights.emplace(
-      std::piecewise_construct, std::forward_as_tuple("AI101"),
-      std::forward_as_tuple("AI101", "Delhi", "Mumbai",
-                            2)); // Small capacity for testing waitlist
-
-  flights.emplace(std::piecewise_construct, std::forward_as_tuple("BA202"),
-                  std::forward_as_tuple("BA202", "London", "NewYork", 250));
-
-  flights.emplace(std::piecewise_construct, std::forward_as_tuple("LH303"),
-                  std::forward_as_tuple("LH303", "Frankfurt", "Tokyo", 3));
-
-  // Pre-book some passengers to test waitlist, ensuring flights exist
-  if (flights.count("AI101")) {
-    flights.at("AI101").addPassenger(1, nextBookingPriority++); // Alice
-    flights.at("AI101").addPassenger(2, nextBookingPriority++); // Bob
-    flights.at("AI101").addPassenger(
-        3, nextBookingPriority++); // Charlie to waitlist
-    flights.at("AI101").addPassenger(
-        4, nextBookingPriority++); // David to waitlist
-  }
-  if (flights.count("LH303")) {
-    flights.at("LH303").addPassenger(5, nextBookingPriority++); // Eve
-  }
-  // Clear the console messages generated during setup
-  // Note: suppressing cout during setup might be better
-  // std::cout.setstate(std::ios_base::failbit); // Suppress
-  // ... setup calls ...
-  // std::cout.clear(); // Restore
+  passengers.add("Alice");   // ID 1
+  passengers.add("Bob");     // ID 2
+  passengers.add("Charlie"); // ID 3
+  passengers.add("David");   // ID 4
+  passengers.add("Eve");     // ID 5
+  passengers.add("Frank");   // ID 6
+
+  // Add sample flights, keeping the handles for the pre-bookings below
+  // Small capacity for testing waitlist
+  FlightHandle ai101 =
+      flights.insert(Flight("AI101", "Delhi", "Mumbai", 2)).first;
+  flights.insert(Flight("BA202", "London", "NewYork", 250));
+  FlightHandle lh303 =
+      flights.insert(Flight("LH303", "Frankfurt", "Tokyo", 3)).first;
+
+  // Pre-book some passengers to test waitlist
+  Flight &ai101Flight = flights.get(ai101);
+  ai101Flight.addPassenger(1, nextBookingPriority++); // Alice
+  ai101Flight.addPassenger(2, nextBookingPriority++); // Bob
+  ai101Flight.addPassenger(3, nextBookingPriority++); // Charlie to waitlist
+  ai101Flight.addPassenger(4, nextBookingPriority++); // David to waitlist
+  flights.get(lh303).addPassenger(5, nextBookingPriority++); // Eve
   std::cout << "\nSample data loaded.\n"; // Indicate setup complete
 }
 
+// --- Programmatic API ---
+
+PassengerIdType BookingSystem::addPassenger(const std::string &name) {
+  PassengerIdType id = passengers.add(name);
+  if (journal.isOpen()) {
+    journal.logPassenger(id, passengers.nameData(id),
+                         passengers.nameLength(id));
+  }
+  return id;
+}
+
+bool BookingSystem::addFlight(const std::string &flightId,
+                              const std::string &origin,
+                              const std::string &destination, int capacity,
+                              WaitlistBackend waitlistBackend) {
+  if (baseline.find(flightId) != MappedSnapshot::NOT_FOUND) {
+    return false;
+  }
+  std::pair<FlightHandle, bool> inserted = flights.insert(
+      Flight(flightId, origin, destination, capacity, waitlistBackend));
+  if (!inserted.second) {
+    return false;
+  }
+  flights.get(inserted.first).setEventSink(flightSink());
+  indexRoute(inserted.first);
+  if (journal.isOpen()) {
+    journal.logFlight(flightId, origin, destination, capacity,
+                      waitlistBackend);
+  }
+  return true;
+}
+
+// --- Bulk Import ---
+
+template <typename Fn> ImportStats BookingSystem::runImport(Fn importRows) {
+  ImportStats stats;
+  muted = true;
+  try {
+    importRows(stats);
+  } catch (...) {
+    muted = false;
+    checkpoint(); // Keep what was imported before the error
+    throw;
+  }
+  muted = false;
+  checkpoint();
+  return stats;
+}
+
+static void noteSkipped(ImportStats &stats, const BulkReader &reader,
+                        const char *reason, StringRef flightId) {
+  if (stats.skipped++ == 0) {
+    stats.firstProblem = "row " + std::to_string(reader.getRowNumber()) +
+                         ": " + reason + " " + flightId.str();
+  }
+}
+
+static void noteRejected(ImportStats &stats, const BulkReader &reader) {
+  stats.rejected = reader.getRejectedCount();
+  if (stats.firstProblem.empty()) {
+    stats.firstProblem = reader.getFirstError();
+  }
+}
+
+ImportStats BookingSystem::importSchedule(const std::string &path) {
+  return runImport([this, &path](ImportStats &stats) {
+    ScheduleReader reader(path);
+    flights.reserve(flights.size() + reader.estimatedRows());
+    ScheduleRow row;
+    while (reader.next(row)) {
+      if (baseline.find(row.flightId) != MappedSnapshot::NOT_FOUND) {
+        noteSkipped(stats, reader, "duplicate flight", row.flightId);
+        continue;
+      }
+      std::pair<FlightHandle, bool> inserted =
+          flights.emplace(row.flightId, row.origin, row.destination,
+                          row.capacity, row.backend);
+      if (!inserted.second) {
+        noteSkipped(stats, reader, "duplicate flight", row.flightId);
+        continue;
+      }
+      flights.get(inserted.first).setEventSink(flightSink());
+      indexRoute(inserted.first);
+      ++stats.imported;
+    }
+    noteRejected(stats, reader);
+  });
+}
+
+ImportStats BookingSystem::importManifest(const std::string &path) {
+  return runImport([this, &path](ImportStats &stats) {
+    ManifestReader reader(path);
+    passengers.reserve(passengers.size() + reader.estimatedRows(),
+                       passengers.getNameArenaSize() +
+                           reader.estimatedNameBytes());
+    ManifestRow row;
+    while (reader.next(row)) {
+      PassengerIdType id = passengers.add(row.name);
+      ++stats.imported;
+      if (row.flightId.empty()) {
+        continue;
+      }
+      FlightHandle handle = resolveFlight(row.flightId);
+      if (handle == INVALID_FLIGHT_HANDLE) {
+        noteSkipped(stats, reader, "unknown flight", row.flightId);
+        continue;
+      }
+      // A new passenger is never a duplicate: always confirmed or waitlisted
+      flights.get(handle).book(id, nextBookingPriority++);
+      ++stats.booked;
+    }
+    noteRejected(stats, reader);
+  });
+}
+
+// Calls fn(flight, first, last) once per run of requests for the same flight,
+// where [first, last) indexes into 'order'. Input order is kept within a
+// run. Requests for unknown flights are skipped, callers pre-fill results.
+// 'resolve' maps a flight ID to its live handle (or INVALID_FLIGHT_HANDLE).
+template <typename Resolve, typename Fn>
+static void forEachFlightGroup(FlightIndex &flights, Resolve resolve,
+                               const std::vector<BookingRequest> &requests,
+                               std::vector<std::size_t> &order, Fn fn) {
+  // Intern every flight ID once, then group by the integer handle
+  std::vector<FlightHandle> handles(requests.size());
+  order.clear();
+  order.reserve(requests.size());
+  for (std::size_t i = 0; i < requests.size(); ++i) {
+    handles[i] = resolve(requests[i].flightId);
+    if (handles[i] != INVALID_FLIGHT_HANDLE) {
+      order.push_back(i);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&handles](std::size_t a, std::size_t b) {
+                     return handles[a] < handles[b];
+                   });
+
+  std::size_t first = 0;
+  while (first < order.size()) {
+    FlightHandle handle = handles[order[first]];
+    std::size_t last = first + 1;
+    while (last < order.size() && handles[order[last]] == handle) {
+      ++last;
+    }
+    fn(flights.get(handle), first, last);
+    first = last;
+  }
+}
+
+std::vector<BookingResult>
+BookingSystem::bookBatch(const std::vector<BookingRequest> &requests) {
+  for (const BookingRequest &request : requests) {
+    requireValidTier(request.tier);
+  }
+  std::vector<BookingResult> results(requests.size(),
+                                     BookingResult::UnknownFlight);
+  // Sequences follow input order, as if the requests came in one by one
+  const PriorityType basePriority = nextBookingPriority;
+  nextBookingPriority += static_cast<PriorityType>(requests.size());
+
+  std::vector<std::size_t> order;
+  std::vector<std::pair<PassengerIdType, PriorityType>> group;
+  std::vector<std::size_t> groupIndices;
+  std::vector<BookingResult> groupResults;
+  forEachFlightGroup(
+      flights,
+      [this](const std::string &flightId) { return resolveFlight(flightId); },
+      requests, order,
+      [&](Flight &flight, std::size_t first, std::size_t last) {
+        group.clear();
+        groupIndices.clear();
+        groupResults.clear();
+        for (std::size_t k = first; k < last; ++k) {
+          std::size_t idx = order[k];
+          PassengerIdType passengerId = requests[idx].passengerId;
+          if (!passengers.contains(passengerId)) {
+            results[idx] = BookingResult::UnknownPassenger;
+            continue;
+          }
+          group.emplace_back(
+              passengerId,
+              makePriority(requests[idx].tier,
+                           basePriority + static_cast<PriorityType>(idx)));
+          groupIndices.push_back(idx);
+        }
+        flight.addPassengers(group, groupResults);
+        for (std::size_t j = 0; j < groupIndices.size(); ++j) {
+          results[groupIndices[j]] = groupResults[j];
+        }
+      });
+  maybeCheckpoint();
+  return results;
+}
+
+std::vector<BookingResult>
+BookingSystem::cancelBatch(const std::vector<BookingRequest> &requests) {
+  std::vector<BookingResult> results(requests.size(),
+                                     BookingResult::UnknownFlight);
+
+  std::vector<std::size_t> order;
+  std::vector<PassengerIdType> group;
+  std::vector<std::size_t> groupIndices;
+  std::vector<BookingResult> groupResults;
+  forEachFlightGroup(
+      flights,
+      [this](const std::string &flightId) { return resolveFlight(flightId); },
+      requests, order,
+      [&](Flight &flight, std::size_t first, std::size_t last) {
+        group.clear();
+        groupIndices.clear();
+        groupResults.clear();
+        for (std::size_t k = first; k < last; ++k) {
+          std::size_t idx = order[k];
+          PassengerIdType passengerId = requests[idx].passengerId;
+          if (!passengers.contains(passengerId)) {
+            results[idx] = BookingResult::UnknownPassenger;
+            continue;
+          }
+          group.push_back(passengerId);
+          groupIndices.push_back(idx);
+        }
+        flight.cancelPassengers(group, groupResults);
+        for (std::size_t j = 0; j < groupIndices.size(); ++j) {
+          results[groupIndices[j]] = groupResults[j];
+        }
+      });
+  maybeCheckpoint();
+  return results;
+}
+
+ItineraryResult
+BookingSystem::bookItinerary(PassengerIdType passengerId,
+                             const std::vector<std::string> &flightIds) {
+  requireDistinctLegs(flightIds);
+  if (!passengers.contains(passengerId)) {
+    return ItineraryResult(BookingResult::UnknownPassenger,
+                           ItineraryResult::NO_LEG);
+  }
+  // All handles first: materializing a leg may move the other flights
+  std::vector<FlightHandle> handles(flightIds.size());
+  for (std::size_t leg = 0; leg < flightIds.size(); ++leg) {
+    handles[leg] = resolveFlight(flightIds[leg]);
+    if (handles[leg] == INVALID_FLIGHT_HANDLE) {
+      return ItineraryResult(BookingResult::UnknownFlight, leg);
+    }
+  }
+  for (std::size_t leg = 0; leg < flightIds.size(); ++leg) {
+    BookingResult result = flights.get(handles[leg]).checkSeat(passengerId);
+    if (result != BookingResult::Confirmed) {
+      return ItineraryResult(result, leg);
+    }
+  }
+  const PriorityType priority = nextBookingPriority++;
+  // One journal group for all legs: a crash recovers all of them or none
+  journal.holdCommits();
+  try {
+    for (FlightHandle handle : handles) {
+      flights.get(handle).book(passengerId, priority);
+    }
+  } catch (...) {
+    journal.releaseCommits();
+    throw;
+  }
+  journal.releaseCommits();
+  maybeCheckpoint();
+  return ItineraryResult();
+}
+
+// --- Seat Holds ---
+
+BookingResult BookingSystem::holdSeat(PassengerIdType passengerId,
+                                      const std::string &flightId,
+                                      std::chrono::milliseconds duration) {
+  if (!passengers.contains(passengerId)) {
+    return BookingResult::UnknownPassenger;
+  }
+  FlightHandle handle = resolveFlight(flightId);
+  if (handle == INVALID_FLIGHT_HANDLE) {
+    return BookingResult::UnknownFlight;
+  }
+  BookingResult result = flights.get(handle).holdSeat(passengerId);
+  if (result == BookingResult::Held) {
+    holds.add(handle, passengerId, SeatHolds::Clock::now() + duration);
+    maybeCheckpoint();
+  }
+  return result;
+}
+
+BookingResult BookingSystem::confirmHold(PassengerIdType passengerId,
+                                         const std::string &flightId) {
+  if (!passengers.contains(passengerId)) {
+    return BookingResult::UnknownPassenger;
+  }
+  FlightHandle handle = resolveFlight(flightId);
+  if (handle == INVALID_FLIGHT_HANDLE) {
+    return BookingResult::UnknownFlight;
+  }
+  BookingResult result = flights.get(handle).confirmHold(passengerId);
+  if (result == BookingResult::Confirmed) {
+    holds.remove(handle, passengerId);
+    maybeCheckpoint();
+  }
+  return result;
+}
+
+BookingResult BookingSystem::releaseHold(PassengerIdType passengerId,
+                                         const std::string &flightId) {
+  if (!passengers.contains(passengerId)) {
+    return BookingResult::UnknownPassenger;
+  }
+  FlightHandle handle = resolveFlight(flightId);
+  if (handle == INVALID_FLIGHT_HANDLE) {
+    return BookingResult::UnknownFlight;
+  }
+  BookingResult result = flights.get(handle).releaseHold(passengerId);
+  if (result == BookingResult::HoldReleased) {
+    holds.remove(handle, passengerId);
+    maybeCheckpoint();
+  }
+  return result;
+}
+
+std::size_t BookingSystem::expireHolds(SeatHolds::Clock::time_point now) {
+  std::size_t expired = holds.expire(
+      now, [this](std::uint64_t handle, PassengerIdType passengerId) {
+        flights.get(static_cast<FlightHandle>(handle))
+            .releaseHold(passengerId);
+      });
+  if (expired > 0) {
+    maybeCheckpoint();
+  }
+  return expired;
+}
+
+std::size_t BookingSystem::getHoldCount() const { return holds.size(); }
+
 // --- Public Run Method ---
 
 void BookingSystem::run() {
@@ -295,7 +1078,14 @@ void BookingSystem::run() {
     case 6:
       addNewFlight();
       break;
+    case 7:
+      importData();
+      break;
+    case 8:
+      searchFlights();
+      break;
     case 0:
+      checkpoint(); // Next start loads the snapshot, nothing to replay
       std::cout << "Exiting system. Goodbye!\n";
       break;
     default:
@@ -303,5 +1093,6 @@ void BookingSystem::run() {
       pressEnterToContinue();
       break;
     }
+    maybeCheckpoint();
   } while (choice != 0);
 }
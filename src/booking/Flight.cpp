@@ -1,93 +1,499 @@
 #include "booking/Flight.h"
-#include "core/Passenger.h" // Include Passenger definition
-#include <algorithm>        // For std::find, std::find_if
-#include <iomanip>          // For std::setw
+#include "core/PassengerTable.h" // Include PassengerTable definition
+#include "metrics/Metrics.h"
+#include <iomanip>               // For std::setw
 #include <iostream>
+#include <stdexcept> // For std::invalid_argument
 
-Flight::Flight(std::string id, std::string orig, std::string dest, int cap)
-    : flightId(std::move(id)), origin(std::move(orig)),
-      destination(std::move(dest)),
-      capacity(cap >= 0 ? cap : 0) // Ensure non-negative capacity
-                                   // waitlistHeap is default constructed
-{}
+// How many waitlisted passengers displayStatus() lists (gate agent view)
+static const std::size_t WAITLIST_DISPLAY_LIMIT = 20;
+
+Flight::Flight(StringRef id, StringRef orig, StringRef dest, int cap,
+               WaitlistBackend waitlistBackend,
+               BinomialHeap::InsertMode waitlistMode)
+    : flightId(id), origin(orig), destination(dest),
+      capacity(cap >= 0 ? cap : 0), // Ensure non-negative capacity
+      waitlist(waitlistBackend, waitlistMode), heldSeats(0),
+      eventSink(nullptr) {}
 
 // --- Accessors ---
-std::string Flight::getFlightId() const { return flightId; }
-std::string Flight::getOrigin() const { return origin; }
-std::string Flight::getDestination() const { return destination; }
+const FlightCode &Flight::getFlightId() const { return flightId; }
+const FlightCode &Flight::getOrigin() const { return origin; }
+const FlightCode &Flight::getDestination() const { return destination; }
 int Flight::getCapacity() const { return capacity; }
 int Flight::getBookedCount() const { return confirmedPassengers.size(); }
-int Flight::getWaitlistCount() const { return waitlistHeap.getSize(); }
-const BinomialHeap &Flight::getWaitlistHeap() const { return waitlistHeap; }
+int Flight::getWaitlistCount() const { return waitlist.getSize(); }
+int Flight::getHeldCount() const { return heldSeats; }
+const SeatList &Flight::getConfirmedPassengers() const {
+  return confirmedPassengers;
+}
+const Waitlist &Flight::getWaitlist() const { return waitlist; }
+
+std::vector<std::pair<PriorityType, PassengerIdType>>
+Flight::getWaitlistTop(std::size_t k) const {
+  return waitlist.topK(k);
+}
 
 // --- Core Operations ---
 
+void Flight::emit(BookingEventType type, PassengerIdType passengerId,
+                  PriorityType priority) const {
+  if (eventSink != nullptr) {
+    BookingEvent event;
+    event.type = type;
+    event.passengerId = passengerId;
+    event.priority = priority;
+    event.flight = this;
+    eventSink->onEvent(event);
+  }
+}
+
+BookingResult Flight::book(PassengerIdType passengerId, PriorityType priority) {
+  METRIC_TIMER(timer, LatencyMetric::FlightBook);
+  // Check if already confirmed or waitlisted
+  auto entryIt = bookingIndex.find(passengerId);
+  if (entryIt != bookingIndex.end()) {
+    if (entryIt->second.seatSlot >= 0) {
+      emit(BookingEventType::AlreadyConfirmed, passengerId, priority);
+      return BookingResult::AlreadyConfirmed;
+    }
+    if (entryIt->second.seatSlot == HELD) {
+      emit(BookingEventType::AlreadyHeld, passengerId, priority);
+      return BookingResult::AlreadyHeld;
+    }
+    // Keeps the original priority
+    emit(BookingEventType::AlreadyWaitlisted, passengerId,
+         waitlist.getPriority(entryIt->second.waitlistHandle));
+    return BookingResult::AlreadyWaitlisted;
+  }
+
+  if (hasFreeSeat()) {
+    confirmSeat(passengerId);
+    emit(BookingEventType::Confirmed, passengerId, priority);
+    return BookingResult::Confirmed;
+  }
+  BookingEntry entry;
+  entry.seatSlot = WAITLISTED;
+  entry.waitlistHandle = waitlist.insert(priority, passengerId);
+  bookingIndex.emplace(passengerId, entry);
+  emit(BookingEventType::Waitlisted, passengerId, priority);
+  return BookingResult::Waitlisted;
+}
+
+BookingResult Flight::cancel(PassengerIdType passengerId) {
+  METRIC_TIMER(timer, LatencyMetric::FlightCancel);
+  auto entryIt = bookingIndex.find(passengerId);
+  if (entryIt == bookingIndex.end() || entryIt->second.seatSlot == HELD) {
+    emit(BookingEventType::NotBooked, passengerId, MAX_PRIORITY);
+    return BookingResult::NotBooked;
+  }
+
+  BookingEntry entry = entryIt->second;
+  bookingIndex.erase(entryIt);
+
+  if (entry.seatSlot == WAITLISTED) {
+    // Not confirmed: drop the passenger from the waitlist instead
+    PriorityType priority = waitlist.getPriority(entry.waitlistHandle);
+    waitlist.erase(entry.waitlistHandle);
+    emit(BookingEventType::RemovedFromWaitlist, passengerId, priority);
+    return BookingResult::RemovedFromWaitlist;
+  }
+
+  releaseSeat(entry.seatSlot);
+  emit(BookingEventType::Cancelled, passengerId, MAX_PRIORITY);
+  // Process waitlist if space opened up and waitlist is not empty
+  if (!waitlist.isEmpty()) {
+    METRIC_TIMER_SET(timer, LatencyMetric::FlightCancelPromoted);
+    promoteFromWaitlist();
+  }
+  return BookingResult::Cancelled;
+}
+
 bool Flight::addPassenger(PassengerIdType passengerId, PriorityType priority) {
-  // Basic check if already confirmed (more robust check might be needed for
-  // waitlist)
-  if (std::find(confirmedPassengers.begin(), confirmedPassengers.end(),
-                passengerId) != confirmedPassengers.end()) {
-    std::cout << "Passenger " << passengerId
-              << " is already confirmed on flight " << flightId << "."
-              << std::endl;
-    return true; // Already confirmed
-  }
-  // Add check for waitlist if necessary (requires search capability in heap or
-  // separate tracking)
-
-  if (confirmedPassengers.size() < static_cast<size_t>(capacity)) {
-    confirmedPassengers.push_back(passengerId);
-    std::cout << "Booking confirmed for Passenger " << passengerId
-              << " on flight " << flightId << "." << std::endl;
-    return true;
-  } else {
-    waitlistHeap.insert(priority, passengerId);
-    std::cout << "Flight " << flightId << " is full. Passenger " << passengerId
-              << " added to waitlist (Priority: " << priority << ")."
-              << std::endl;
+  BookingResult result = book(passengerId, priority);
+  return result == BookingResult::Confirmed ||
+         result == BookingResult::AlreadyConfirmed;
+}
+
+bool Flight::cancelBooking(PassengerIdType passengerId) {
+  return cancel(passengerId) != BookingResult::NotBooked;
+}
+
+void Flight::addPassengers(
+    const std::vector<std::pair<PassengerIdType, PriorityType>> &batch,
+    std::vector<BookingResult> &results) {
+  results.reserve(results.size() + batch.size());
+  std::vector<std::pair<PriorityType, PassengerIdType>> overflow;
+  std::vector<BookingEntry *> overflowEntries; // Stable across rehashing
+  // Repeats of a passenger waitlisted earlier in this batch: reported once
+  // the heap has their key
+  std::vector<std::pair<PassengerIdType, BookingEntry *>> repeats;
+
+  // Waitlisted entries have no handle until the heap is built below. If
+  // anything throws before that, they leave the index again, together with
+  // an entry that was only half filled in.
+  PassengerIdType unfinished = INVALID_PASSENGER_ID;
+  std::vector<Waitlist::Handle> handles;
+  try {
+    for (const auto &request : batch) {
+      PassengerIdType passengerId = request.first;
+      auto inserted = bookingIndex.emplace(passengerId, BookingEntry());
+      if (!inserted.second) {
+        // Already on the flight (possibly earlier in this same batch)
+        BookingEntry &entry = inserted.first->second;
+        if (entry.seatSlot >= 0) {
+          emit(BookingEventType::AlreadyConfirmed, passengerId,
+               request.second);
+          results.push_back(BookingResult::AlreadyConfirmed);
+        } else if (entry.seatSlot == HELD) {
+          emit(BookingEventType::AlreadyHeld, passengerId, request.second);
+          results.push_back(BookingResult::AlreadyHeld);
+        } else {
+          // Keeps the original priority, as in book()
+          if (entry.waitlistHandle != nullptr) {
+            emit(BookingEventType::AlreadyWaitlisted, passengerId,
+                 waitlist.getPriority(entry.waitlistHandle));
+          } else {
+            repeats.emplace_back(passengerId, &entry);
+          }
+          results.push_back(BookingResult::AlreadyWaitlisted);
+        }
+        continue;
+      }
+      unfinished = passengerId;
+      BookingEntry &entry = inserted.first->second;
+      entry.waitlistHandle = nullptr;
+      if (hasFreeSeat()) {
+        confirmedPassengers.push_back(passengerId);
+        entry.seatSlot = static_cast<int>(confirmedPassengers.size()) - 1;
+        unfinished = INVALID_PASSENGER_ID;
+        emit(BookingEventType::Confirmed, passengerId, request.second);
+        results.push_back(BookingResult::Confirmed);
+      } else {
+        overflow.emplace_back(request.second, passengerId);
+        overflowEntries.push_back(&entry);
+        entry.seatSlot = WAITLISTED;
+        unfinished = INVALID_PASSENGER_ID;
+        results.push_back(BookingResult::Waitlisted);
+      }
+    }
+
+    // Build the waitlist part of the batch in one go
+    waitlist.insertBatch(overflow, handles);
+  } catch (...) {
+    if (unfinished != INVALID_PASSENGER_ID) {
+      bookingIndex.erase(unfinished);
+    }
+    for (const auto &waiting : overflow) {
+      bookingIndex.erase(waiting.second);
+    }
+    throw;
+  }
+  for (std::size_t i = 0; i < handles.size(); ++i) {
+    overflowEntries[i]->waitlistHandle = handles[i];
+  }
+  for (const auto &waiting : overflow) {
+    emit(BookingEventType::Waitlisted, waiting.second, waiting.first);
+  }
+  for (const auto &repeat : repeats) {
+    emit(BookingEventType::AlreadyWaitlisted, repeat.first,
+         waitlist.getPriority(repeat.second->waitlistHandle));
+  }
+}
+
+void Flight::cancelPassengers(const std::vector<PassengerIdType> &batch,
+                              std::vector<BookingResult> &results) {
+  results.reserve(results.size() + batch.size());
+  for (PassengerIdType passengerId : batch) {
+    results.push_back(cancel(passengerId));
+  }
+}
+
+void Flight::confirmSeat(PassengerIdType passengerId) {
+  BookingEntry &entry = bookingIndex[passengerId];
+  entry.seatSlot = static_cast<int>(confirmedPassengers.size());
+  entry.waitlistHandle = nullptr;
+  confirmedPassengers.push_back(passengerId);
+}
+
+void Flight::releaseSeat(int seatSlot) {
+  PassengerIdType last = confirmedPassengers.back();
+  confirmedPassengers.pop_back();
+  if (static_cast<size_t>(seatSlot) < confirmedPassengers.size()) {
+    // Fill the hole with the last passenger and repoint its index entry
+    confirmedPassengers[seatSlot] = last;
+    bookingIndex[last].seatSlot = seatSlot;
+  }
+}
+
+bool Flight::hasFreeSeat() const {
+  return confirmedPassengers.size() + static_cast<std::size_t>(heldSeats) <
+         static_cast<std::size_t>(capacity);
+}
+
+void Flight::promoteFromWaitlist() {
+  std::pair<PriorityType, PassengerIdType> promoted =
+      waitlist.extractMinWithPriority();
+  confirmSeat(promoted.second); // Overwrites the waitlist entry
+  emit(BookingEventType::Promoted, promoted.second, promoted.first);
+}
+
+bool Flight::upgradeWaitlistPriority(PassengerIdType passengerId,
+                                     PriorityType newPriority) {
+  auto entryIt = bookingIndex.find(passengerId);
+  if (entryIt == bookingIndex.end() ||
+      entryIt->second.seatSlot != WAITLISTED) {
     return false;
   }
+  Waitlist::Handle handle = entryIt->second.waitlistHandle;
+  if (!PriorityLess<>()(newPriority, waitlist.getPriority(handle))) {
+    return false; // Would not be served any earlier
+  }
+  waitlist.decreaseKey(handle, newPriority);
+  emit(BookingEventType::PriorityUpgraded, passengerId, newPriority);
+  return true;
 }
 
-bool Flight::cancelBooking(PassengerIdType passengerId) {
-  // Check confirmed list
-  auto it = std::find(confirmedPassengers.begin(), confirmedPassengers.end(),
-                      passengerId);
-  if (it != confirmedPassengers.end()) {
-    confirmedPassengers.erase(it);
-    std::cout << "Booking cancelled for Passenger " << passengerId
-              << " on flight " << flightId << "." << std::endl;
-
-    // Process waitlist if space opened up and waitlist is not empty
-    if (!waitlistHeap.isEmpty()) {
-      try {
-        PassengerIdType promotedPassengerId = waitlistHeap.extractMin();
-        confirmedPassengers.push_back(promotedPassengerId);
-        std::cout << "Passenger " << promotedPassengerId
-                  << " moved from waitlist to confirmed seat on flight "
-                  << flightId << "." << std::endl;
-      } catch (const std::runtime_error &e) {
-        // Should not happen if isEmpty is false, but good practice
-        std::cerr << "Error processing waitlist after cancellation: "
-                  << e.what() << std::endl;
+bool Flight::upgradeWaitlistTier(PassengerIdType passengerId,
+                                 PriorityTier tier) {
+  requireValidTier(tier);
+  auto entryIt = bookingIndex.find(passengerId);
+  if (entryIt == bookingIndex.end() ||
+      entryIt->second.seatSlot != WAITLISTED) {
+    return false;
+  }
+  return upgradeWaitlistPriority(
+      passengerId,
+      withTier(waitlist.getPriority(entryIt->second.waitlistHandle), tier));
+}
+
+void Flight::absorb(Flight &&other, PriorityType firstSequence) {
+  if (&other == this) {
+    return;
+  }
+  if (other.heldSeats > 0) {
+    throw std::invalid_argument("Cannot absorb flight '" +
+                                other.flightId.str() +
+                                "' while it has seats on hold");
+  }
+  // Everyone leaves 'other', waitlist first, so a replay of these events
+  // (cancel by cancel) promotes nobody there
+  for (const auto &booking : other.bookingIndex) {
+    if (booking.second.seatSlot == WAITLISTED) {
+      other.emit(BookingEventType::RemovedFromWaitlist, booking.first,
+                 other.waitlist.getPriority(booking.second.waitlistHandle));
+    }
+  }
+  for (PassengerIdType passengerId : other.confirmedPassengers) {
+    other.emit(BookingEventType::Cancelled, passengerId, MAX_PRIORITY);
+  }
+
+  // Passengers on both flights stay as they are here
+  std::vector<PassengerIdType> duplicates;
+  for (const auto &booking : other.bookingIndex) {
+    if (bookingIndex.count(booking.first) != 0) {
+      duplicates.push_back(booking.first);
+    }
+  }
+  for (PassengerIdType passengerId : duplicates) {
+    auto entryIt = other.bookingIndex.find(passengerId);
+    BookingEntry entry = entryIt->second;
+    other.bookingIndex.erase(entryIt);
+    if (entry.seatSlot == WAITLISTED) {
+      other.waitlist.erase(entry.waitlistHandle);
+    } else {
+      other.releaseSeat(entry.seatSlot);
+    }
+  }
+
+  // Confirmed passengers: free seats first, the rest to the front of the
+  // waitlist (BUMPED_TIER, below every packed tier key). Each one has its
+  // own number of the reserved sequence, whichever way it goes.
+  bookingIndex.reserve(bookingIndex.size() + other.bookingIndex.size());
+  std::vector<std::pair<PriorityType, PassengerIdType>> bumped;
+  for (std::size_t i = 0; i < other.confirmedPassengers.size(); ++i) {
+    const PassengerIdType passengerId = other.confirmedPassengers[i];
+    const PriorityType priority =
+        makeBumpedPriority(firstSequence + static_cast<PriorityType>(i));
+    if (hasFreeSeat()) {
+      confirmSeat(passengerId);
+      emit(BookingEventType::Confirmed, passengerId, priority);
+    } else {
+      bumped.emplace_back(priority, passengerId);
+    }
+  }
+  // Everyone else who joins the waitlist here. Reported only once the free
+  // seats are filled: Confirmed before Waitlisted, so replaying the events
+  // through book() seats the same passengers.
+  std::vector<PassengerIdType> arrivals;
+  std::vector<Waitlist::Handle> handles;
+  waitlist.insertBatch(bumped, handles);
+  for (std::size_t i = 0; i < handles.size(); ++i) {
+    BookingEntry &entry = bookingIndex[bumped[i].second];
+    entry.seatSlot = WAITLISTED;
+    entry.waitlistHandle = handles[i];
+    arrivals.push_back(bumped[i].second);
+  }
+
+  // Waitlist: one union when the backends match, handles carry over as is
+  if (waitlist.meld(std::move(other.waitlist))) {
+    for (const auto &booking : other.bookingIndex) {
+      if (booking.second.seatSlot == WAITLISTED) {
+        bookingIndex.emplace(booking.first, booking.second);
+        arrivals.push_back(booking.first);
       }
     }
-    return true;
+  } else {
+    std::vector<std::pair<PriorityType, PassengerIdType>> moved;
+    moved.reserve(other.waitlist.getSize());
+    while (!other.waitlist.isEmpty()) {
+      moved.push_back(other.waitlist.extractMinWithPriority());
+    }
+    handles.clear();
+    waitlist.insertBatch(moved, handles);
+    for (std::size_t i = 0; i < handles.size(); ++i) {
+      BookingEntry &entry = bookingIndex[moved[i].second];
+      entry.seatSlot = WAITLISTED;
+      entry.waitlistHandle = handles[i];
+      arrivals.push_back(moved[i].second);
+    }
+  }
+  other.confirmedPassengers.clear();
+  other.bookingIndex.clear();
+  other.waitlist.clear(); // Frees a drained backend
+
+  // This waitlist was empty while seats were free, so only arrivals can be
+  // seated here: to a sink they were never waitlisted on this flight
+  while (hasFreeSeat() && !waitlist.isEmpty()) {
+    std::pair<PriorityType, PassengerIdType> promoted =
+        waitlist.extractMinWithPriority();
+    confirmSeat(promoted.second);
+    emit(BookingEventType::Confirmed, promoted.second, promoted.first);
+  }
+  for (PassengerIdType passengerId : arrivals) {
+    const BookingEntry &entry = bookingIndex[passengerId];
+    if (entry.seatSlot == WAITLISTED) {
+      emit(BookingEventType::Waitlisted, passengerId,
+           waitlist.getPriority(entry.waitlistHandle));
+    }
+  }
+}
+
+bool Flight::isConfirmed(PassengerIdType passengerId) const {
+  auto entryIt = bookingIndex.find(passengerId);
+  return entryIt != bookingIndex.end() && entryIt->second.seatSlot >= 0;
+}
+
+bool Flight::isWaitlisted(PassengerIdType passengerId) const {
+  auto entryIt = bookingIndex.find(passengerId);
+  return entryIt != bookingIndex.end() &&
+         entryIt->second.seatSlot == WAITLISTED;
+}
+
+bool Flight::isHeld(PassengerIdType passengerId) const {
+  auto entryIt = bookingIndex.find(passengerId);
+  return entryIt != bookingIndex.end() && entryIt->second.seatSlot == HELD;
+}
+
+BookingResult Flight::checkSeat(PassengerIdType passengerId) const {
+  auto entryIt = bookingIndex.find(passengerId);
+  if (entryIt != bookingIndex.end()) {
+    if (entryIt->second.seatSlot >= 0) {
+      return BookingResult::AlreadyConfirmed;
+    }
+    return entryIt->second.seatSlot == HELD ? BookingResult::AlreadyHeld
+                                            : BookingResult::AlreadyWaitlisted;
+  }
+  return hasFreeSeat() ? BookingResult::Confirmed : BookingResult::SoldOut;
+}
+
+// --- Seat Holds ---
+
+BookingResult Flight::holdSeat(PassengerIdType passengerId) {
+  BookingResult result = checkSeat(passengerId);
+  switch (result) {
+  case BookingResult::Confirmed:
+    break;
+  case BookingResult::SoldOut:
+    emit(BookingEventType::SoldOut, passengerId, MAX_PRIORITY);
+    return result;
+  case BookingResult::AlreadyWaitlisted:
+    emit(BookingEventType::AlreadyWaitlisted, passengerId,
+         waitlist.getPriority(bookingIndex[passengerId].waitlistHandle));
+    return result;
+  default:
+    emit(result == BookingResult::AlreadyHeld
+             ? BookingEventType::AlreadyHeld
+             : BookingEventType::AlreadyConfirmed,
+         passengerId, MAX_PRIORITY);
+    return result;
+  }
+  BookingEntry entry;
+  entry.seatSlot = HELD;
+  entry.waitlistHandle = nullptr;
+  bookingIndex.emplace(passengerId, entry);
+  ++heldSeats;
+  emit(BookingEventType::Held, passengerId, MAX_PRIORITY);
+  return BookingResult::Held;
+}
+
+BookingResult Flight::confirmHold(PassengerIdType passengerId) {
+  auto entryIt = bookingIndex.find(passengerId);
+  if (entryIt == bookingIndex.end() || entryIt->second.seatSlot != HELD) {
+    emit(BookingEventType::NotHeld, passengerId, MAX_PRIORITY);
+    return BookingResult::NotHeld;
+  }
+  --heldSeats;
+  confirmSeat(passengerId); // The seat is still there
+  emit(BookingEventType::HoldConfirmed, passengerId, MAX_PRIORITY);
+  return BookingResult::Confirmed;
+}
+
+BookingResult Flight::releaseHold(PassengerIdType passengerId) {
+  auto entryIt = bookingIndex.find(passengerId);
+  if (entryIt == bookingIndex.end() || entryIt->second.seatSlot != HELD) {
+    emit(BookingEventType::NotHeld, passengerId, MAX_PRIORITY);
+    return BookingResult::NotHeld;
+  }
+  bookingIndex.erase(entryIt);
+  --heldSeats;
+  emit(BookingEventType::HoldReleased, passengerId, MAX_PRIORITY);
+  // Same as a cancelled seat: the best waitlisted passenger gets it
+  if (!waitlist.isEmpty()) {
+    promoteFromWaitlist();
+  }
+  return BookingResult::HoldReleased;
+}
+
+bool Flight::restoreWaitlist(
+    const std::vector<std::pair<PriorityType, PassengerIdType>> &entries) {
+  std::vector<BookingEntry *> restored; // Stable across rehashing
+  restored.reserve(entries.size());
+  for (const auto &entry : entries) {
+    auto inserted = bookingIndex.emplace(entry.second, BookingEntry());
+    if (!inserted.second) {
+      return false;
+    }
+    inserted.first->second.seatSlot = WAITLISTED;
+    restored.push_back(&inserted.first->second);
   }
+  std::vector<Waitlist::Handle> handles;
+  waitlist.insertBatch(entries, handles);
+  for (std::size_t i = 0; i < handles.size(); ++i) {
+    restored[i]->waitlistHandle = handles[i];
+  }
+  return true;
+}
 
-  // Waitlist cancellation is not implemented here (requires search/delete in
-  // heap)
-  std::cout << "Passenger " << passengerId
-            << " not found in confirmed bookings for flight " << flightId
-            << ". Waitlist cancellation not supported in this version."
-            << std::endl;
-  return false;
+void Flight::setWaitlistMode(BinomialHeap::InsertMode mode) {
+  waitlist.setInsertMode(mode);
 }
 
+void Flight::setEventSink(BookingEventSink *sink) { eventSink = sink; }
+
 // --- Display ---
 
-void Flight::displayStatus(
-    const std::map<PassengerIdType, Passenger> &passengerDb) const {
+void Flight::displayStatus(const PassengerTable &passengerDb) const {
   std::cout << "----------------------------------------\n";
   std::cout << " Flight Status: " << flightId << " (" << origin << " -> "
             << destination << ")\n";
@@ -95,16 +501,19 @@ void Flight::displayStatus(
   std::cout << " Capacity: " << capacity << "\n";
   std::cout << " Booked:   " << getBookedCount() << "\n";
   std::cout << " Waitlist: " << getWaitlistCount() << "\n";
+  if (heldSeats > 0) {
+    std::cout << " Held:     " << heldSeats << "\n";
+  }
 
   std::cout << "\n--- Confirmed Passengers ---\n";
   if (confirmedPassengers.empty()) {
     std::cout << " None\n";
   } else {
     for (const auto &pId : confirmedPassengers) {
-      auto pIt = passengerDb.find(pId);
       std::cout << " ID: " << std::setw(4) << pId << ", Name: ";
-      if (pIt != passengerDb.end()) {
-        std::cout << pIt->second.name << "\n";
+      if (passengerDb.contains(pId)) {
+        passengerDb.writeName(std::cout, pId);
+        std::cout << "\n";
       } else {
         std::cout << "<Unknown Passenger>\n";
       }
@@ -112,27 +521,26 @@ void Flight::displayStatus(
   }
 
   std::cout << "\n--- Waitlist (" << getWaitlistCount() << " waiting) ---\n";
-  if (waitlistHeap.isEmpty()) {
+  if (waitlist.isEmpty()) {
     std::cout << " Empty\n";
   } else {
-    // Displaying the top person on waitlist
-    try {
-      PassengerIdType nextPassId = waitlistHeap.findMinPassengerId();
-      PriorityType nextPrio = waitlistHeap.findMinPriority();
-      auto pIt = passengerDb.find(nextPassId);
-      std::cout << " Next: ID: " << std::setw(4) << nextPassId << ", Name: ";
-      if (pIt != passengerDb.end()) {
-        std::cout << pIt->second.name;
+    // Displaying the first few people on the waitlist, in order
+    std::vector<std::pair<PriorityType, PassengerIdType>> top =
+        getWaitlistTop(WAITLIST_DISPLAY_LIMIT);
+    for (std::size_t i = 0; i < top.size(); ++i) {
+      std::cout << (i == 0 ? " Next: " : "       ") << "ID: " << std::setw(4)
+                << top[i].second << ", Name: ";
+      if (passengerDb.contains(top[i].second)) {
+        passengerDb.writeName(std::cout, top[i].second);
       } else {
         std::cout << "<Unknown Passenger>";
       }
-      std::cout << " (Priority: " << nextPrio << ")\n";
-    } catch (const std::runtime_error &e) {
-      std::cerr << " Could not retrieve next passenger from waitlist: "
-                << e.what() << std::endl;
+      std::cout << " (Priority: " << top[i].first << ")\n";
+    }
+    if (static_cast<std::size_t>(getWaitlistCount()) > top.size()) {
+      std::cout << " ... and " << getWaitlistCount() - top.size()
+                << " more\n";
     }
-    // Note: Displaying the full ordered waitlist requires a non-destructive
-    // method or copying the heap.
   }
   std::cout << "----------------------------------------\n";
 }
@@ -0,0 +1,103 @@
+// src/booking/FlightActor.cpp
+#include "booking/FlightActor.h"
+#include <utility>
+
+FlightActor::FlightActor(BookingEventSink *sink, std::size_t batch)
+    : batchSize(batch > 0 ? batch : 1), eventSink(sink), sleeping(false),
+      stopping(false), thread(&FlightActor::run, this) {}
+
+FlightActor::~FlightActor() {
+  {
+    std::lock_guard<std::mutex> lock(parkMutex);
+    stopping.store(true);
+  }
+  parkCondition.notify_one();
+  thread.join();
+}
+
+void FlightActor::post(BookingCommand *command) {
+  mailbox.push(command);
+  // Pairs with the fence in run(): either the actor sees this command
+  // before parking, or this thread sees it parked and wakes it
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping.load(std::memory_order_relaxed) && sleeping.exchange(false)) {
+    std::lock_guard<std::mutex> lock(parkMutex);
+    parkCondition.notify_one();
+  }
+}
+
+void FlightActor::run() {
+  for (;;) {
+    std::size_t executed = 0;
+    while (executed < batchSize) {
+      BookingCommand *command = mailbox.tryPop();
+      if (command == nullptr) {
+        break;
+      }
+      execute(*command);
+      delete command;
+      ++executed;
+    }
+    if (executed > 0) {
+      continue;
+    }
+
+    // Mailbox looks empty: announce the park, then check once more
+    std::unique_lock<std::mutex> lock(parkMutex);
+    sleeping.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    BookingCommand *command = mailbox.tryPop();
+    if (command != nullptr) {
+      sleeping.store(false);
+      lock.unlock();
+      execute(*command);
+      delete command;
+      continue;
+    }
+    if (stopping.load()) {
+      return; // Everything posted before destruction has run
+    }
+    parkCondition.wait(lock,
+                       [this] { return !sleeping.load() || stopping.load(); });
+    sleeping.store(false);
+  }
+}
+
+void FlightActor::execute(BookingCommand &command) {
+  switch (command.kind) {
+  case BookingCommand::Kind::AddFlight: {
+    std::pair<FlightHandle, bool> inserted =
+        flights.insert(std::move(*command.newFlight));
+    if (inserted.second) {
+      flights.get(inserted.first).setEventSink(eventSink);
+    }
+    command.done->set_value(inserted.second);
+    break;
+  }
+  case BookingCommand::Kind::Book:
+  case BookingCommand::Kind::Cancel: {
+    BookingResult result = BookingResult::UnknownFlight;
+    FlightHandle handle = flights.find(command.flightId);
+    if (handle != INVALID_FLIGHT_HANDLE) {
+      Flight &flight = flights.get(handle);
+      result = command.kind == BookingCommand::Kind::Book
+                   ? flight.book(command.passengerId, command.priority)
+                   : flight.cancel(command.passengerId);
+    }
+    if (command.callback) {
+      command.callback(result);
+    } else {
+      command.result.set_value(result);
+    }
+    break;
+  }
+  case BookingCommand::Kind::Inspect: {
+    FlightHandle handle = flights.find(command.flightId);
+    const Flight *flight =
+        handle == INVALID_FLIGHT_HANDLE ? nullptr : &flights.get(handle);
+    command.inspect(flight);
+    command.done->set_value(flight != nullptr);
+    break;
+  }
+  }
+}
@@ -0,0 +1,172 @@
+// src/booking/FlightIndex.cpp
+#include "booking/FlightIndex.h"
+#include <new> // For operator new, placement new
+#include <utility>
+
+// Smallest table size, kept a power of two
+static const std::size_t MIN_SLOTS = 16;
+
+// --- Private Helper Method Implementations ---
+
+std::uint32_t FlightIndex::hashId(StringRef flightId) {
+  std::uint32_t hash = 2166136261u;
+  for (std::size_t i = 0; i < flightId.size; ++i) {
+    hash ^= static_cast<unsigned char>(flightId.data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+std::size_t FlightIndex::probe(StringRef flightId, std::uint32_t hash) const {
+  std::size_t pos = hash & mask;
+  for (;;) {
+    const Slot &slot = slots[pos];
+    if (slot.handle == INVALID_FLIGHT_HANDLE ||
+        (slot.hash == hash &&
+         StringRef(get(slot.handle).getFlightId()) == flightId)) {
+      return pos;
+    }
+    pos = (pos + 1) & mask;
+  }
+}
+
+void FlightIndex::rehash(std::size_t slotCount) {
+  Slot empty;
+  empty.hash = 0;
+  empty.handle = INVALID_FLIGHT_HANDLE;
+  std::vector<Slot> old(slotCount, empty);
+  old.swap(slots);
+  mask = static_cast<std::uint32_t>(slotCount - 1);
+  // IDs are unique, so re-placing only needs the stored hashes
+  for (const Slot &slot : old) {
+    if (slot.handle != INVALID_FLIGHT_HANDLE) {
+      std::size_t pos = slot.hash & mask;
+      while (slots[pos].handle != INVALID_FLIGHT_HANDLE) {
+        pos = (pos + 1) & mask;
+      }
+      slots[pos] = slot;
+    }
+  }
+}
+
+std::size_t FlightIndex::prepareInsert(StringRef flightId,
+                                       std::uint32_t hash) {
+  if ((static_cast<std::size_t>(count) + 1) * 2 > slots.size()) {
+    rehash(slots.empty() ? MIN_SLOTS : slots.size() * 2);
+  }
+  return probe(flightId, hash);
+}
+
+void *FlightIndex::allocateNext() {
+  // Keyed on the chunk count, not on count alone: a Flight constructor
+  // that throws leaves count as it was, and the next insert must reuse the
+  // chunk pushed for it instead of pushing another one
+  if (static_cast<std::size_t>(count >> CHUNK_SHIFT) == chunks.size()) {
+    chunks.push_back(
+        static_cast<Flight *>(::operator new(CHUNK_SIZE * sizeof(Flight))));
+  }
+  return &chunks.back()[count & (CHUNK_SIZE - 1)];
+}
+
+FlightHandle FlightIndex::commitInsert(std::size_t pos, std::uint32_t hash) {
+  FlightHandle handle = count++;
+  slots[pos].hash = hash;
+  slots[pos].handle = handle;
+  return handle;
+}
+
+// --- Constructor / Destructor ---
+
+FlightIndex::FlightIndex() : count(0), mask(0) {}
+
+FlightIndex::~FlightIndex() {
+  for (FlightHandle h = 0; h < count; ++h) {
+    get(h).~Flight();
+  }
+  for (Flight *chunk : chunks) {
+    ::operator delete(chunk);
+  }
+}
+
+// --- Public Interface Method Implementations ---
+
+std::pair<FlightHandle, bool> FlightIndex::insert(Flight flight) {
+  std::uint32_t hash = hashId(flight.getFlightId());
+  std::size_t pos = prepareInsert(flight.getFlightId(), hash);
+  if (slots[pos].handle != INVALID_FLIGHT_HANDLE) {
+    return std::make_pair(slots[pos].handle, false);
+  }
+  new (allocateNext()) Flight(std::move(flight));
+  return std::make_pair(commitInsert(pos, hash), true);
+}
+
+std::pair<FlightHandle, bool>
+FlightIndex::emplace(StringRef flightId, StringRef origin,
+                     StringRef destination, int capacity,
+                     WaitlistBackend waitlistBackend) {
+  std::uint32_t hash = hashId(flightId);
+  std::size_t pos = prepareInsert(flightId, hash);
+  if (slots[pos].handle != INVALID_FLIGHT_HANDLE) {
+    return std::make_pair(slots[pos].handle, false);
+  }
+  // Throws for fields longer than a FlightCode, before count moves
+  new (allocateNext())
+      Flight(flightId, origin, destination, capacity, waitlistBackend);
+  return std::make_pair(commitInsert(pos, hash), true);
+}
+
+FlightHandle FlightIndex::find(StringRef flightId) const {
+  return find(flightId, hashId(flightId));
+}
+
+FlightHandle FlightIndex::find(StringRef flightId, std::uint32_t hash) const {
+  if (slots.empty()) {
+    return INVALID_FLIGHT_HANDLE;
+  }
+  return slots[probe(flightId, hash)].handle;
+}
+
+Flight *FlightIndex::lookup(const std::string &flightId) {
+  FlightHandle handle = find(flightId);
+  return handle == INVALID_FLIGHT_HANDLE ? nullptr : &get(handle);
+}
+
+const Flight *FlightIndex::lookup(const std::string &flightId) const {
+  FlightHandle handle = find(flightId);
+  return handle == INVALID_FLIGHT_HANDLE ? nullptr : &get(handle);
+}
+
+Flight &FlightIndex::get(FlightHandle handle) {
+  return chunks[handle >> CHUNK_SHIFT][handle & (CHUNK_SIZE - 1)];
+}
+
+const Flight &FlightIndex::get(FlightHandle handle) const {
+  return chunks[handle >> CHUNK_SHIFT][handle & (CHUNK_SIZE - 1)];
+}
+
+void FlightIndex::reserve(std::size_t flightCount) {
+  chunks.reserve((flightCount + CHUNK_SIZE - 1) / CHUNK_SIZE);
+  std::size_t slotCount = MIN_SLOTS;
+  while (slotCount < flightCount * 2) {
+    slotCount *= 2;
+  }
+  if (slotCount > slots.size()) {
+    rehash(slotCount);
+  }
+}
+
+std::size_t FlightIndex::size() const { return count; }
+bool FlightIndex::empty() const { return count == 0; }
+
+FlightIndex::iterator FlightIndex::begin() {
+  return iterator(chunks.data(), 0);
+}
+FlightIndex::iterator FlightIndex::end() {
+  return iterator(chunks.data(), count);
+}
+FlightIndex::const_iterator FlightIndex::begin() const {
+  return const_iterator(chunks.data(), 0);
+}
+FlightIndex::const_iterator FlightIndex::end() const {
+  return const_iterator(chunks.data(), count);
+}
@@ -0,0 +1,123 @@
+// src/booking/RouteIndex.cpp
+#include "booking/RouteIndex.h"
+#include <utility> // For std::swap
+
+// Bound to const references (e.g. by vector::resize), so defined here
+const RouteIndex::AirportId RouteIndex::INVALID_AIRPORT;
+const RouteIndex::Key RouteIndex::INVALID_KEY;
+
+std::uint64_t RouteIndex::routeId(AirportId origin, AirportId destination) {
+  return static_cast<std::uint64_t>(origin) << 32 | destination;
+}
+
+RouteIndex::AirportId RouteIndex::intern(StringRef code) {
+  AirportId next = static_cast<AirportId>(airports.size());
+  return airports.emplace(code.str(), next).first->second;
+}
+
+void RouteIndex::reserve(std::size_t flightCount) {
+  locations.reserve(flightCount);
+}
+
+RouteIndex::Key RouteIndex::add(StringRef flightId, StringRef origin,
+                                StringRef destination, int seatsAvailable) {
+  const std::uint64_t id = routeId(intern(origin), intern(destination));
+  std::uint32_t routeIndex = static_cast<std::uint32_t>(routes.size());
+  std::pair<std::unordered_map<std::uint64_t, std::uint32_t>::iterator, bool>
+      inserted = routeIds.emplace(id, routeIndex);
+  if (inserted.second) {
+    routes.push_back(Route());
+  } else {
+    routeIndex = inserted.first->second;
+  }
+
+  Route &route = routes[routeIndex];
+  const Key key = static_cast<Key>(locations.size());
+  Entry entry;
+  entry.flightId = flightId;
+  entry.seatsAvailable = 0; // Full until setSeats() below
+  entry.key = key;
+  route.flights.push_back(entry);
+  Location location;
+  location.route = routeIndex;
+  location.position = static_cast<std::uint32_t>(route.flights.size() - 1);
+  locations.push_back(location);
+  setSeats(key, seatsAvailable);
+  return key;
+}
+
+void RouteIndex::swapEntries(Route &route, std::size_t a, std::size_t b) {
+  if (a == b) {
+    return;
+  }
+  std::swap(route.flights[a], route.flights[b]);
+  locations[route.flights[a].key].position = static_cast<std::uint32_t>(a);
+  locations[route.flights[b].key].position = static_cast<std::uint32_t>(b);
+}
+
+void RouteIndex::setSeats(Key key, int seatsAvailable) {
+  const Location location = locations[key];
+  Route &route = routes[location.route];
+  Entry &entry = route.flights[location.position];
+  const bool hadSeats = entry.seatsAvailable > 0;
+  entry.seatsAvailable = seatsAvailable;
+  if (hadSeats && seatsAvailable <= 0) {
+    // Now full: swap with the last flight that has seats, shrink the part
+    swapEntries(route, location.position, --route.available);
+  } else if (!hadSeats && seatsAvailable > 0) {
+    swapEntries(route, location.position, route.available++);
+  }
+}
+
+void RouteIndex::adjustSeats(Key key, int delta) {
+  const Location location = locations[key];
+  setSeats(key,
+           routes[location.route].flights[location.position].seatsAvailable +
+               delta);
+}
+
+int RouteIndex::getSeats(Key key) const {
+  const Location location = locations[key];
+  return routes[location.route].flights[location.position].seatsAvailable;
+}
+
+std::size_t
+RouteIndex::findAvailable(const std::string &origin,
+                          const std::string &destination,
+                          std::vector<RouteAvailability> &results) const {
+  const AirportId from = findAirport(origin);
+  const AirportId to = findAirport(destination);
+  if (from == INVALID_AIRPORT || to == INVALID_AIRPORT) {
+    return 0;
+  }
+  std::unordered_map<std::uint64_t, std::uint32_t>::const_iterator it =
+      routeIds.find(routeId(from, to));
+  if (it == routeIds.end()) {
+    return 0;
+  }
+  const Route &route = routes[it->second];
+  for (std::size_t i = 0; i < route.available; ++i) {
+    RouteAvailability hit;
+    hit.flightId = route.flights[i].flightId;
+    hit.seatsAvailable = route.flights[i].seatsAvailable;
+    results.push_back(hit);
+  }
+  return route.available;
+}
+
+RouteIndex::AirportId RouteIndex::findAirport(const std::string &code) const {
+  std::unordered_map<std::string, AirportId>::const_iterator it =
+      airports.find(code);
+  return it == airports.end() ? INVALID_AIRPORT : it->second;
+}
+
+std::size_t RouteIndex::size() const { return locations.size(); }
+std::size_t RouteIndex::getAirportCount() const { return airports.size(); }
+std::size_t RouteIndex::getRouteCount() const { return routes.size(); }
+
+void RouteIndex::clear() {
+  airports.clear();
+  routeIds.clear();
+  routes.clear();
+  locations.clear();
+}
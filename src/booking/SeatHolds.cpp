@@ -0,0 +1,54 @@
+// src/booking/SeatHolds.cpp
+#include "booking/SeatHolds.h"
+
+SeatHolds::SeatHolds() : epoch(Clock::now()) {}
+
+TimerWheel::Tick SeatHolds::toTick(Clock::time_point time) const {
+  if (time <= epoch) {
+    return 0;
+  }
+  return static_cast<TimerWheel::Tick>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(time - epoch)
+          .count());
+}
+
+bool SeatHolds::add(std::uint64_t flight, PassengerIdType passengerId,
+                    Clock::time_point expiry) {
+  Key key = {flight, passengerId};
+  std::uint32_t slot = static_cast<std::uint32_t>(records.size());
+  if (!freeRecords.empty()) {
+    slot = freeRecords.back();
+  }
+  if (!index.emplace(key, slot).second) {
+    return false;
+  }
+  if (slot == records.size()) {
+    records.push_back(Record());
+  } else {
+    freeRecords.pop_back();
+  }
+  records[slot].key = key;
+  // Rounded up, so a hold never expires early
+  records[slot].timer = wheel.arm(toTick(expiry) + 1, slot);
+  return true;
+}
+
+bool SeatHolds::remove(std::uint64_t flight, PassengerIdType passengerId) {
+  Key key = {flight, passengerId};
+  auto it = index.find(key);
+  if (it == index.end()) {
+    return false;
+  }
+  wheel.cancel(records[it->second].timer);
+  freeRecords.push_back(it->second);
+  index.erase(it);
+  return true;
+}
+
+bool SeatHolds::contains(std::uint64_t flight,
+                         PassengerIdType passengerId) const {
+  Key key = {flight, passengerId};
+  return index.find(key) != index.end();
+}
+
+std::size_t SeatHolds::size() const { return index.size(); }
@@ -0,0 +1,426 @@
+// src/booking/ShardedBookingEngine.cpp
+#include "booking/ShardedBookingEngine.h"
+#include <algorithm> // For std::sort, std::unique
+#include <cstdlib>   // For posix_memalign, std::free
+#include <new>       // For std::bad_alloc
+#include <stdexcept>
+#include <utility>
+
+// --- Private Helper Method Implementations ---
+
+void *ShardedBookingEngine::Shard::operator new(std::size_t size) {
+  void *block = nullptr;
+  if (posix_memalign(&block, alignof(Shard), size) != 0) {
+    throw std::bad_alloc();
+  }
+  return block;
+}
+
+void ShardedBookingEngine::Shard::operator delete(void *block) noexcept {
+  std::free(block);
+}
+
+// Whether a result changed the flight, so its status must be republished
+static bool changesFlight(BookingResult result) {
+  return result == BookingResult::Confirmed ||
+         result == BookingResult::Waitlisted ||
+         result == BookingResult::Cancelled ||
+         result == BookingResult::RemovedFromWaitlist;
+}
+
+std::uint64_t ShardedBookingEngine::holdKey(std::size_t shard,
+                                            FlightHandle handle) {
+  return (static_cast<std::uint64_t>(shard) << 32) | handle;
+}
+
+std::size_t ShardedBookingEngine::shardIndex(std::uint32_t hash) const {
+  // Multiply-shift uses the high bits of the hash, the shard's own table
+  // probes with the low bits
+  return static_cast<std::size_t>(
+      (static_cast<std::uint64_t>(hash) * shards.size()) >> 32);
+}
+
+ShardedBookingEngine::Shard &
+ShardedBookingEngine::shardFor(std::uint32_t hash) const {
+  return *shards[shardIndex(hash)];
+}
+
+// --- Constructor ---
+
+ShardedBookingEngine::ShardedBookingEngine(unsigned shardCount)
+    : nextBookingPriority(1), eventSink(nullptr) {
+  if (shardCount == 0) {
+    shardCount = 1;
+  }
+  shards.reserve(shardCount);
+  for (unsigned i = 0; i < shardCount; ++i) {
+    shards.push_back(std::unique_ptr<Shard>(new Shard()));
+  }
+}
+
+void ShardedBookingEngine::setEventSink(BookingEventSink *sink) {
+  eventSink.store(sink);
+  for (auto &shard : shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    for (Flight &flight : shard->flights) {
+      flight.setEventSink(sink);
+    }
+  }
+}
+
+// --- Concurrent Operations ---
+
+bool ShardedBookingEngine::addFlight(const std::string &flightId,
+                                     const std::string &origin,
+                                     const std::string &destination,
+                                     int capacity,
+                                     WaitlistBackend waitlistBackend) {
+  Shard &shard = shardFor(FlightIndex::hashId(flightId));
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  std::pair<FlightHandle, bool> inserted = shard.flights.insert(
+      Flight(flightId, origin, destination, capacity, waitlistBackend));
+  if (inserted.second) {
+    Flight &flight = shard.flights.get(inserted.first);
+    flight.setEventSink(eventSink.load());
+    shard.status.push_back(statusBoard.add(flight));
+  }
+  return inserted.second;
+}
+
+PassengerIdType ShardedBookingEngine::addPassenger(const std::string &name) {
+  return passengers.add(name);
+}
+
+bool ShardedBookingEngine::hasPassenger(PassengerIdType passengerId) const {
+  return passengers.contains(passengerId);
+}
+
+std::string
+ShardedBookingEngine::getPassengerName(PassengerIdType passengerId) const {
+  return passengers.getName(passengerId);
+}
+
+BookingResult ShardedBookingEngine::book(PassengerIdType passengerId,
+                                         const std::string &flightId) {
+  if (!hasPassenger(passengerId)) {
+    return BookingResult::UnknownPassenger;
+  }
+  std::uint32_t hash = FlightIndex::hashId(flightId);
+  Shard &shard = shardFor(hash);
+  // Taken before the lock so the counter is never touched while holding it
+  PriorityType priority =
+      nextBookingPriority.fetch_add(1, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  FlightHandle handle = shard.flights.find(flightId, hash);
+  if (handle == INVALID_FLIGHT_HANDLE) {
+    return BookingResult::UnknownFlight;
+  }
+  BookingResult result = shard.flights.get(handle).book(passengerId, priority);
+  if (changesFlight(result)) {
+    shard.status[handle]->publish(shard.flights.get(handle));
+  }
+  return result;
+}
+
+BookingResult ShardedBookingEngine::cancel(PassengerIdType passengerId,
+                                           const std::string &flightId) {
+  if (!hasPassenger(passengerId)) {
+    return BookingResult::UnknownPassenger;
+  }
+  std::uint32_t hash = FlightIndex::hashId(flightId);
+  Shard &shard = shardFor(hash);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  FlightHandle handle = shard.flights.find(flightId, hash);
+  if (handle == INVALID_FLIGHT_HANDLE) {
+    return BookingResult::UnknownFlight;
+  }
+  BookingResult result = shard.flights.get(handle).cancel(passengerId);
+  if (changesFlight(result)) {
+    shard.status[handle]->publish(shard.flights.get(handle));
+  }
+  return result;
+}
+
+std::vector<BookingResult>
+ShardedBookingEngine::bookBatch(const std::vector<BookingRequest> &requests) {
+  for (const BookingRequest &request : requests) {
+    requireValidTier(request.tier);
+  }
+  std::vector<BookingResult> results(requests.size(),
+                                     BookingResult::UnknownFlight);
+  const PriorityType basePriority = nextBookingPriority.fetch_add(
+      static_cast<PriorityType>(requests.size()), std::memory_order_relaxed);
+
+  std::size_t first = 0;
+  while (first < requests.size()) {
+    const std::string &flightId = requests[first].flightId;
+    std::size_t last = first + 1;
+    while (last < requests.size() && requests[last].flightId == flightId) {
+      ++last;
+    }
+    std::uint32_t hash = FlightIndex::hashId(flightId);
+    Shard &shard = shardFor(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    FlightHandle handle = shard.flights.find(flightId, hash);
+    if (handle != INVALID_FLIGHT_HANDLE) {
+      Flight &flight = shard.flights.get(handle);
+      bool changed = false;
+      for (std::size_t idx = first; idx < last; ++idx) {
+        PassengerIdType passengerId = requests[idx].passengerId;
+        results[idx] =
+            hasPassenger(passengerId)
+                ? flight.book(passengerId,
+                              makePriority(requests[idx].tier,
+                                           basePriority +
+                                               static_cast<PriorityType>(idx)))
+                : BookingResult::UnknownPassenger;
+        changed = changed || changesFlight(results[idx]);
+      }
+      if (changed) {
+        shard.status[handle]->publish(flight); // Once per run
+      }
+    }
+    first = last;
+  }
+  return results;
+}
+
+std::vector<BookingResult>
+ShardedBookingEngine::cancelBatch(const std::vector<BookingRequest> &requests) {
+  std::vector<BookingResult> results(requests.size(),
+                                     BookingResult::UnknownFlight);
+  std::size_t first = 0;
+  while (first < requests.size()) {
+    const std::string &flightId = requests[first].flightId;
+    std::size_t last = first + 1;
+    while (last < requests.size() && requests[last].flightId == flightId) {
+      ++last;
+    }
+    std::uint32_t hash = FlightIndex::hashId(flightId);
+    Shard &shard = shardFor(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    FlightHandle handle = shard.flights.find(flightId, hash);
+    if (handle != INVALID_FLIGHT_HANDLE) {
+      Flight &flight = shard.flights.get(handle);
+      bool changed = false;
+      for (std::size_t idx = first; idx < last; ++idx) {
+        PassengerIdType passengerId = requests[idx].passengerId;
+        results[idx] = hasPassenger(passengerId)
+                           ? flight.cancel(passengerId)
+                           : BookingResult::UnknownPassenger;
+        changed = changed || changesFlight(results[idx]);
+      }
+      if (changed) {
+        shard.status[handle]->publish(flight);
+      }
+    }
+    first = last;
+  }
+  return results;
+}
+
+ItineraryResult
+ShardedBookingEngine::bookItinerary(PassengerIdType passengerId,
+                                    const std::vector<std::string> &flightIds) {
+  requireDistinctLegs(flightIds);
+  if (!hasPassenger(passengerId)) {
+    return ItineraryResult(BookingResult::UnknownPassenger,
+                           ItineraryResult::NO_LEG);
+  }
+  const PriorityType priority =
+      nextBookingPriority.fetch_add(1, std::memory_order_relaxed);
+
+  std::vector<std::uint32_t> hashes;
+  std::vector<std::size_t> order; // Each involved shard once, ascending
+  hashes.reserve(flightIds.size());
+  order.reserve(flightIds.size());
+  for (const std::string &flightId : flightIds) {
+    hashes.push_back(FlightIndex::hashId(flightId));
+    order.push_back(shardIndex(hashes.back()));
+  }
+  std::sort(order.begin(), order.end());
+  order.erase(std::unique(order.begin(), order.end()), order.end());
+  std::vector<std::unique_lock<std::mutex>> locks;
+  locks.reserve(order.size());
+  for (std::size_t index : order) {
+    locks.emplace_back(shards[index]->mutex);
+  }
+
+  // Check every leg, then sell them all; the locks keep the checks true
+  std::vector<FlightHandle> handles(flightIds.size());
+  for (std::size_t leg = 0; leg < flightIds.size(); ++leg) {
+    Shard &shard = shardFor(hashes[leg]);
+    handles[leg] = shard.flights.find(flightIds[leg], hashes[leg]);
+    if (handles[leg] == INVALID_FLIGHT_HANDLE) {
+      return ItineraryResult(BookingResult::UnknownFlight, leg);
+    }
+    BookingResult result =
+        shard.flights.get(handles[leg]).checkSeat(passengerId);
+    if (result != BookingResult::Confirmed) {
+      return ItineraryResult(result, leg);
+    }
+  }
+  for (std::size_t leg = 0; leg < flightIds.size(); ++leg) {
+    Shard &shard = shardFor(hashes[leg]);
+    Flight &flight = shard.flights.get(handles[leg]);
+    flight.book(passengerId, priority);
+    shard.status[handles[leg]]->publish(flight);
+  }
+  return ItineraryResult();
+}
+
+// --- Seat Holds ---
+
+BookingResult ShardedBookingEngine::holdSeat(PassengerIdType passengerId,
+                                             const std::string &flightId,
+                                             std::chrono::milliseconds duration) {
+  if (!hasPassenger(passengerId)) {
+    return BookingResult::UnknownPassenger;
+  }
+  std::uint32_t hash = FlightIndex::hashId(flightId);
+  const std::size_t index = shardIndex(hash);
+  Shard &shard = *shards[index];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  FlightHandle handle = shard.flights.find(flightId, hash);
+  if (handle == INVALID_FLIGHT_HANDLE) {
+    return BookingResult::UnknownFlight;
+  }
+  Flight &flight = shard.flights.get(handle);
+  BookingResult result = flight.holdSeat(passengerId);
+  if (result == BookingResult::Held) {
+    shard.status[handle]->publish(flight);
+    std::lock_guard<std::mutex> holdsLock(holdsMutex);
+    holds.add(holdKey(index, handle), passengerId,
+              SeatHolds::Clock::now() + duration);
+  }
+  return result;
+}
+
+BookingResult ShardedBookingEngine::confirmHold(PassengerIdType passengerId,
+                                                const std::string &flightId) {
+  if (!hasPassenger(passengerId)) {
+    return BookingResult::UnknownPassenger;
+  }
+  std::uint32_t hash = FlightIndex::hashId(flightId);
+  const std::size_t index = shardIndex(hash);
+  Shard &shard = *shards[index];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  FlightHandle handle = shard.flights.find(flightId, hash);
+  if (handle == INVALID_FLIGHT_HANDLE) {
+    return BookingResult::UnknownFlight;
+  }
+  Flight &flight = shard.flights.get(handle);
+  BookingResult result = flight.confirmHold(passengerId);
+  if (result == BookingResult::Confirmed) {
+    shard.status[handle]->publish(flight);
+    std::lock_guard<std::mutex> holdsLock(holdsMutex);
+    holds.remove(holdKey(index, handle), passengerId);
+  }
+  return result;
+}
+
+BookingResult ShardedBookingEngine::releaseHold(PassengerIdType passengerId,
+                                                const std::string &flightId) {
+  if (!hasPassenger(passengerId)) {
+    return BookingResult::UnknownPassenger;
+  }
+  std::uint32_t hash = FlightIndex::hashId(flightId);
+  const std::size_t index = shardIndex(hash);
+  Shard &shard = *shards[index];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  FlightHandle handle = shard.flights.find(flightId, hash);
+  if (handle == INVALID_FLIGHT_HANDLE) {
+    return BookingResult::UnknownFlight;
+  }
+  Flight &flight = shard.flights.get(handle);
+  BookingResult result = flight.releaseHold(passengerId);
+  if (result == BookingResult::HoldReleased) {
+    shard.status[handle]->publish(flight);
+    std::lock_guard<std::mutex> holdsLock(holdsMutex);
+    holds.remove(holdKey(index, handle), passengerId);
+  }
+  return result;
+}
+
+std::size_t
+ShardedBookingEngine::expireHolds(SeatHolds::Clock::time_point now) {
+  std::vector<std::pair<std::uint64_t, PassengerIdType>> expired;
+  {
+    std::lock_guard<std::mutex> holdsLock(holdsMutex);
+    holds.expire(now, [&expired](std::uint64_t key,
+                                 PassengerIdType passengerId) {
+      expired.emplace_back(key, passengerId);
+    });
+  }
+  // Released outside holdsMutex, which ranks below the shard locks. In the
+  // gap the hold may have been confirmed (releaseHold() then finds
+  // nothing) or released and taken again, with a new deadline, which is
+  // why holds is checked once more under the shard lock.
+  std::size_t released = 0;
+  for (const auto &hold : expired) {
+    Shard &shard = *shards[static_cast<std::size_t>(hold.first >> 32)];
+    const FlightHandle handle = static_cast<FlightHandle>(hold.first);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    {
+      std::lock_guard<std::mutex> holdsLock(holdsMutex);
+      if (holds.contains(hold.first, hold.second)) {
+        continue;
+      }
+    }
+    Flight &flight = shard.flights.get(handle);
+    if (flight.releaseHold(hold.second) == BookingResult::HoldReleased) {
+      shard.status[handle]->publish(flight);
+      ++released;
+    }
+  }
+  return released;
+}
+
+std::size_t ShardedBookingEngine::getHoldCount() const {
+  std::lock_guard<std::mutex> holdsLock(holdsMutex);
+  return holds.size();
+}
+
+// --- Lock-Free Reads ---
+
+bool ShardedBookingEngine::readStatus(const std::string &flightId,
+                                      FlightCounters &counters) const {
+  const StatusCell *cell =
+      statusBoard.find(flightId, FlightIndex::hashId(flightId));
+  if (cell == nullptr) {
+    return false;
+  }
+  counters = cell->read();
+  return true;
+}
+
+bool ShardedBookingEngine::queryFlight(const std::string &flightId,
+                                       FlightStatus &status) const {
+  const StatusCell *cell =
+      statusBoard.find(flightId, FlightIndex::hashId(flightId));
+  if (cell == nullptr) {
+    return false;
+  }
+  FlightCounters counters = cell->read();
+  status.flightId = cell->getFlightId().str();
+  status.origin = cell->getOrigin().str();
+  status.destination = cell->getDestination().str();
+  status.capacity = counters.capacity;
+  status.booked = counters.booked;
+  status.waitlisted = counters.waitlisted;
+  status.held = counters.held;
+  return true;
+}
+
+unsigned ShardedBookingEngine::getShardCount() const {
+  return static_cast<unsigned>(shards.size());
+}
+
+std::size_t ShardedBookingEngine::getFlightCount() const {
+  std::size_t total = 0;
+  for (const auto &shard : shards) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    total += shard->flights.size();
+  }
+  return total;
+}
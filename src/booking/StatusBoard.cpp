@@ -0,0 +1,129 @@
+// src/booking/StatusBoard.cpp
+#include "booking/StatusBoard.h"
+#include "booking/FlightIndex.h" // For FlightIndex::hashId
+#include <thread>                // For std::this_thread::yield
+
+// --- StatusCell ---
+
+StatusCell::StatusCell(const Flight &flight)
+    : flightId(flight.getFlightId()), origin(flight.getOrigin()),
+      destination(flight.getDestination()),
+      hash(FlightIndex::hashId(flight.getFlightId())), sequence(0),
+      capacity(0), booked(0), waitlisted(0), held(0),
+      nextWaitlistedId(INVALID_PASSENGER_ID),
+      nextWaitlistedPriority(MAX_PRIORITY) {
+  publish(flight);
+}
+
+void StatusCell::publish(const Flight &flight) {
+  const Waitlist &waitlist = flight.getWaitlist();
+  const bool anyWaiting = !waitlist.isEmpty();
+  const std::uint64_t start = sequence.load(std::memory_order_relaxed);
+  sequence.store(start + 1, std::memory_order_relaxed);
+  // Keeps the stores below from moving above the odd sequence
+  std::atomic_thread_fence(std::memory_order_release);
+  capacity.store(flight.getCapacity(), std::memory_order_relaxed);
+  booked.store(flight.getBookedCount(), std::memory_order_relaxed);
+  waitlisted.store(flight.getWaitlistCount(), std::memory_order_relaxed);
+  held.store(flight.getHeldCount(), std::memory_order_relaxed);
+  nextWaitlistedId.store(anyWaiting ? waitlist.findMinPassengerId()
+                                    : INVALID_PASSENGER_ID,
+                         std::memory_order_relaxed);
+  nextWaitlistedPriority.store(
+      anyWaiting ? waitlist.findMinPriority() : MAX_PRIORITY,
+      std::memory_order_relaxed);
+  sequence.store(start + 2, std::memory_order_release);
+}
+
+FlightCounters StatusCell::read() const {
+  FlightCounters counters;
+  for (;;) {
+    const std::uint64_t before = sequence.load(std::memory_order_acquire);
+    if (before & 1) {
+      // A publish is a handful of stores, but its writer may have been
+      // preempted in the middle
+      std::this_thread::yield();
+      continue;
+    }
+    counters.capacity = capacity.load(std::memory_order_relaxed);
+    counters.booked = booked.load(std::memory_order_relaxed);
+    counters.waitlisted = waitlisted.load(std::memory_order_relaxed);
+    counters.held = held.load(std::memory_order_relaxed);
+    counters.nextWaitlistedId =
+        nextWaitlistedId.load(std::memory_order_relaxed);
+    counters.nextWaitlistedPriority =
+        nextWaitlistedPriority.load(std::memory_order_relaxed);
+    // Keeps the loads above from moving below the second sequence read
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence.load(std::memory_order_relaxed) == before) {
+      counters.version = before / 2;
+      return counters;
+    }
+  }
+}
+
+const FlightCode &StatusCell::getFlightId() const { return flightId; }
+const FlightCode &StatusCell::getOrigin() const { return origin; }
+const FlightCode &StatusCell::getDestination() const { return destination; }
+std::uint32_t StatusCell::getHash() const { return hash; }
+
+// --- StatusBoard ---
+
+StatusBoard::Table::Table(std::size_t slotCount)
+    : slots(new std::atomic<StatusCell *>[slotCount]),
+      mask(static_cast<std::uint32_t>(slotCount - 1)) {
+  for (std::size_t i = 0; i < slotCount; ++i) {
+    slots[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+void StatusBoard::Table::insert(StatusCell *cell) {
+  std::uint32_t pos = cell->getHash() & mask;
+  while (slots[pos].load(std::memory_order_relaxed) != nullptr) {
+    pos = (pos + 1) & mask;
+  }
+  // Release: a reader that finds the pointer also sees the whole cell
+  slots[pos].store(cell, std::memory_order_release);
+}
+
+StatusBoard::StatusBoard() : current(nullptr) {
+  tables.push_back(std::unique_ptr<Table>(new Table(64)));
+  current.store(tables.back().get(), std::memory_order_release);
+}
+
+StatusCell *StatusBoard::add(const Flight &flight) {
+  std::lock_guard<std::mutex> lock(writerMutex);
+  cells.push_back(std::unique_ptr<StatusCell>(new StatusCell(flight)));
+  StatusCell *cell = cells.back().get();
+  Table *table = tables.back().get();
+  if (2 * cells.size() > static_cast<std::size_t>(table->mask) + 1) {
+    // Load factor above 1/2: fill a doubled table off to the side, then
+    // switch readers over in one store
+    tables.push_back(std::unique_ptr<Table>(
+        new Table(2 * (static_cast<std::size_t>(table->mask) + 1))));
+    table = tables.back().get();
+    for (const std::unique_ptr<StatusCell> &existing : cells) {
+      table->insert(existing.get());
+    }
+    current.store(table, std::memory_order_release);
+  } else {
+    table->insert(cell);
+  }
+  return cell;
+}
+
+const StatusCell *StatusBoard::find(StringRef flightId,
+                                    std::uint32_t hash) const {
+  const Table *table = current.load(std::memory_order_acquire);
+  std::uint32_t pos = hash & table->mask;
+  for (;;) {
+    const StatusCell *cell = table->slots[pos].load(std::memory_order_acquire);
+    if (cell == nullptr) {
+      return nullptr;
+    }
+    if (cell->getHash() == hash && StringRef(cell->getFlightId()) == flightId) {
+      return cell;
+    }
+    pos = (pos + 1) & table->mask;
+  }
+}
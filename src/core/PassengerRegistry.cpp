@@ -0,0 +1,23 @@
+// src/core/PassengerRegistry.cpp
+#include "core/PassengerRegistry.h"
+
+PassengerRegistry::PassengerRegistry() : table(1), nextId(1) {}
+
+PassengerIdType PassengerRegistry::add(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex);
+  PassengerIdType id = table.add(name);
+  // Publish the record only after it is complete
+  nextId.store(id + 1, std::memory_order_release);
+  return id;
+}
+
+bool PassengerRegistry::contains(PassengerIdType passengerId) const {
+  return passengerId >= 1 &&
+         passengerId < nextId.load(std::memory_order_acquire);
+}
+
+std::string PassengerRegistry::getName(PassengerIdType passengerId) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return table.contains(passengerId) ? table.getName(passengerId)
+                                     : std::string();
+}
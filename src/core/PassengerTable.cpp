@@ -0,0 +1,70 @@
+// src/core/PassengerTable.cpp
+#include "core/PassengerTable.h"
+
+std::size_t PassengerTable::indexOf(PassengerIdType id) const {
+  return static_cast<std::size_t>(id - firstId);
+}
+
+PassengerTable::PassengerTable(PassengerIdType first)
+    : firstId(first), nameOffsets(1, 0) {}
+
+PassengerIdType PassengerTable::add(StringRef name) {
+  PassengerIdType id = nextId();
+  nameArena.append(name.data, name.size);
+  nameOffsets.push_back(nameArena.size());
+  return id;
+}
+
+bool PassengerTable::contains(PassengerIdType id) const {
+  return id >= firstId && indexOf(id) < size();
+}
+
+PassengerIdType PassengerTable::nextId() const {
+  return firstId + static_cast<PassengerIdType>(size());
+}
+
+const char *PassengerTable::nameData(PassengerIdType id) const {
+  return nameArena.data() + nameOffsets[indexOf(id)];
+}
+
+std::size_t PassengerTable::nameLength(PassengerIdType id) const {
+  std::size_t i = indexOf(id);
+  return static_cast<std::size_t>(nameOffsets[i + 1] - nameOffsets[i]);
+}
+
+std::string PassengerTable::getName(PassengerIdType id) const {
+  return std::string(nameData(id), nameLength(id));
+}
+
+void PassengerTable::writeName(std::ostream &os, PassengerIdType id) const {
+  os.write(nameData(id), static_cast<std::streamsize>(nameLength(id)));
+}
+
+Passenger PassengerTable::get(PassengerIdType id) const {
+  return Passenger(id, getName(id));
+}
+
+PassengerIdType PassengerTable::getFirstId() const { return firstId; }
+const std::uint64_t *PassengerTable::getNameOffsets() const {
+  return nameOffsets.data();
+}
+const char *PassengerTable::getNameArena() const { return nameArena.data(); }
+std::size_t PassengerTable::getNameArenaSize() const {
+  return nameArena.size();
+}
+
+void PassengerTable::assign(PassengerIdType first,
+                            const std::uint64_t *offsets, std::size_t count,
+                            const char *arena) {
+  firstId = first;
+  nameOffsets.assign(offsets, offsets + count + 1);
+  nameArena.assign(arena, static_cast<std::size_t>(offsets[count]));
+}
+
+void PassengerTable::reserve(std::size_t records, std::size_t nameBytes) {
+  nameOffsets.reserve(records + 1);
+  nameArena.reserve(nameBytes);
+}
+
+std::size_t PassengerTable::size() const { return nameOffsets.size() - 1; }
+bool PassengerTable::empty() const { return size() == 0; }
@@ -1,14 +1,23 @@
 // src/heap/BinomialHeap.cpp
 #include "heap/BinomialHeap.h"
-#include <algorithm>
-#include <cmath> // <--- ADD THIS INCLUDE for log2
+#include "metrics/Metrics.h"
+#include <algorithm> // For push_heap/pop_heap
+#include <exception> // For std::exception_ptr
+#include <thread>
 #include <utility>
 #include <vector>
 
 // --- Private Helper Method Implementations ---
-// ... (rest of the file remains the same initially) ...
 
-// --- Private Helper Method Implementations ---
+#ifdef BOOKING_METRICS
+static std::uint64_t countRoots(const BinomialHeapNode *head) {
+  std::uint64_t roots = 0;
+  for (; head != nullptr; head = head->sibling) {
+    ++roots;
+  }
+  return roots;
+}
+#endif
 
 void BinomialHeap::link(BinomialHeapNode *y, BinomialHeapNode *z) {
   y->parent = z;
@@ -17,273 +26,570 @@ void BinomialHeap::link(BinomialHeapNode *y, BinomialHeapNode *z) {
   z->degree++;
 }
 
-void BinomialHeap::mergeRootLists(BinomialHeap &other_heap) {
-  auto it1 = roots.begin();
-  auto it2 = other_heap.roots.begin();
-  std::list<BinomialHeapNode *> new_roots;
-
-  while (it1 != roots.end() && it2 != other_heap.roots.end()) {
-    if ((*it1)->degree <= (*it2)->degree) {
-      new_roots.push_back(*it1);
-      it1++;
+void BinomialHeap::mergeRootLists(BinomialHeapNode *other_head) {
+  // Standard merge of two degree-sorted singly linked chains
+  BinomialHeapNode dummy(0, INVALID_PASSENGER_ID);
+  BinomialHeapNode *tail = &dummy;
+  BinomialHeapNode *a = head;
+  BinomialHeapNode *b = other_head;
+
+  while (a != nullptr && b != nullptr) {
+    if (a->degree <= b->degree) {
+      tail->sibling = a;
+      a = a->sibling;
     } else {
-      new_roots.push_back(*it2);
-      it2++;
+      tail->sibling = b;
+      b = b->sibling;
     }
+    tail = tail->sibling;
   }
   // Append remaining nodes
-  while (it1 != roots.end()) {
-    new_roots.push_back(*it1);
-    it1++;
-  }
-  while (it2 != other_heap.roots.end()) {
-    new_roots.push_back(*it2);
-    it2++;
-  }
+  tail->sibling = (a != nullptr) ? a : b;
 
-  roots = std::move(new_roots); // Replace old root list
-  other_heap.roots.clear();     // Other heap is now empty
+  head = dummy.sibling; // Replace old root list
 }
 
 void BinomialHeap::consolidate() {
-  if (roots.size() <= 1) {
+  if (head == nullptr) {
     return;
   }
-
-  // Max possible degree can be estimated, log2(n). Using roots.size()+1 is
-  // safe. Calculate a reasonable upper bound for degrees needed.
-  int max_degree_possible = 0;
-  if (!roots.empty()) {
-    int n = getSize(); // Need getSize() to be somewhat reliable or estimate
-                       // based on roots size
-    max_degree_possible =
-        static_cast<int>(log2(n > 0 ? n : 1)) + 2; // Add buffer
+  METRIC_RECORD(ValueMetric::HeapRootListLength, countRoots(head));
+  METRIC_TIMER(timer, LatencyMetric::HeapConsolidate);
+
+  // The root chain is sorted by degree, so a single pass suffices: at most
+  // three consecutive roots can share a degree after a merge. When they do,
+  // the first one is skipped so that carries propagate like a binary add.
+  BinomialHeapNode *prev = nullptr;
+  BinomialHeapNode *current = head;
+  BinomialHeapNode *next = current->sibling;
+
+  while (next != nullptr) {
+    if (current->degree != next->degree ||
+        (next->sibling != nullptr &&
+         next->sibling->degree == current->degree)) {
+      prev = current;
+      current = next;
+    } else if (!before(next, current)) {
+      // Remember: Lower priority value means higher actual priority
+      current->sibling = next->sibling;
+      link(next, current);
+      if (minNode == next)
+        minNode = current; // Tie: the surviving root is just as small
+    } else {
+      if (prev == nullptr) {
+        head = next;
+      } else {
+        prev->sibling = next;
+      }
+      link(current, next);
+      if (minNode == current)
+        minNode = next;
+      current = next;
+    }
+    next = current->sibling;
   }
-  if (max_degree_possible < 5)
-    max_degree_possible = 5; // Minimum size
+}
 
-  std::vector<BinomialHeapNode *> degree_table(max_degree_possible, nullptr);
+void BinomialHeap::carryHead() {
+  while (head->sibling != nullptr && head->degree == head->sibling->degree) {
+    BinomialHeapNode *first = head;
+    BinomialHeapNode *second = head->sibling;
+    BinomialHeapNode *rest = second->sibling;
+    // Same tie rule as consolidate(): on equal keys the root ahead in the
+    // chain survives, which here is the carry holding the new node
+    if (before(second, first)) {
+      link(first, second);
+      head = second;
+      if (minNode == first)
+        minNode = second;
+    } else {
+      link(second, first);
+      head = first;
+      if (minNode == second)
+        minNode = first;
+    }
+    head->sibling = rest;
+  }
+}
 
-  std::list<BinomialHeapNode *> new_root_list;
-  auto it = roots.begin();
+void BinomialHeap::consolidatePendingRoots() {
+  hasPendingRoots = false;
+  if (head == nullptr || head->sibling == nullptr) {
+    return;
+  }
+  METRIC_RECORD(ValueMetric::HeapRootListLength, countRoots(head));
+  METRIC_TIMER(timer, LatencyMetric::HeapConsolidateLazy);
+
+  // Bucket roots by degree, linking on collision like a binary carry.
+  // Lazy roots can outnumber log2(n), so the table is sized from 'size'.
+  std::size_t max_degree = 1;
+  while ((static_cast<std::size_t>(1) << max_degree) <=
+         static_cast<std::size_t>(size)) {
+    max_degree++;
+  }
+  if (degreeTable.capacity() <= max_degree) {
+    METRIC_INCREMENT(CounterMetric::HeapDegreeTableResizes);
+  }
+  degreeTable.assign(max_degree + 1, nullptr);
 
-  while (it != roots.end()) {
-    BinomialHeapNode *current = *it;
+  BinomialHeapNode *current = head;
+  while (current != nullptr) {
+    BinomialHeapNode *next = current->sibling;
+    current->sibling = nullptr;
     int d = current->degree;
-
-    // Check if another tree with the same degree exists in the table
-    while (static_cast<size_t>(d) < degree_table.size() &&
-           degree_table[d] != nullptr) {
-      BinomialHeapNode *other = degree_table[d];
-
-      // Ensure 'current' has the smaller key (or equal), swap pointers if
-      // necessary Remember: Lower priority value means higher actual priority
-      if (other->priority < current->priority) {
+    while (degreeTable[d] != nullptr) {
+      BinomialHeapNode *other = degreeTable[d];
+      degreeTable[d] = nullptr;
+      // Remember: Lower priority value means higher actual priority
+      if (before(other, current)) {
         std::swap(current, other);
       }
-
-      // Now link 'other' under 'current'. 'other' must be removed from table.
       link(other, current);
-      degree_table[d] = nullptr; // Clear the slot as we've merged from it
-      d++; // Degree of 'current' increased, check next degree slot
-    }
-
-    // Place the resulting tree (potentially merged) in the table
-    // Resize table if necessary (should be rare if initial estimate is good)
-    if (static_cast<size_t>(d) >= degree_table.size()) {
-      degree_table.resize(d + 1, nullptr);
+      d++;
     }
-    degree_table[d] = current;
-
-    it++; // Move to the next node in the original root list
+    degreeTable[d] = current;
+    current = next;
   }
 
-  // Rebuild the root list from the degree table
-  roots.clear();
-  for (BinomialHeapNode *node : degree_table) {
+  // Rebuild the chain in increasing degree order, picking up the minimum
+  // on the way (a tie may have linked the old minimum under another root)
+  BinomialHeapNode **tail = &head;
+  minNode = nullptr;
+  for (BinomialHeapNode *node : degreeTable) {
     if (node != nullptr) {
-      // Reset parent pointer for root nodes before adding
-      node->parent = nullptr;
-      roots.push_back(node);
+      *tail = node;
+      tail = &node->sibling;
+      if (minNode == nullptr || before(node, minNode))
+        minNode = node;
     }
   }
-  // Ensure roots are sorted by degree (optional but conventional)
-  roots.sort([](const BinomialHeapNode *a, const BinomialHeapNode *b) {
-    return a->degree < b->degree;
-  });
+  *tail = nullptr;
 }
 
-std::list<BinomialHeapNode *>::const_iterator
-BinomialHeap::findMinNodeIterator() const {
-  if (roots.empty()) {
-    return roots.cend(); // Use const iterator end
+BinomialHeapNode *
+BinomialHeap::findRootPredecessor(BinomialHeapNode *root) const {
+  BinomialHeapNode *prev = nullptr;
+  for (BinomialHeapNode *it = head; it != root; it = it->sibling) {
+    prev = it;
   }
-  auto min_it = roots.cbegin(); // Use const iterator begin
-  for (auto it = std::next(roots.cbegin()); it != roots.cend(); ++it) {
-    // Lower priority value means higher actual priority
-    if ((*it)->priority < (*min_it)->priority) {
-      min_it = it;
+  return prev;
+}
+
+void BinomialHeap::recomputeMin() {
+  minNode = head;
+  if (head != nullptr) {
+    for (BinomialHeapNode *it = head->sibling; it != nullptr;
+         it = it->sibling) {
+      // Lower priority value means higher actual priority
+      if (before(it, minNode)) {
+        minNode = it;
+      }
     }
   }
-  return min_it; // Returns a const_iterator
 }
 
-void BinomialHeap::collectNodes(BinomialHeapNode *node,
-                                std::vector<BinomialHeapNode *> &nodes_list) {
-  if (node == nullptr)
-    return;
-  // Use iterative approach to avoid deep recursion stack
-  std::vector<BinomialHeapNode *> q;
-  q.push_back(node);
-  while (!q.empty()) {
-    BinomialHeapNode *current = q.back();
-    q.pop_back();
-    nodes_list.push_back(current);
-    if (current->child)
-      q.push_back(current->child);
-    if (current->sibling)
-      q.push_back(current->sibling); // Collect siblings as well
-  }
-  // The initial call should iterate through roots and call this for each root's
-  // children/siblings. Let's refine clear() instead.
+void BinomialHeap::swapWithParent(BinomialHeapNode *node) {
+  BinomialHeapNode *parent = node->parent;
+  std::swap(node->priority, parent->priority);
+  std::swap(node->passengerId, parent->passengerId);
+  std::swap(node->handle, parent->handle);
+  // Keep the handle cells pointing at whatever node now carries their entry
+  if (node->handle != nullptr)
+    node->handle->node = node;
+  if (parent->handle != nullptr)
+    parent->handle->node = parent;
 }
 
-// --- Constructor / Destructor / Move Operations ---
+void BinomialHeap::removeRoot(BinomialHeapNode *root, BinomialHeapNode *prev) {
+  // Unlink the root from the root chain
+  if (prev == nullptr) {
+    head = root->sibling;
+  } else {
+    prev->sibling = root->sibling;
+  }
+  size--;
 
-BinomialHeap::BinomialHeap() = default; // Empty heap
+  // Children are chained in decreasing degree; reverse them into a
+  // degree-sorted chain that can be merged back into the roots
+  BinomialHeapNode *children = nullptr;
+  BinomialHeapNode *child = root->child;
+  while (child != nullptr) {
+    BinomialHeapNode *next_sibling = child->sibling; // Store next sibling
+    child->parent = nullptr;                         // Reset parent
+    child->sibling = children;
+    children = child;
+    child = next_sibling;
+  }
 
-BinomialHeap::~BinomialHeap() { clear(); }
+  // Merge the children back into the main heap
+  mergeRootLists(children);
+  consolidate();
+  recomputeMin(); // O(log n) roots once consolidated
 
-void BinomialHeap::clear() {
-  std::vector<BinomialHeapNode *> nodes_to_delete;
-  std::vector<BinomialHeapNode *> q;
+  if (root->handle != nullptr)
+    handlePool.destroy(root->handle);
+  pool.destroy(root); // Slot goes back to the pool's free list
+}
 
-  // Start with all root nodes
-  for (auto *root : roots) {
-    if (root)
-      q.push_back(root);
+BinomialHeapNode *BinomialHeap::buildTree(const Entry *entries, int order,
+                                          Handle *handles) {
+  if (order == 0) {
+    BinomialHeapNode *node = pool.create(entries->first, entries->second);
+    node->handle = handlePool.create(node);
+    *handles = node->handle;
+    return node;
   }
-  roots.clear(); // Clear the list itself
-
-  // Iteratively traverse all reachable nodes
-  while (!q.empty()) {
-    BinomialHeapNode *current = q.back();
-    q.pop_back();
-    nodes_to_delete.push_back(current); // Mark for deletion
+  const std::size_t half = static_cast<std::size_t>(1) << (order - 1);
+  BinomialHeapNode *a = buildTree(entries, order - 1, handles);
+  BinomialHeapNode *b = buildTree(entries + half, order - 1, handles + half);
+  // Lower priority value wins; on a tie the earlier entry stays on top
+  if (before(b, a)) {
+    std::swap(a, b);
+  }
+  link(b, a);
+  return a;
+}
 
-    // Add children and siblings to the queue
-    if (current->child)
-      q.push_back(current->child);
-    if (current->sibling)
-      q.push_back(current->sibling);
+BinomialHeapNode *BinomialHeap::buildRootChain(const Entry *entries,
+                                               std::size_t count,
+                                               Handle *handles) {
+  BinomialHeapNode *chain = nullptr;
+  BinomialHeapNode **tail = &chain;
+  std::size_t offset = 0;
+  for (int order = 0; (count >> order) != 0; ++order) {
+    if (((count >> order) & 1) != 0) {
+      BinomialHeapNode *tree =
+          buildTree(entries + offset, order, handles + offset);
+      *tail = tree;
+      tail = &tree->sibling;
+      offset += static_cast<std::size_t>(1) << order;
+    }
   }
+  return chain;
+}
+
+BinomialHeap BinomialHeap::buildRange(const Entry *entries, std::size_t count,
+                                      Handle *handles, InsertMode mode) {
+  BinomialHeap heap(mode);
+  heap.head = heap.buildRootChain(entries, count, handles);
+  heap.size = static_cast<int>(count);
+  heap.recomputeMin();
+  return heap;
+}
 
-  // Delete all collected nodes
-  for (BinomialHeapNode *node : nodes_to_delete) {
-    delete node;
+void BinomialHeap::meld(BinomialHeap &&other) {
+  if (this == &other || other.head == nullptr) {
+    return;
+  }
+  if (hasPendingRoots) {
+    consolidatePendingRoots();
   }
+  if (other.hasPendingRoots) {
+    other.consolidatePendingRoots();
+  }
+  pool.adopt(std::move(other.pool));
+  handlePool.adopt(std::move(other.handlePool));
+  mergeRootLists(other.head);
+  size += other.size;
+  consolidate();
+  recomputeMin();
+  other.head = nullptr;
+  other.minNode = nullptr;
+  other.size = 0;
+}
+
+// --- Constructor / Destructor / Move Operations ---
+
+BinomialHeap::BinomialHeap(InsertMode mode)
+    : head(nullptr), minNode(nullptr), hasPendingRoots(false), size(0),
+      insertMode(mode) {} // Empty heap
+
+BinomialHeap::~BinomialHeap() = default; // Pool frees all slabs
+
+void BinomialHeap::clear() {
+  // Every node lives in the pool, so there is nothing to walk: drop them all
+  // at once and keep the slabs around for the next burst of inserts.
+  head = nullptr;
+  minNode = nullptr;
+  hasPendingRoots = false;
+  size = 0;
+  pool.reset();
+  handlePool.reset();
 }
 
 BinomialHeap::BinomialHeap(BinomialHeap &&other) noexcept
-    : roots(std::move(other.roots)) {
-  // 'other' is left in a valid, empty state by std::list move constructor
+    : head(other.head), minNode(other.minNode),
+      hasPendingRoots(other.hasPendingRoots), size(other.size),
+      insertMode(other.insertMode), pool(std::move(other.pool)),
+      handlePool(std::move(other.handlePool)) {
+  // Node addresses are stable across a pool move, 'other' is left empty
+  other.head = nullptr;
+  other.minNode = nullptr;
+  other.hasPendingRoots = false;
+  other.size = 0;
 }
 
 BinomialHeap &BinomialHeap::operator=(BinomialHeap &&other) noexcept {
   if (this != &other) {
-    clear();                        // Delete existing nodes
-    roots = std::move(other.roots); // Move ownership
+    head = other.head; // Old nodes are released together with the old pool
+    minNode = other.minNode;
+    hasPendingRoots = other.hasPendingRoots;
+    size = other.size;
+    insertMode = other.insertMode;
+    pool = std::move(other.pool);
+    handlePool = std::move(other.handlePool);
+    other.head = nullptr;
+    other.minNode = nullptr;
+    other.hasPendingRoots = false;
+    other.size = 0;
   }
   return *this;
 }
 
 // --- Public Interface Method Implementations ---
 
-bool BinomialHeap::isEmpty() const { return roots.empty(); }
+bool BinomialHeap::isEmpty() const { return head == nullptr; }
+
+BinomialHeap::Handle BinomialHeap::insert(PriorityType priority,
+                                          PassengerIdType passengerId) {
+  METRIC_TIMER(timer, LatencyMetric::HeapInsert);
+  BinomialHeapNode *new_node = pool.create(priority, passengerId);
+  new_node->handle = handlePool.create(new_node);
+  // A lone degree-0 root goes in front of the chain; carryHead() then
+  // carries it up like incrementing a binary counter, stopping as soon as
+  // the carry stops (amortized O(1)). Lazy mode skips the carry and leaves
+  // it for the next extraction.
+  new_node->sibling = head;
+  head = new_node;
+  size++;
+  if (minNode == nullptr || before(new_node, minNode)) {
+    minNode = new_node;
+  }
+  if (insertMode == InsertMode::Lazy) {
+    hasPendingRoots = true;
+  } else {
+    carryHead();
+  }
+  return new_node->handle; // Linking never moves payloads, still accurate
+}
 
-void BinomialHeap::insert(PriorityType priority, PassengerIdType passengerId) {
-  BinomialHeapNode *new_node = new BinomialHeapNode(priority, passengerId);
-  BinomialHeap temp_heap;
-  temp_heap.roots.push_back(new_node);
-  mergeRootLists(
-      temp_heap); // Merge the new node's heap (now empty) into this heap
-  consolidate();
+void BinomialHeap::insertBatch(
+    const std::vector<std::pair<PriorityType, PassengerIdType>> &entries,
+    std::vector<Handle> &handles_out) {
+  if (entries.empty()) {
+    return;
+  }
+  if (insertMode == InsertMode::Eager) {
+    // Build the batch into trees, then one union with the existing roots
+    const std::size_t first = handles_out.size();
+    handles_out.resize(first + entries.size());
+    mergeRootLists(
+        buildRootChain(entries.data(), entries.size(), &handles_out[first]));
+    size += static_cast<int>(entries.size());
+    consolidate();
+    recomputeMin();
+    return;
+  }
+  handles_out.reserve(handles_out.size() + entries.size());
+  for (const auto &entry : entries) {
+    BinomialHeapNode *new_node = pool.create(entry.first, entry.second);
+    new_node->handle = handlePool.create(new_node);
+    handles_out.push_back(new_node->handle);
+    new_node->sibling = head;
+    head = new_node;
+    if (minNode == nullptr || before(new_node, minNode)) {
+      minNode = new_node;
+    }
+  }
+  size += static_cast<int>(entries.size());
+  hasPendingRoots = true; // Consolidated by the next extraction
+}
+
+BinomialHeap BinomialHeap::buildFrom(const std::vector<Entry> &entries,
+                                     std::vector<Handle> &handles_out,
+                                     InsertMode mode) {
+  const std::size_t first = handles_out.size();
+  handles_out.resize(first + entries.size());
+  return buildRange(entries.data(), entries.size(),
+                    handles_out.data() + first, mode);
+}
+
+BinomialHeap BinomialHeap::buildFromParallel(const std::vector<Entry> &entries,
+                                             std::vector<Handle> &handles_out,
+                                             unsigned threads,
+                                             InsertMode mode) {
+  std::size_t parts = entries.size() / MIN_PARALLEL_ENTRIES;
+  if (parts > threads) {
+    parts = threads;
+  }
+  if (parts <= 1) {
+    return buildFrom(entries, handles_out, mode);
+  }
+  const std::size_t first = handles_out.size();
+  handles_out.resize(first + entries.size());
+  Handle *handles = handles_out.data() + first;
+
+  // Part p covers [bounds[p], bounds[p + 1]); parts write disjoint handles
+  std::vector<std::size_t> bounds(parts + 1);
+  for (std::size_t p = 0; p <= parts; ++p) {
+    bounds[p] = entries.size() * p / parts;
+  }
+  std::vector<BinomialHeap> heaps(parts);
+  std::vector<std::exception_ptr> errors(parts);
+  auto buildPart = [&](std::size_t p) {
+    try {
+      heaps[p] = buildRange(entries.data() + bounds[p],
+                            bounds[p + 1] - bounds[p], handles + bounds[p],
+                            mode);
+    } catch (...) {
+      errors[p] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(parts - 1);
+  for (std::size_t p = 1; p < parts; ++p) {
+    workers.emplace_back(buildPart, p);
+  }
+  buildPart(0); // The calling thread takes the first part
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  for (const std::exception_ptr &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  for (std::size_t p = 1; p < parts; ++p) {
+    heaps[0].meld(std::move(heaps[p]));
+  }
+  return std::move(heaps[0]);
 }
 
 PassengerIdType BinomialHeap::findMinPassengerId() const {
-  auto min_it = findMinNodeIterator();
-  if (min_it == roots.end()) {
+  if (minNode == nullptr) {
     throw std::runtime_error("Heap is empty");
   }
-  return (*min_it)->passengerId;
+  return minNode->passengerId;
 }
 
 PriorityType BinomialHeap::findMinPriority() const {
-  auto min_it = findMinNodeIterator();
-  if (min_it == roots.end()) {
+  if (minNode == nullptr) {
     throw std::runtime_error("Heap is empty");
   }
-  return (*min_it)->priority;
+  return minNode->priority;
 }
 
 PassengerIdType BinomialHeap::extractMin() {
-  auto min_it = findMinNodeIterator();
-  if (min_it == roots.end()) {
+  return extractMinWithPriority().second;
+}
+
+std::pair<PriorityType, PassengerIdType>
+BinomialHeap::extractMinWithPriority() {
+  if (minNode == nullptr) {
     throw std::runtime_error("Cannot extract from empty heap");
   }
+  METRIC_TIMER(timer, LatencyMetric::HeapExtractMin);
+  if (hasPendingRoots) {
+    consolidatePendingRoots(); // removeRoot() needs a degree-sorted chain
+  }
 
-  BinomialHeapNode *min_node = *min_it;
-  roots.erase(min_it); // Remove min node from root list
+  BinomialHeapNode *min_node = minNode;
+  std::pair<PriorityType, PassengerIdType> result(min_node->priority,
+                                                  min_node->passengerId);
+  removeRoot(min_node, findRootPredecessor(min_node));
+  return result;
+}
 
-  // Create a temporary heap with the children of the min node
-  BinomialHeap children_heap;
-  BinomialHeapNode *child = min_node->child;
-  while (child != nullptr) {
-    BinomialHeapNode *next_sibling = child->sibling; // Store next sibling
-    child->parent = nullptr;                         // Reset parent
-    child->sibling = nullptr;                        // Isolate the child
-    // Children list needs to be reversed when adding to roots
-    children_heap.roots.push_front(child);
-    child = next_sibling;
+void BinomialHeap::decreaseKey(Handle handle, PriorityType newPriority) {
+  BinomialHeapNode *node = handle->node;
+  if (KeyLess()(node->priority, newPriority)) {
+    throw std::invalid_argument("decreaseKey: new priority is worse");
+  }
+  node->priority = newPriority;
+  // Sift up along the parent chain, at most one step per tree level
+  while (node->parent != nullptr && before(node, node->parent)) {
+    swapWithParent(node);
+    node = node->parent;
+  }
+  if (node->parent == nullptr && before(node, minNode)) {
+    minNode = node; // Reached the root list with a new overall minimum
   }
+}
 
-  // Merge the children heap back into the main heap
-  mergeRootLists(children_heap);
-  consolidate();
+void BinomialHeap::erase(Handle handle) {
+  // Equivalent to decreaseKey(handle, -infinity) + extractMin(), but sifts
+  // unconditionally instead of relying on a sentinel priority
+  if (hasPendingRoots) {
+    consolidatePendingRoots(); // removeRoot() needs a degree-sorted chain
+  }
+  BinomialHeapNode *node = handle->node;
+  while (node->parent != nullptr) {
+    swapWithParent(node);
+    node = node->parent;
+  }
+
+  removeRoot(node, findRootPredecessor(node));
+}
 
-  PassengerIdType minPassengerId = min_node->passengerId;
-  delete min_node; // Free memory
-  return minPassengerId;
+PriorityType BinomialHeap::getPriority(Handle handle) const {
+  return handle->node->priority;
 }
 
-int BinomialHeap::getSize() const {
-  int count = 0;
-  std::vector<BinomialHeapNode *> q;
-  for (auto *root : roots) {
-    if (root)
-      q.push_back(root);
+int BinomialHeap::getSize() const { return size; }
+
+BinomialHeap::InsertMode BinomialHeap::getInsertMode() const {
+  return insertMode;
+}
+
+void BinomialHeap::setInsertMode(InsertMode mode) {
+  if (mode == InsertMode::Eager && hasPendingRoots) {
+    consolidatePendingRoots(); // Eager inserts assume a consolidated chain
   }
+  insertMode = mode;
+}
 
-  int head = 0;
-  while (static_cast<decltype(q.size())>(head) < q.size()) {
-    BinomialHeapNode *current = q[head++];
-    count++;
-    BinomialHeapNode *child = current->child;
-    while (child != nullptr) {
-      q.push_back(child);
-      child = child->sibling;
+std::vector<std::pair<PriorityType, PassengerIdType>>
+BinomialHeap::topK(std::size_t k) const {
+  std::vector<std::pair<PriorityType, PassengerIdType>> result;
+  if (k > static_cast<std::size_t>(size))
+    k = size;
+  result.reserve(k);
+  if (k == 0)
+    return result;
+
+  // Min-frontier of candidate nodes. Every node's key is no better than its
+  // parent's, so the next entry in order is always on the frontier: all
+  // roots to begin with, then the children of each node as it is emitted.
+  auto worse = [](const BinomialHeapNode *a, const BinomialHeapNode *b) {
+    return before(b, a);
+  };
+  std::vector<const BinomialHeapNode *> frontier;
+  for (const BinomialHeapNode *root = head; root != nullptr;
+       root = root->sibling) {
+    frontier.push_back(root);
+  }
+  std::make_heap(frontier.begin(), frontier.end(), worse);
+
+  while (result.size() < k) {
+    std::pop_heap(frontier.begin(), frontier.end(), worse);
+    const BinomialHeapNode *node = frontier.back();
+    frontier.pop_back();
+    result.emplace_back(node->priority, node->passengerId);
+    for (const BinomialHeapNode *child = node->child; child != nullptr;
+         child = child->sibling) {
+      frontier.push_back(child);
+      std::push_heap(frontier.begin(), frontier.end(), worse);
     }
   }
-  return count; // Returns total number of nodes
+  return result;
 }
 
 std::vector<std::pair<PriorityType, PassengerIdType>>
 BinomialHeap::getWaitlistOrdered_destructive() {
   std::vector<std::pair<PriorityType, PassengerIdType>> waitlist;
+  waitlist.reserve(size);
   while (!isEmpty()) {
-    PriorityType prio = findMinPriority();
-    PassengerIdType passId = extractMin(); // This modifies the heap
-    waitlist.push_back({prio, passId});
+    waitlist.push_back(extractMinWithPriority()); // This modifies the heap
   }
   return waitlist; // Original heap is now empty
 }
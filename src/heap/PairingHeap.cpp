@@ -0,0 +1,208 @@
+// src/heap/PairingHeap.cpp
+#include "heap/PairingHeap.h"
+#include <algorithm> // For push_heap/pop_heap
+#include <utility>
+#include <vector>
+
+// --- Private Helper Method Implementations ---
+
+PairingHeapNode *PairingHeap::meld(PairingHeapNode *a, PairingHeapNode *b) {
+  if (a == nullptr)
+    return b;
+  if (b == nullptr)
+    return a;
+  // Lower priority value means higher actual priority
+  if (before(b->priority, a->priority)) {
+    std::swap(a, b);
+  }
+  // b becomes the leftmost child of a
+  b->prev = a;
+  b->sibling = a->child;
+  if (a->child != nullptr)
+    a->child->prev = b;
+  a->child = b;
+  return a;
+}
+
+PairingHeapNode *PairingHeap::mergePairs(PairingHeapNode *first) {
+  if (first == nullptr) {
+    return nullptr;
+  }
+  // First pass: meld siblings pairwise from left to right
+  pairScratch.clear();
+  while (first != nullptr) {
+    PairingHeapNode *a = first;
+    PairingHeapNode *b = a->sibling;
+    first = (b != nullptr) ? b->sibling : nullptr;
+    a->sibling = a->prev = nullptr;
+    if (b != nullptr) {
+      b->sibling = b->prev = nullptr;
+    }
+    pairScratch.push_back(meld(a, b));
+  }
+  // Second pass: meld the pairs from right to left
+  PairingHeapNode *result = pairScratch.back();
+  for (std::size_t i = pairScratch.size() - 1; i-- > 0;) {
+    result = meld(pairScratch[i], result);
+  }
+  return result;
+}
+
+void PairingHeap::cut(PairingHeapNode *node) {
+  if (node->prev->child == node) {
+    node->prev->child = node->sibling; // Leftmost child of its parent
+  } else {
+    node->prev->sibling = node->sibling;
+  }
+  if (node->sibling != nullptr)
+    node->sibling->prev = node->prev;
+  node->prev = nullptr;
+  node->sibling = nullptr;
+}
+
+// --- Constructor / Move Operations ---
+
+PairingHeap::PairingHeap() : root(nullptr), size(0) {}
+
+PairingHeap::PairingHeap(PairingHeap &&other) noexcept
+    : root(other.root), size(other.size), pool(std::move(other.pool)) {
+  other.root = nullptr;
+  other.size = 0;
+}
+
+PairingHeap &PairingHeap::operator=(PairingHeap &&other) noexcept {
+  if (this != &other) {
+    root = other.root;
+    size = other.size;
+    pool = std::move(other.pool);
+    other.root = nullptr;
+    other.size = 0;
+  }
+  return *this;
+}
+
+// --- Public Interface Method Implementations ---
+
+bool PairingHeap::isEmpty() const { return root == nullptr; }
+
+PairingHeap::Handle PairingHeap::insert(PriorityType priority,
+                                        PassengerIdType passengerId) {
+  PairingHeapNode *node = pool.create(priority, passengerId);
+  root = meld(root, node);
+  size++;
+  return node;
+}
+
+void PairingHeap::insertBatch(
+    const std::vector<std::pair<PriorityType, PassengerIdType>> &entries,
+    std::vector<Handle> &handles_out) {
+  // Inserts are already O(1) links, no separate bulk path needed
+  handles_out.reserve(handles_out.size() + entries.size());
+  for (const auto &entry : entries) {
+    handles_out.push_back(insert(entry.first, entry.second));
+  }
+}
+
+PassengerIdType PairingHeap::findMinPassengerId() const {
+  if (root == nullptr) {
+    throw std::runtime_error("Heap is empty");
+  }
+  return root->passengerId;
+}
+
+PriorityType PairingHeap::findMinPriority() const {
+  if (root == nullptr) {
+    throw std::runtime_error("Heap is empty");
+  }
+  return root->priority;
+}
+
+PassengerIdType PairingHeap::extractMin() {
+  return extractMinWithPriority().second;
+}
+
+std::pair<PriorityType, PassengerIdType> PairingHeap::extractMinWithPriority() {
+  if (root == nullptr) {
+    throw std::runtime_error("Cannot extract from empty heap");
+  }
+  PairingHeapNode *old_root = root;
+  std::pair<PriorityType, PassengerIdType> result(old_root->priority,
+                                                  old_root->passengerId);
+  root = mergePairs(old_root->child);
+  size--;
+  pool.destroy(old_root);
+  return result;
+}
+
+void PairingHeap::decreaseKey(Handle handle, PriorityType newPriority) {
+  if (before(handle->priority, newPriority)) {
+    throw std::invalid_argument("decreaseKey: new priority is worse");
+  }
+  handle->priority = newPriority;
+  if (handle != root) {
+    cut(handle);
+    root = meld(root, handle);
+  }
+}
+
+void PairingHeap::erase(Handle handle) {
+  if (handle == root) {
+    extractMin();
+    return;
+  }
+  cut(handle);
+  root = meld(root, mergePairs(handle->child));
+  size--;
+  pool.destroy(handle);
+}
+
+PriorityType PairingHeap::getPriority(Handle handle) const {
+  return handle->priority;
+}
+
+int PairingHeap::getSize() const { return size; }
+
+void PairingHeap::clear() {
+  root = nullptr;
+  size = 0;
+  pool.reset();
+}
+
+void PairingHeap::meld(PairingHeap &&other) {
+  if (this == &other || other.root == nullptr) {
+    return;
+  }
+  pool.adopt(std::move(other.pool));
+  root = meld(root, other.root);
+  size += other.size;
+  other.root = nullptr;
+  other.size = 0;
+}
+
+std::vector<std::pair<PriorityType, PassengerIdType>>
+PairingHeap::topK(std::size_t k) const {
+  std::vector<std::pair<PriorityType, PassengerIdType>> result;
+  if (k > static_cast<std::size_t>(size))
+    k = size;
+  result.reserve(k);
+  if (k == 0)
+    return result;
+
+  // Same frontier walk as BinomialHeap::topK, starting from the single root
+  auto worse = [](const PairingHeapNode *a, const PairingHeapNode *b) {
+    return before(b->priority, a->priority);
+  };
+  std::vector<const PairingHeapNode *> frontier(1, root);
+  while (result.size() < k) {
+    std::pop_heap(frontier.begin(), frontier.end(), worse);
+    const PairingHeapNode *node = frontier.back();
+    frontier.pop_back();
+    result.emplace_back(node->priority, node->passengerId);
+    for (const PairingHeapNode *child = node->child; child != nullptr;
+         child = child->sibling) {
+      frontier.push_back(child);
+      std::push_heap(frontier.begin(), frontier.end(), worse);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,274 @@
+// src/heap/RadixHeap.cpp
+#include "heap/RadixHeap.h"
+#include <algorithm> // For std::sort, std::partial_sort
+#include <utility>
+#include <vector>
+
+// --- Private Helper Method Implementations ---
+
+const std::uint64_t SIGN_BIT = static_cast<std::uint64_t>(1) << 63;
+
+std::uint64_t RadixHeap::toKey(PriorityType priority) {
+  // Flipping the sign bit maps signed order onto unsigned order
+  return static_cast<std::uint64_t>(priority) ^ SIGN_BIT;
+}
+
+PriorityType RadixHeap::toPriority(std::uint64_t key) {
+  return static_cast<PriorityType>(key ^ SIGN_BIT);
+}
+
+std::uint32_t RadixHeap::bucketFor(std::uint64_t key) const {
+  std::uint64_t diff = key ^ last;
+  return diff == 0 ? 0
+                   : 64 - static_cast<std::uint32_t>(__builtin_clzll(diff));
+}
+
+void RadixHeap::push(const Entry &entry) {
+  std::uint32_t b = bucketFor(entry.key);
+  entry.cell->bucket = b;
+  entry.cell->index = static_cast<std::uint32_t>(buckets[b].size());
+  buckets[b].push_back(entry);
+}
+
+void RadixHeap::unlink(RadixHeapCell *cell) {
+  std::vector<Entry> &bucket = buckets[cell->bucket];
+  if (cell->index + 1 < bucket.size()) {
+    bucket[cell->index] = bucket.back();
+    bucket[cell->index].cell->index = cell->index;
+  }
+  bucket.pop_back();
+}
+
+void RadixHeap::refill() {
+  std::uint32_t b = 1;
+  while (buckets[b].empty()) {
+    b++; // Caller guarantees the heap is not empty
+  }
+  std::uint64_t newLast = buckets[b].front().key;
+  for (const Entry &entry : buckets[b]) {
+    if (entry.key < newLast)
+      newLast = entry.key;
+  }
+  last = newLast;
+
+  // Every entry of bucket b lands in a lower bucket relative to the new
+  // minimum, so b can be swapped out and redistributed in one pass
+  std::vector<Entry> moving;
+  moving.swap(buckets[b]);
+  for (const Entry &entry : moving) {
+    push(entry);
+  }
+  moving.clear();
+  if (buckets[b].empty()) {
+    buckets[b].swap(moving); // Keep the capacity for later reuse
+  }
+}
+
+void RadixHeap::rebase(std::uint64_t newLast) {
+  std::vector<Entry> all;
+  all.reserve(size);
+  for (std::uint32_t b = 0; b < BUCKET_COUNT; ++b) {
+    all.insert(all.end(), buckets[b].begin(), buckets[b].end());
+    buckets[b].clear();
+  }
+  last = newLast;
+  for (const Entry &entry : all) {
+    push(entry);
+  }
+}
+
+// --- Constructor / Move Operations ---
+
+RadixHeap::RadixHeap() : last(0), size(0) {}
+
+RadixHeap::RadixHeap(RadixHeap &&other) noexcept
+    : last(other.last), size(other.size),
+      cellPool(std::move(other.cellPool)) {
+  for (std::uint32_t b = 0; b < BUCKET_COUNT; ++b) {
+    buckets[b].swap(other.buckets[b]);
+  }
+  other.size = 0;
+}
+
+RadixHeap &RadixHeap::operator=(RadixHeap &&other) noexcept {
+  if (this != &other) {
+    for (std::uint32_t b = 0; b < BUCKET_COUNT; ++b) {
+      buckets[b] = std::move(other.buckets[b]);
+      other.buckets[b].clear();
+    }
+    last = other.last;
+    size = other.size;
+    cellPool = std::move(other.cellPool);
+    other.size = 0;
+  }
+  return *this;
+}
+
+// --- Public Interface Method Implementations ---
+
+bool RadixHeap::isEmpty() const { return size == 0; }
+
+RadixHeap::Handle RadixHeap::insert(PriorityType priority,
+                                    PassengerIdType passengerId) {
+  Entry entry;
+  entry.key = toKey(priority);
+  entry.passengerId = passengerId;
+  entry.cell = cellPool.create(0u, 0u);
+  if (size == 0) {
+    last = entry.key;
+  } else if (entry.key < last) {
+    rebase(entry.key); // Rare for a booking counter: new overall minimum
+  }
+  push(entry);
+  size++;
+  return entry.cell;
+}
+
+void RadixHeap::insertBatch(
+    const std::vector<std::pair<PriorityType, PassengerIdType>> &entries,
+    std::vector<Handle> &handles_out) {
+  if (entries.empty()) {
+    return;
+  }
+  // Start from the smallest key of the batch so no entry triggers a rebase
+  std::uint64_t minKey = toKey(entries.front().first);
+  for (const auto &item : entries) {
+    std::uint64_t key = toKey(item.first);
+    if (key < minKey)
+      minKey = key;
+  }
+  if (size == 0) {
+    last = minKey;
+  } else if (minKey < last) {
+    rebase(minKey);
+  }
+  handles_out.reserve(handles_out.size() + entries.size());
+  for (const auto &item : entries) {
+    Entry entry;
+    entry.key = toKey(item.first);
+    entry.passengerId = item.second;
+    entry.cell = cellPool.create(0u, 0u);
+    push(entry);
+    handles_out.push_back(entry.cell);
+  }
+  size += static_cast<int>(entries.size());
+}
+
+PassengerIdType RadixHeap::findMinPassengerId() const {
+  if (size == 0) {
+    throw std::runtime_error("Heap is empty");
+  }
+  return buckets[0].back().passengerId;
+}
+
+PriorityType RadixHeap::findMinPriority() const {
+  if (size == 0) {
+    throw std::runtime_error("Heap is empty");
+  }
+  return toPriority(last);
+}
+
+PassengerIdType RadixHeap::extractMin() {
+  return extractMinWithPriority().second;
+}
+
+std::pair<PriorityType, PassengerIdType> RadixHeap::extractMinWithPriority() {
+  if (size == 0) {
+    throw std::runtime_error("Cannot extract from empty heap");
+  }
+  // Bucket 0 is never empty while the heap is not, take from its back
+  Entry entry = buckets[0].back();
+  buckets[0].pop_back();
+  cellPool.destroy(entry.cell);
+  size--;
+  if (buckets[0].empty() && size > 0) {
+    refill();
+  }
+  return std::make_pair(toPriority(entry.key), entry.passengerId);
+}
+
+void RadixHeap::decreaseKey(Handle handle, PriorityType newPriority) {
+  Entry entry = buckets[handle->bucket][handle->index];
+  std::uint64_t newKey = toKey(newPriority);
+  if (newKey > entry.key) {
+    throw std::invalid_argument("decreaseKey: new priority is worse");
+  }
+  unlink(handle);
+  entry.key = newKey;
+  if (newKey < last) {
+    rebase(newKey);
+  }
+  push(entry);
+}
+
+void RadixHeap::erase(Handle handle) {
+  unlink(handle);
+  cellPool.destroy(handle);
+  size--;
+  if (buckets[0].empty() && size > 0) {
+    refill();
+  }
+}
+
+PriorityType RadixHeap::getPriority(Handle handle) const {
+  return toPriority(buckets[handle->bucket][handle->index].key);
+}
+
+int RadixHeap::getSize() const { return size; }
+
+void RadixHeap::clear() {
+  for (std::uint32_t b = 0; b < BUCKET_COUNT; ++b) {
+    buckets[b].clear();
+  }
+  size = 0;
+  cellPool.reset();
+}
+
+void RadixHeap::meld(RadixHeap &&other) {
+  if (this == &other || other.size == 0) {
+    return;
+  }
+  cellPool.adopt(std::move(other.cellPool));
+  if (size == 0) {
+    last = other.last;
+  } else if (other.last < last) {
+    rebase(other.last); // 'other' holds the new overall minimum
+  }
+  for (std::uint32_t b = 0; b < BUCKET_COUNT; ++b) {
+    for (const Entry &entry : other.buckets[b]) {
+      push(entry);
+    }
+    other.buckets[b].clear();
+  }
+  size += other.size;
+  other.size = 0;
+}
+
+std::vector<std::pair<PriorityType, PassengerIdType>>
+RadixHeap::topK(std::size_t k) const {
+  std::vector<std::pair<PriorityType, PassengerIdType>> result;
+  if (k > static_cast<std::size_t>(size))
+    k = size;
+  result.reserve(k);
+
+  std::vector<std::pair<std::uint64_t, PassengerIdType>> scratch;
+  for (std::uint32_t b = 0; b < BUCKET_COUNT && result.size() < k; ++b) {
+    if (buckets[b].empty())
+      continue;
+    scratch.clear();
+    for (const Entry &entry : buckets[b]) {
+      scratch.emplace_back(entry.key, entry.passengerId);
+    }
+    std::size_t take = std::min(k - result.size(), scratch.size());
+    auto byKey = [](const std::pair<std::uint64_t, PassengerIdType> &a,
+                    const std::pair<std::uint64_t, PassengerIdType> &b) {
+      return a.first < b.first;
+    };
+    std::partial_sort(scratch.begin(), scratch.begin() + take, scratch.end(),
+                      byKey);
+    for (std::size_t i = 0; i < take; ++i) {
+      result.emplace_back(toPriority(scratch[i].first), scratch[i].second);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,184 @@
+// src/heap/TimerWheel.cpp
+#include "heap/TimerWheel.h"
+
+const TimerWheel::TimerId TimerWheel::INVALID_TIMER;
+const int TimerWheel::LEVEL_BITS;
+const std::size_t TimerWheel::SLOTS;
+const int TimerWheel::LEVELS;
+const std::uint32_t TimerWheel::NIL;
+const std::uint32_t TimerWheel::FREE;
+const std::size_t TimerWheel::LIST_COUNT;
+const std::size_t TimerWheel::WORDS;
+
+// --- Private Helper Method Implementations ---
+
+std::uint32_t TimerWheel::listFor(Tick deadline) const {
+  const Tick diff = deadline ^ now;
+  if (diff == 0) {
+    return static_cast<std::uint32_t>(deadline % SLOTS); // Due now
+  }
+  const int level = (63 - __builtin_clzll(diff)) / LEVEL_BITS;
+  if (level >= LEVELS) {
+    return static_cast<std::uint32_t>(LEVELS * SLOTS); // Overflow
+  }
+  return static_cast<std::uint32_t>(
+      level * SLOTS + ((deadline >> (level * LEVEL_BITS)) % SLOTS));
+}
+
+void TimerWheel::link(std::uint32_t index, std::uint32_t list) {
+  Timer &timer = timers[index];
+  timer.list = list;
+  timer.prev = NIL;
+  timer.next = heads[list];
+  if (timer.next != NIL) {
+    timers[timer.next].prev = index;
+  }
+  heads[list] = index;
+  if (list < LEVELS * SLOTS) {
+    occupied[list / SLOTS][list % SLOTS / 64] |= std::uint64_t(1)
+                                                 << (list % 64);
+  }
+}
+
+void TimerWheel::unlink(std::uint32_t index) {
+  const Timer &timer = timers[index];
+  if (timer.prev != NIL) {
+    timers[timer.prev].next = timer.next;
+  } else {
+    heads[timer.list] = timer.next;
+  }
+  if (timer.next != NIL) {
+    timers[timer.next].prev = timer.prev;
+  }
+  if (heads[timer.list] == NIL && timer.list < LEVELS * SLOTS) {
+    occupied[timer.list / SLOTS][timer.list % SLOTS / 64] &=
+        ~(std::uint64_t(1) << (timer.list % 64));
+  }
+}
+
+void TimerWheel::release(std::uint32_t index) {
+  Timer &timer = timers[index];
+  ++timer.generation;
+  timer.list = FREE;
+  timer.next = freeHead;
+  freeHead = index;
+  --armed;
+}
+
+TimerWheel::Tick TimerWheel::nextEvent() const {
+  // A slot at a lower level always comes before any slot above it, so the
+  // first occupied one found is the answer
+  for (int level = 0; level < LEVELS; ++level) {
+    const int shift = level * LEVEL_BITS;
+    const std::size_t first = static_cast<std::size_t>((now >> shift) % SLOTS) + 1;
+    for (std::size_t word = first / 64; word < WORDS && first < SLOTS;
+         ++word) {
+      std::uint64_t bits = occupied[level][word];
+      if (word == first / 64) {
+        bits &= ~std::uint64_t(0) << (first % 64);
+      }
+      if (bits != 0) {
+        const Tick slot = word * 64 + __builtin_ctzll(bits);
+        return (now >> (shift + LEVEL_BITS) << (shift + LEVEL_BITS)) |
+               (slot << shift);
+      }
+    }
+  }
+  // Only the overflow list is left: refile it at the next 2^32 boundary
+  return ((now >> (LEVELS * LEVEL_BITS)) + 1) << (LEVELS * LEVEL_BITS);
+}
+
+void TimerWheel::cascade(std::uint32_t list) {
+  std::uint32_t index = heads[list];
+  heads[list] = NIL;
+  if (list < LEVELS * SLOTS) {
+    occupied[list / SLOTS][list % SLOTS / 64] &=
+        ~(std::uint64_t(1) << (list % 64));
+  }
+  while (index != NIL) {
+    const std::uint32_t next = timers[index].next;
+    link(index, listFor(timers[index].deadline));
+    index = next;
+  }
+}
+
+std::uint32_t TimerWheel::popFired(std::uint32_t list,
+                                   std::uint32_t &payload) {
+  const std::uint32_t index = heads[list];
+  if (index == NIL) {
+    return NIL;
+  }
+  unlink(index);
+  payload = timers[index].payload;
+  release(index); // Before the callback, which may reuse the slot
+  return index;
+}
+
+void TimerWheel::moveTo(Tick tick) {
+  now = tick;
+  const Tick top = Tick(1) << (LEVELS * LEVEL_BITS);
+  if (tick % top == 0) {
+    cascade(static_cast<std::uint32_t>(LEVELS * SLOTS));
+  }
+  for (int level = LEVELS - 1; level > 0; --level) {
+    const int shift = level * LEVEL_BITS;
+    if (tick % (Tick(1) << shift) == 0) {
+      cascade(static_cast<std::uint32_t>(level * SLOTS +
+                                         (tick >> shift) % SLOTS));
+    }
+  }
+}
+
+// --- Constructor ---
+
+TimerWheel::TimerWheel(Tick start) : freeHead(NIL), now(start), armed(0) {
+  for (std::uint32_t &head : heads) {
+    head = NIL;
+  }
+  for (int level = 0; level < LEVELS; ++level) {
+    for (std::uint64_t &word : occupied[level]) {
+      word = 0;
+    }
+  }
+}
+
+// --- Public Interface ---
+
+TimerWheel::TimerId TimerWheel::arm(Tick deadline, std::uint32_t payload) {
+  if (deadline <= now) {
+    deadline = now + 1;
+  }
+  std::uint32_t index = freeHead;
+  if (index != NIL) {
+    freeHead = timers[index].next;
+  } else {
+    index = static_cast<std::uint32_t>(timers.size());
+    Timer timer;
+    timer.generation = 0;
+    timers.push_back(timer);
+  }
+  Timer &timer = timers[index];
+  timer.deadline = deadline;
+  timer.payload = payload;
+  link(index, listFor(deadline));
+  ++armed;
+  return (static_cast<TimerId>(timer.generation) << 32) | (index + 1);
+}
+
+bool TimerWheel::cancel(TimerId id) {
+  const std::uint64_t low = id & 0xFFFFFFFFu;
+  if (low == 0 || low > timers.size()) {
+    return false;
+  }
+  const std::uint32_t index = static_cast<std::uint32_t>(low - 1);
+  const Timer &timer = timers[index];
+  if (timer.list == FREE || timer.generation != (id >> 32)) {
+    return false;
+  }
+  unlink(index);
+  release(index);
+  return true;
+}
+
+TimerWheel::Tick TimerWheel::getNow() const { return now; }
+std::size_t TimerWheel::size() const { return armed; }
@@ -0,0 +1,344 @@
+// src/heap/Waitlist.cpp
+#include "heap/Waitlist.h"
+#include <stdexcept> // For std::runtime_error
+#include <utility>
+#include <vector>
+
+namespace {
+// Converts a backend's typed handles into opaque Waitlist handles
+template <typename Heap>
+void insertBatchInto(
+    Heap &heap,
+    const std::vector<std::pair<PriorityType, PassengerIdType>> &entries,
+    std::vector<Waitlist::Handle> &handles_out) {
+  std::vector<typename Heap::Handle> typed;
+  typed.reserve(entries.size());
+  heap.insertBatch(entries, typed);
+  handles_out.insert(handles_out.end(), typed.begin(), typed.end());
+}
+} // namespace
+
+const char *toString(WaitlistBackend backend) {
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    return "binomial";
+  case WaitlistBackend::Pairing:
+    return "pairing";
+  case WaitlistBackend::Quaternary:
+    return "quaternary";
+  case WaitlistBackend::Radix:
+    return "radix";
+  }
+  return "unknown";
+}
+
+// --- Backend Lifetime ---
+
+void Waitlist::materialize() {
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    storage.binomial = new BinomialHeap(insertMode);
+    break;
+  case WaitlistBackend::Pairing:
+    storage.pairing = new PairingHeap();
+    break;
+  case WaitlistBackend::Quaternary:
+    storage.quaternary = new QuaternaryHeap();
+    break;
+  case WaitlistBackend::Radix:
+    storage.radix = new RadixHeap();
+    break;
+  }
+}
+
+void Waitlist::destroy() {
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    delete storage.binomial;
+    break;
+  case WaitlistBackend::Pairing:
+    delete storage.pairing;
+    break;
+  case WaitlistBackend::Quaternary:
+    delete storage.quaternary;
+    break;
+  case WaitlistBackend::Radix:
+    delete storage.radix;
+    break;
+  }
+  storage.any = nullptr;
+}
+
+Waitlist::Waitlist(WaitlistBackend kind, BinomialHeap::InsertMode mode)
+    : backend(kind), insertMode(mode) {
+  storage.any = nullptr;
+}
+
+Waitlist::~Waitlist() { destroy(); }
+
+Waitlist::Waitlist(Waitlist &&other) noexcept
+    : backend(other.backend), insertMode(other.insertMode),
+      storage(other.storage) {
+  other.storage.any = nullptr;
+}
+
+Waitlist &Waitlist::operator=(Waitlist &&other) noexcept {
+  if (this != &other) {
+    destroy();
+    backend = other.backend;
+    insertMode = other.insertMode;
+    storage = other.storage;
+    other.storage.any = nullptr;
+  }
+  return *this;
+}
+
+WaitlistBackend Waitlist::getBackend() const { return backend; }
+
+bool Waitlist::isMaterialized() const { return storage.any != nullptr; }
+
+// --- Forwarding ---
+
+bool Waitlist::isEmpty() const {
+  if (storage.any == nullptr) {
+    return true;
+  }
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    return storage.binomial->isEmpty();
+  case WaitlistBackend::Pairing:
+    return storage.pairing->isEmpty();
+  case WaitlistBackend::Quaternary:
+    return storage.quaternary->isEmpty();
+  case WaitlistBackend::Radix:
+    return storage.radix->isEmpty();
+  }
+  return true;
+}
+
+Waitlist::Handle Waitlist::insert(PriorityType priority,
+                                  PassengerIdType passengerId) {
+  if (storage.any == nullptr) {
+    materialize();
+  }
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    return storage.binomial->insert(priority, passengerId);
+  case WaitlistBackend::Pairing:
+    return storage.pairing->insert(priority, passengerId);
+  case WaitlistBackend::Quaternary:
+    return storage.quaternary->insert(priority, passengerId);
+  case WaitlistBackend::Radix:
+    return storage.radix->insert(priority, passengerId);
+  }
+  return nullptr;
+}
+
+void Waitlist::insertBatch(
+    const std::vector<std::pair<PriorityType, PassengerIdType>> &entries,
+    std::vector<Handle> &handles_out) {
+  if (entries.empty()) {
+    return;
+  }
+  if (storage.any == nullptr) {
+    materialize();
+  }
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    insertBatchInto(*storage.binomial, entries, handles_out);
+    break;
+  case WaitlistBackend::Pairing:
+    insertBatchInto(*storage.pairing, entries, handles_out);
+    break;
+  case WaitlistBackend::Quaternary:
+    insertBatchInto(*storage.quaternary, entries, handles_out);
+    break;
+  case WaitlistBackend::Radix:
+    insertBatchInto(*storage.radix, entries, handles_out);
+    break;
+  }
+}
+
+PassengerIdType Waitlist::findMinPassengerId() const {
+  if (storage.any == nullptr) {
+    throw std::runtime_error("Heap is empty");
+  }
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    return storage.binomial->findMinPassengerId();
+  case WaitlistBackend::Pairing:
+    return storage.pairing->findMinPassengerId();
+  case WaitlistBackend::Quaternary:
+    return storage.quaternary->findMinPassengerId();
+  case WaitlistBackend::Radix:
+    return storage.radix->findMinPassengerId();
+  }
+  return INVALID_PASSENGER_ID;
+}
+
+PriorityType Waitlist::findMinPriority() const {
+  if (storage.any == nullptr) {
+    throw std::runtime_error("Heap is empty");
+  }
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    return storage.binomial->findMinPriority();
+  case WaitlistBackend::Pairing:
+    return storage.pairing->findMinPriority();
+  case WaitlistBackend::Quaternary:
+    return storage.quaternary->findMinPriority();
+  case WaitlistBackend::Radix:
+    return storage.radix->findMinPriority();
+  }
+  return MAX_PRIORITY;
+}
+
+PassengerIdType Waitlist::extractMin() {
+  return extractMinWithPriority().second;
+}
+
+std::pair<PriorityType, PassengerIdType> Waitlist::extractMinWithPriority() {
+  if (storage.any == nullptr) {
+    throw std::runtime_error("Cannot extract from empty heap");
+  }
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    return storage.binomial->extractMinWithPriority();
+  case WaitlistBackend::Pairing:
+    return storage.pairing->extractMinWithPriority();
+  case WaitlistBackend::Quaternary:
+    return storage.quaternary->extractMinWithPriority();
+  case WaitlistBackend::Radix:
+    return storage.radix->extractMinWithPriority();
+  }
+  throw std::runtime_error("Cannot extract from empty heap");
+}
+
+void Waitlist::decreaseKey(Handle handle, PriorityType newPriority) {
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    storage.binomial->decreaseKey(static_cast<BinomialHeap::Handle>(handle),
+                                 newPriority);
+    break;
+  case WaitlistBackend::Pairing:
+    storage.pairing->decreaseKey(static_cast<PairingHeap::Handle>(handle),
+                                newPriority);
+    break;
+  case WaitlistBackend::Quaternary:
+    storage.quaternary->decreaseKey(static_cast<QuaternaryHeap::Handle>(handle),
+                                   newPriority);
+    break;
+  case WaitlistBackend::Radix:
+    storage.radix->decreaseKey(static_cast<RadixHeap::Handle>(handle),
+                              newPriority);
+    break;
+  }
+}
+
+void Waitlist::erase(Handle handle) {
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    storage.binomial->erase(static_cast<BinomialHeap::Handle>(handle));
+    break;
+  case WaitlistBackend::Pairing:
+    storage.pairing->erase(static_cast<PairingHeap::Handle>(handle));
+    break;
+  case WaitlistBackend::Quaternary:
+    storage.quaternary->erase(static_cast<QuaternaryHeap::Handle>(handle));
+    break;
+  case WaitlistBackend::Radix:
+    storage.radix->erase(static_cast<RadixHeap::Handle>(handle));
+    break;
+  }
+}
+
+PriorityType Waitlist::getPriority(Handle handle) const {
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    return storage.binomial->getPriority(
+        static_cast<BinomialHeap::Handle>(handle));
+  case WaitlistBackend::Pairing:
+    return storage.pairing->getPriority(
+        static_cast<PairingHeap::Handle>(handle));
+  case WaitlistBackend::Quaternary:
+    return storage.quaternary->getPriority(
+        static_cast<QuaternaryHeap::Handle>(handle));
+  case WaitlistBackend::Radix:
+    return storage.radix->getPriority(static_cast<RadixHeap::Handle>(handle));
+  }
+  return MAX_PRIORITY;
+}
+
+int Waitlist::getSize() const {
+  if (storage.any == nullptr) {
+    return 0;
+  }
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    return storage.binomial->getSize();
+  case WaitlistBackend::Pairing:
+    return storage.pairing->getSize();
+  case WaitlistBackend::Quaternary:
+    return storage.quaternary->getSize();
+  case WaitlistBackend::Radix:
+    return storage.radix->getSize();
+  }
+  return 0;
+}
+
+void Waitlist::clear() { destroy(); }
+
+std::vector<std::pair<PriorityType, PassengerIdType>>
+Waitlist::topK(std::size_t k) const {
+  if (storage.any == nullptr) {
+    return std::vector<std::pair<PriorityType, PassengerIdType>>();
+  }
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    return storage.binomial->topK(k);
+  case WaitlistBackend::Pairing:
+    return storage.pairing->topK(k);
+  case WaitlistBackend::Quaternary:
+    return storage.quaternary->topK(k);
+  case WaitlistBackend::Radix:
+    return storage.radix->topK(k);
+  }
+  return std::vector<std::pair<PriorityType, PassengerIdType>>();
+}
+
+bool Waitlist::meld(Waitlist &&other) {
+  if (other.backend != backend) {
+    return false;
+  }
+  if (other.storage.any == nullptr || this == &other) {
+    return true;
+  }
+  if (storage.any == nullptr) {
+    // Nothing here yet: take over the other backend as it is
+    storage = other.storage;
+    other.storage.any = nullptr;
+    return true;
+  }
+  switch (backend) {
+  case WaitlistBackend::Binomial:
+    storage.binomial->meld(std::move(*other.storage.binomial));
+    break;
+  case WaitlistBackend::Pairing:
+    storage.pairing->meld(std::move(*other.storage.pairing));
+    break;
+  case WaitlistBackend::Quaternary:
+    storage.quaternary->meld(std::move(*other.storage.quaternary));
+    break;
+  case WaitlistBackend::Radix:
+    storage.radix->meld(std::move(*other.storage.radix));
+    break;
+  }
+  return true;
+}
+
+void Waitlist::setInsertMode(BinomialHeap::InsertMode mode) {
+  insertMode = mode;
+  if (backend == WaitlistBackend::Binomial && storage.any != nullptr) {
+    storage.binomial->setInsertMode(mode);
+  }
+}
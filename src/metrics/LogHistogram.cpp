@@ -0,0 +1,70 @@
+// src/metrics/LogHistogram.cpp
+#include "metrics/LogHistogram.h"
+
+const int LogHistogram::SUB_BITS;
+const std::size_t LogHistogram::SUB_BUCKETS;
+const int LogHistogram::MAX_MAGNITUDE;
+const std::uint64_t LogHistogram::MAX_VALUE;
+const std::size_t LogHistogram::BUCKET_COUNT;
+
+std::uint64_t LogHistogram::bucketUpperBound(std::size_t index) {
+  if (index < 2 * SUB_BUCKETS) {
+    return index;
+  }
+  const std::size_t shift = index / SUB_BUCKETS - 1;
+  const std::uint64_t mantissa = index % SUB_BUCKETS + SUB_BUCKETS;
+  return ((mantissa + 1) << shift) - 1;
+}
+
+LogHistogram::LogHistogram() : sum(0) {
+  for (std::atomic<std::uint64_t> &count : counts) {
+    count.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::uint64_t LogHistogram::getBucket(std::size_t index) const {
+  return counts[index].load(std::memory_order_relaxed);
+}
+
+std::uint64_t LogHistogram::getSum() const {
+  return sum.load(std::memory_order_relaxed);
+}
+
+HistogramTotals::HistogramTotals()
+    : counts(LogHistogram::BUCKET_COUNT, 0), count(0), sum(0) {}
+
+void HistogramTotals::add(const LogHistogram &histogram) {
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    const std::uint64_t bucket = histogram.getBucket(i);
+    counts[i] += bucket;
+    count += bucket; // From the buckets, so it always matches them
+  }
+  sum += histogram.getSum();
+}
+
+std::uint64_t HistogramTotals::valueAtQuantile(double q) const {
+  if (count == 0) {
+    return 0;
+  }
+  std::uint64_t rank = static_cast<std::uint64_t>(q * count + 0.5);
+  if (rank < 1) {
+    rank = 1;
+  }
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    seen += counts[i];
+    if (seen >= rank) {
+      return LogHistogram::bucketUpperBound(i);
+    }
+  }
+  return LogHistogram::bucketUpperBound(counts.size() - 1);
+}
+
+std::uint64_t HistogramTotals::countAtOrBelow(std::uint64_t limit) const {
+  std::uint64_t total = 0;
+  for (std::size_t i = 0;
+       i < counts.size() && LogHistogram::bucketUpperBound(i) <= limit; ++i) {
+    total += counts[i];
+  }
+  return total;
+}
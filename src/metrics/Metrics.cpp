@@ -0,0 +1,190 @@
+// src/metrics/Metrics.cpp
+#include "metrics/Metrics.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const char *const LATENCY_LABELS[] = {
+    "flight_book",      "flight_cancel",   "flight_cancel_promoted",
+    "flight_lookup",    "heap_insert",     "heap_extract_min",
+    "heap_consolidate", "heap_consolidate_lazy"};
+static_assert(sizeof(LATENCY_LABELS) / sizeof(LATENCY_LABELS[0]) ==
+                  static_cast<std::size_t>(LatencyMetric::Count),
+              "One label per LatencyMetric");
+
+// Bucket bounds of the exported latency histograms, in seconds
+const double LATENCY_BOUNDS[] = {25e-9,  50e-9,  100e-9, 250e-9, 500e-9,
+                                 1e-6,   2.5e-6, 5e-6,   10e-6,  25e-6,
+                                 50e-6,  100e-6, 250e-6, 500e-6, 1e-3,
+                                 2.5e-3, 5e-3,   10e-3,  25e-3,  100e-3,
+                                 1.0};
+const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+// Below this much uptime ticksPerSecond() waits, so the rate is not
+// dominated by the resolution of steady_clock
+const std::chrono::milliseconds MIN_CALIBRATION(10);
+
+struct Calibration {
+  std::uint64_t ticks;
+  std::chrono::steady_clock::time_point time;
+};
+const Calibration startup = {readTicks(), std::chrono::steady_clock::now()};
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<MetricsBlock>> registry; // Never shrinks
+
+thread_local MetricsBlock *localBlock = nullptr;
+
+// Returns the thread's block to the registry when the thread exits
+struct BlockRelease {
+  ~BlockRelease() {
+    if (localBlock != nullptr) {
+      localBlock->inUse.store(false, std::memory_order_release);
+    }
+  }
+};
+
+MetricsBlock &acquireBlock() {
+  static thread_local BlockRelease release;
+  (void)release;
+  std::lock_guard<std::mutex> lock(registryMutex);
+  for (const std::unique_ptr<MetricsBlock> &block : registry) {
+    // Acquire: see every count the previous owner recorded
+    if (!block->inUse.load(std::memory_order_acquire)) {
+      block->inUse.store(true, std::memory_order_relaxed);
+      localBlock = block.get();
+      return *localBlock;
+    }
+  }
+  registry.emplace_back(new MetricsBlock());
+  localBlock = registry.back().get();
+  return *localBlock;
+}
+
+void writeLatency(std::ostream &out, double rate) {
+  out << "# HELP booking_op_duration_seconds Time spent in instrumented "
+         "hot-path operations.\n"
+         "# TYPE booking_op_duration_seconds histogram\n";
+  std::vector<HistogramTotals> totals(
+      static_cast<std::size_t>(LatencyMetric::Count));
+  for (const std::unique_ptr<MetricsBlock> &block : registry) {
+    for (std::size_t m = 0; m < totals.size(); ++m) {
+      totals[m].add(block->latency[m]);
+    }
+  }
+  for (std::size_t m = 0; m < totals.size(); ++m) {
+    const std::string op = std::string("{op=\"") + LATENCY_LABELS[m] + '"';
+    for (double bound : LATENCY_BOUNDS) {
+      out << "booking_op_duration_seconds_bucket" << op << ",le=\"" << bound
+          << "\"} "
+          << totals[m].countAtOrBelow(static_cast<std::uint64_t>(bound * rate))
+          << '\n';
+    }
+    out << "booking_op_duration_seconds_bucket" << op << ",le=\"+Inf\"} "
+        << totals[m].count << '\n'
+        << "booking_op_duration_seconds_sum" << op << "} "
+        << totals[m].sum / rate << '\n'
+        << "booking_op_duration_seconds_count" << op << "} "
+        << totals[m].count << '\n';
+  }
+
+  out << "# HELP booking_op_duration_quantile_seconds Quantiles of "
+         "booking_op_duration_seconds at full histogram precision.\n"
+         "# TYPE booking_op_duration_quantile_seconds gauge\n";
+  for (std::size_t m = 0; m < totals.size(); ++m) {
+    for (double q : QUANTILES) {
+      out << "booking_op_duration_quantile_seconds{op=\"" << LATENCY_LABELS[m]
+          << "\",quantile=\"" << q << "\"} "
+          << totals[m].valueAtQuantile(q) / rate << '\n';
+    }
+  }
+}
+
+void writeValues(std::ostream &out) {
+  HistogramTotals roots;
+  for (const std::unique_ptr<MetricsBlock> &block : registry) {
+    roots.add(block->values[static_cast<std::size_t>(
+        ValueMetric::HeapRootListLength)]);
+  }
+  out << "# HELP booking_heap_root_list_length Binomial heap roots when a "
+         "consolidation starts.\n"
+         "# TYPE booking_heap_root_list_length histogram\n";
+  for (std::uint64_t bound = 1; bound <= 4096; bound *= 2) {
+    out << "booking_heap_root_list_length_bucket{le=\"" << bound << "\"} "
+        << roots.countAtOrBelow(bound) << '\n';
+  }
+  out << "booking_heap_root_list_length_bucket{le=\"+Inf\"} " << roots.count
+      << '\n'
+      << "booking_heap_root_list_length_sum " << roots.sum << '\n'
+      << "booking_heap_root_list_length_count " << roots.count << '\n';
+
+  std::uint64_t resizes = 0;
+  for (const std::unique_ptr<MetricsBlock> &block : registry) {
+    resizes += block->counters[static_cast<std::size_t>(
+                                   CounterMetric::HeapDegreeTableResizes)]
+                   .load(std::memory_order_relaxed);
+  }
+  out << "# HELP booking_heap_degree_table_resizes_total Times a lazy "
+         "consolidation had to grow its degree table.\n"
+         "# TYPE booking_heap_degree_table_resizes_total counter\n"
+         "booking_heap_degree_table_resizes_total "
+      << resizes << '\n';
+}
+
+} // namespace
+
+MetricsBlock::MetricsBlock() : inUse(true) {
+  for (std::atomic<std::uint64_t> &counter : counters) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+}
+
+MetricsBlock &localMetrics() {
+  MetricsBlock *block = localBlock;
+  return block != nullptr ? *block : acquireBlock();
+}
+
+double ticksPerSecond() {
+#if defined(__x86_64__) || defined(__i386__)
+  std::chrono::steady_clock::duration elapsed =
+      std::chrono::steady_clock::now() - startup.time;
+  if (elapsed < MIN_CALIBRATION) {
+    std::this_thread::sleep_for(MIN_CALIBRATION - elapsed);
+  }
+  const std::uint64_t ticks = readTicks();
+  elapsed = std::chrono::steady_clock::now() - startup.time;
+  return static_cast<double>(ticks - startup.ticks) /
+         std::chrono::duration<double>(elapsed).count();
+#else
+  return 1e9; // readTicks() is in nanoseconds
+#endif
+}
+
+bool metricsEnabled() {
+#ifdef BOOKING_METRICS
+  return true;
+#else
+  return false;
+#endif
+}
+
+void writePrometheus(std::ostream &out) {
+  out << "# HELP booking_metrics_enabled 1 if this build records metrics "
+         "(make METRICS=1).\n"
+         "# TYPE booking_metrics_enabled gauge\n"
+         "booking_metrics_enabled "
+      << (metricsEnabled() ? 1 : 0) << '\n';
+  if (!metricsEnabled()) {
+    return;
+  }
+  const double rate = ticksPerSecond();
+  const std::streamsize precision = out.precision(9);
+  std::lock_guard<std::mutex> lock(registryMutex);
+  writeLatency(out, rate);
+  writeValues(out);
+  out.precision(precision);
+}
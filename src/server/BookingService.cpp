@@ -0,0 +1,122 @@
+// src/server/BookingService.cpp
+#include "server/BookingService.h"
+#include "booking/BookingSystem.h"
+#include "booking/ShardedBookingEngine.h"
+
+// --- BookingSystemService ---
+
+BookingSystemService::BookingSystemService(BookingSystem &bookingSystem)
+    : system(bookingSystem) {}
+
+bool BookingSystemService::isThreadSafe() const { return false; }
+
+void BookingSystemService::bookBatch(
+    const std::vector<BookingRequest> &requests,
+    std::vector<BookingResult> &results) {
+  results = system.bookBatch(requests);
+}
+
+void BookingSystemService::cancelBatch(
+    const std::vector<BookingRequest> &requests,
+    std::vector<BookingResult> &results) {
+  results = system.cancelBatch(requests);
+}
+
+ItineraryResult BookingSystemService::bookItinerary(
+    PassengerIdType passengerId, const std::vector<std::string> &flightIds) {
+  return system.bookItinerary(passengerId, flightIds);
+}
+
+BookingResult BookingSystemService::holdSeat(
+    PassengerIdType passengerId, const std::string &flightId,
+    std::chrono::milliseconds duration) {
+  return system.holdSeat(passengerId, flightId, duration);
+}
+
+BookingResult BookingSystemService::confirmHold(
+    PassengerIdType passengerId, const std::string &flightId) {
+  return system.confirmHold(passengerId, flightId);
+}
+
+BookingResult BookingSystemService::releaseHold(
+    PassengerIdType passengerId, const std::string &flightId) {
+  return system.releaseHold(passengerId, flightId);
+}
+
+void BookingSystemService::expireHolds() { system.expireHolds(); }
+
+bool BookingSystemService::queryFlight(const std::string &flightId,
+                                       FlightStatus &status) {
+  return system.queryFlight(flightId, status);
+}
+
+PassengerIdType BookingSystemService::addPassenger(const std::string &name) {
+  return system.addPassenger(name);
+}
+
+bool BookingSystemService::addFlight(const std::string &flightId,
+                                     const std::string &origin,
+                                     const std::string &destination,
+                                     int capacity) {
+  return system.addFlight(flightId, origin, destination, capacity);
+}
+
+void BookingSystemService::commit() { system.syncJournal(); }
+
+// --- ShardedEngineService ---
+
+ShardedEngineService::ShardedEngineService(ShardedBookingEngine &bookingEngine)
+    : engine(bookingEngine) {}
+
+bool ShardedEngineService::isThreadSafe() const { return true; }
+
+void ShardedEngineService::bookBatch(
+    const std::vector<BookingRequest> &requests,
+    std::vector<BookingResult> &results) {
+  results = engine.bookBatch(requests);
+}
+
+void ShardedEngineService::cancelBatch(
+    const std::vector<BookingRequest> &requests,
+    std::vector<BookingResult> &results) {
+  results = engine.cancelBatch(requests);
+}
+
+ItineraryResult ShardedEngineService::bookItinerary(
+    PassengerIdType passengerId, const std::vector<std::string> &flightIds) {
+  return engine.bookItinerary(passengerId, flightIds);
+}
+
+BookingResult ShardedEngineService::holdSeat(
+    PassengerIdType passengerId, const std::string &flightId,
+    std::chrono::milliseconds duration) {
+  return engine.holdSeat(passengerId, flightId, duration);
+}
+
+BookingResult ShardedEngineService::confirmHold(
+    PassengerIdType passengerId, const std::string &flightId) {
+  return engine.confirmHold(passengerId, flightId);
+}
+
+BookingResult ShardedEngineService::releaseHold(
+    PassengerIdType passengerId, const std::string &flightId) {
+  return engine.releaseHold(passengerId, flightId);
+}
+
+void ShardedEngineService::expireHolds() { engine.expireHolds(); }
+
+bool ShardedEngineService::queryFlight(const std::string &flightId,
+                                       FlightStatus &status) {
+  return engine.queryFlight(flightId, status); // Lock-free
+}
+
+PassengerIdType ShardedEngineService::addPassenger(const std::string &name) {
+  return engine.addPassenger(name);
+}
+
+bool ShardedEngineService::addFlight(const std::string &flightId,
+                                     const std::string &origin,
+                                     const std::string &destination,
+                                     int capacity) {
+  return engine.addFlight(flightId, origin, destination, capacity);
+}
@@ -0,0 +1,750 @@
+// src/server/RequestServer.cpp
+#include "server/RequestServer.h"
+#include "common/InlineCode.h"
+#include "common/StringRef.h"
+#include "metrics/Metrics.h"
+#include <algorithm> // For std::min, std::find
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring> // For std::memchr, std::memcpy, std::strerror
+#include <exception>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/tcp.h> // For TCP_NODELAY
+#include <sstream>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const int MAX_EVENTS = 256;
+const std::size_t READ_CHUNK_BYTES = 16 << 10;
+const int MAX_CAPACITY = 1000000;
+
+[[noreturn]] void fail(const std::string &what) {
+  throw std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+// Splits the next space-separated word off the front of 'rest'; empty at
+// the end of the line
+StringRef nextWord(StringRef &rest) {
+  std::size_t i = 0;
+  while (i < rest.size && rest.data[i] == ' ') {
+    ++i;
+  }
+  std::size_t start = i;
+  while (i < rest.size && rest.data[i] != ' ') {
+    ++i;
+  }
+  StringRef word(rest.data + start, i - start);
+  rest = StringRef(rest.data + i, rest.size - i);
+  return word;
+}
+
+// Digits only, at most 'maxValue'
+bool parseNumber(StringRef text, int maxValue, int &value) {
+  if (text.empty() || text.size > 10) {
+    return false;
+  }
+  long long parsed = 0;
+  for (std::size_t i = 0; i < text.size; ++i) {
+    if (text.data[i] < '0' || text.data[i] > '9') {
+      return false;
+    }
+    parsed = parsed * 10 + (text.data[i] - '0');
+  }
+  if (parsed > maxValue) {
+    return false;
+  }
+  value = static_cast<int>(parsed);
+  return true;
+}
+
+} // namespace
+
+// --- Connection ---
+
+struct RequestServer::Connection {
+  int fd;
+  std::string input;      // Received bytes not yet split into lines
+  std::string output;     // Responses; output[sent, size) is unsent
+  std::size_t sent;
+  std::uint32_t events;   // Current epoll interest
+  bool closing;           // Close once the output is sent
+  bool dead;              // Close at the end of the round
+  bool inRound;           // Listed in EventLoop::active
+
+  explicit Connection(int socket)
+      : fd(socket), sent(0), events(EPOLLIN), closing(false), dead(false),
+        inRound(false) {}
+};
+
+// --- EventLoop ---
+
+// One epoll instance and the connections it accepted. Loops share the
+// listening sockets (EPOLLEXCLUSIVE wakes one of them per connection) and
+// the stop eventfd, which is never read so that it wakes all of them.
+class RequestServer::EventLoop {
+private:
+  enum class Kind {
+    Book,
+    Cancel,
+    Itinerary,
+    Hold,
+    ConfirmHold,
+    ReleaseHold,
+    Query,
+    Passenger,
+    AddFlight,
+    Metrics,
+    Reply
+  };
+
+  // One parsed request line of the current round
+  struct Request {
+    Connection *connection;
+    Kind kind;
+    // Book, Cancel and the holds; flightId also for Query, AddFlight
+    BookingRequest booking;
+    std::vector<std::string> legs; // Itinerary; passengerId is in 'booking'
+    std::string text;       // Passenger name, or origin for AddFlight
+    std::string destination;
+    int capacity;           // AddFlight; hold seconds for Hold
+    BookingResult result;   // Book, Cancel
+    std::string reply;      // All other kinds, with the newline
+  };
+
+  RequestServer &server;
+  int epollFd;
+  std::vector<std::unique_ptr<Connection>> connections; // By descriptor
+  std::vector<Connection *> active; // Read from or writable this round
+  std::vector<Request> requests;    // This round, in arrival order
+  std::vector<BookingRequest> batch;
+  std::vector<BookingResult> results;
+  std::vector<char> readBuffer;
+
+  void watch(int fd, std::uint32_t events);
+  void acceptAll(int listener);
+  void markActive(Connection &connection);
+  void readInput(Connection &connection);
+  void parseRequest(Connection &connection, StringRef line);
+  void addReply(Connection &connection, std::string reply);
+  void execute();
+  void runSingle(Request &request);
+  void sendOutput(Connection &connection);
+  void updateInterest(Connection &connection);
+  void closeConnection(Connection &connection);
+
+public:
+  explicit EventLoop(RequestServer &owner);
+  ~EventLoop();
+
+  EventLoop(const EventLoop &) = delete;
+  EventLoop &operator=(const EventLoop &) = delete;
+
+  void run();
+};
+
+RequestServer::EventLoop::EventLoop(RequestServer &owner)
+    : server(owner), epollFd(::epoll_create1(EPOLL_CLOEXEC)),
+      readBuffer(READ_CHUNK_BYTES) {
+  if (epollFd < 0) {
+    fail("Cannot create epoll instance");
+  }
+  try {
+    watch(server.wakeFd, EPOLLIN);
+    if (server.tcpListener >= 0) {
+      watch(server.tcpListener, EPOLLIN | EPOLLEXCLUSIVE);
+    }
+    if (server.unixListener >= 0) {
+      watch(server.unixListener, EPOLLIN | EPOLLEXCLUSIVE);
+    }
+  } catch (...) {
+    ::close(epollFd);
+    throw;
+  }
+}
+
+RequestServer::EventLoop::~EventLoop() {
+  for (std::unique_ptr<Connection> &connection : connections) {
+    if (connection) {
+      ::close(connection->fd);
+    }
+  }
+  ::close(epollFd);
+}
+
+void RequestServer::EventLoop::watch(int fd, std::uint32_t events) {
+  epoll_event event;
+  event.events = events;
+  event.data.fd = fd;
+  if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+    fail("Cannot watch socket");
+  }
+}
+
+void RequestServer::EventLoop::run() {
+  epoll_event events[MAX_EVENTS];
+  bool stopping = false;
+  while (!stopping) {
+    int ready =
+        ::epoll_wait(epollFd, events, MAX_EVENTS, HOLD_EXPIRY_INTERVAL_MS);
+    if (ready < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fail("epoll_wait failed");
+    }
+    server.service.expireHolds(); // Before this round can book the seats
+
+    // Gather: accept, read and split every ready connection's input
+    for (int i = 0; i < ready; ++i) {
+      const int fd = events[i].data.fd;
+      if (fd == server.wakeFd) {
+        stopping = true; // Finish this round first
+      } else if (fd == server.tcpListener || fd == server.unixListener) {
+        acceptAll(fd);
+      } else {
+        Connection &connection = *connections[fd];
+        markActive(connection);
+        if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+          readInput(connection);
+        }
+      }
+    }
+
+    // Run the round's requests, make them durable, then answer
+    if (!requests.empty()) {
+      execute();
+      server.service.commit();
+      for (Request &request : requests) {
+        Connection &connection = *request.connection;
+        if (request.kind == Kind::Book || request.kind == Kind::Cancel) {
+          connection.output += toString(request.result);
+          connection.output += '\n';
+        } else {
+          connection.output += request.reply;
+        }
+      }
+      requests.clear();
+    }
+    for (Connection *connection : active) {
+      connection->inRound = false;
+      sendOutput(*connection);
+      if (connection->dead) {
+        closeConnection(*connection);
+      } else {
+        updateInterest(*connection);
+      }
+    }
+    active.clear();
+  }
+}
+
+void RequestServer::EventLoop::acceptAll(int listener) {
+  for (;;) {
+    int fd = ::accept4(listener, nullptr, nullptr,
+                       SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // EAGAIN: another loop took it or none left. Anything else (e.g.
+      // out of descriptors) is retried when the listener is next ready.
+      return;
+    }
+    if (listener == server.tcpListener) {
+      int one = 1;
+      ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    if (static_cast<std::size_t>(fd) >= connections.size()) {
+      connections.resize(static_cast<std::size_t>(fd) + 1);
+    }
+    connections[fd].reset(new Connection(fd));
+    watch(fd, EPOLLIN);
+  }
+}
+
+void RequestServer::EventLoop::markActive(Connection &connection) {
+  if (!connection.inRound) {
+    connection.inRound = true;
+    active.push_back(&connection);
+  }
+}
+
+void RequestServer::EventLoop::readInput(Connection &connection) {
+  if (connection.dead || connection.closing) {
+    return;
+  }
+  // Level-triggered: whatever is left over the budget is read next round,
+  // so one busy client cannot starve the others
+  std::size_t budget = READ_BUDGET_BYTES;
+  while (budget > 0) {
+    std::size_t wanted = std::min(budget, readBuffer.size());
+    ssize_t got = ::recv(connection.fd, readBuffer.data(), wanted, 0);
+    if (got > 0) {
+      connection.input.append(readBuffer.data(), static_cast<std::size_t>(got));
+      budget -= static_cast<std::size_t>(got);
+      if (static_cast<std::size_t>(got) < wanted) {
+        break; // Drained for now
+      }
+      continue;
+    }
+    if (got == 0) {
+      connection.closing = true; // Peer is done sending; answer, then close
+      break;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      connection.dead = true;
+    }
+    break;
+  }
+
+  std::size_t start = 0;
+  bool tooLong = false;
+  for (;;) {
+    const char *begin = connection.input.data() + start;
+    const void *newline =
+        std::memchr(begin, '\n', connection.input.size() - start);
+    if (newline == nullptr) {
+      tooLong = connection.input.size() - start > MAX_LINE_BYTES;
+      break;
+    }
+    std::size_t length = static_cast<const char *>(newline) - begin;
+    if (length > MAX_LINE_BYTES) {
+      tooLong = true;
+      break;
+    }
+    start += length + 1;
+    if (length > 0 && begin[length - 1] == '\r') {
+      --length;
+    }
+    if (length > 0) {
+      parseRequest(connection, StringRef(begin, length));
+    }
+  }
+  if (tooLong) {
+    addReply(connection, "error line_too_long\n");
+    connection.closing = true;
+    connection.input.clear();
+    return;
+  }
+  connection.input.erase(0, start);
+}
+
+void RequestServer::EventLoop::addReply(Connection &connection,
+                                        std::string reply) {
+  requests.push_back(Request());
+  Request &request = requests.back();
+  request.connection = &connection;
+  request.kind = Kind::Reply;
+  request.reply = std::move(reply);
+}
+
+void RequestServer::EventLoop::parseRequest(Connection &connection,
+                                            StringRef line) {
+  StringRef rest = line;
+  StringRef verb = nextWord(rest);
+  if (verb == "ping") {
+    addReply(connection, nextWord(rest).empty() ? "pong\n"
+                                                : "error bad_arguments\n");
+    return;
+  }
+
+  Request request;
+  request.connection = &connection;
+  request.capacity = 0;
+  request.result = BookingResult::UnknownFlight;
+  bool valid = true;
+  if (verb == "book" || verb == "cancel") {
+    request.kind = verb == "book" ? Kind::Book : Kind::Cancel;
+    StringRef passengerId = nextWord(rest);
+    StringRef flightId = nextWord(rest);
+    valid = parseNumber(passengerId, 0x7FFFFFFF, request.booking.passengerId) &&
+            !flightId.empty() && nextWord(rest).empty();
+    request.booking.flightId = flightId.str();
+  } else if (verb == "itinerary") {
+    request.kind = Kind::Itinerary;
+    valid = parseNumber(nextWord(rest), 0x7FFFFFFF,
+                        request.booking.passengerId);
+    for (StringRef flightId = nextWord(rest); !flightId.empty();
+         flightId = nextWord(rest)) {
+      request.legs.push_back(flightId.str());
+    }
+    for (std::size_t leg = 1; valid && leg < request.legs.size(); ++leg) {
+      valid = std::find(request.legs.begin(), request.legs.begin() + leg,
+                        request.legs[leg]) == request.legs.begin() + leg;
+    }
+    valid = valid && !request.legs.empty();
+  } else if (verb == "hold" || verb == "confirm" || verb == "release") {
+    request.kind = verb == "hold"      ? Kind::Hold
+                   : verb == "confirm" ? Kind::ConfirmHold
+                                       : Kind::ReleaseHold;
+    StringRef passengerId = nextWord(rest);
+    StringRef flightId = nextWord(rest);
+    valid = parseNumber(passengerId, 0x7FFFFFFF, request.booking.passengerId) &&
+            !flightId.empty() &&
+            (request.kind != Kind::Hold ||
+             parseNumber(nextWord(rest), MAX_HOLD_SECONDS, request.capacity)) &&
+            nextWord(rest).empty();
+    request.booking.flightId = flightId.str();
+  } else if (verb == "query") {
+    request.kind = Kind::Query;
+    StringRef flightId = nextWord(rest);
+    valid = !flightId.empty() && nextWord(rest).empty();
+    request.booking.flightId = flightId.str();
+  } else if (verb == "passenger") {
+    request.kind = Kind::Passenger;
+    StringRef name = rest;
+    while (!name.empty() && name.data[0] == ' ') {
+      name = StringRef(name.data + 1, name.size - 1);
+    }
+    valid = !name.empty();
+    request.text = name.str();
+  } else if (verb == "flight") {
+    request.kind = Kind::AddFlight;
+    StringRef flightId = nextWord(rest);
+    StringRef origin = nextWord(rest);
+    StringRef destination = nextWord(rest);
+    valid = !destination.empty() && FlightCode::fits(flightId) &&
+            FlightCode::fits(origin) && FlightCode::fits(destination) &&
+            parseNumber(nextWord(rest), MAX_CAPACITY, request.capacity) &&
+            nextWord(rest).empty();
+    request.booking.flightId = flightId.str();
+    request.text = origin.str();
+    request.destination = destination.str();
+  } else if (verb == "metrics") {
+    request.kind = Kind::Metrics;
+    valid = nextWord(rest).empty();
+  } else {
+    addReply(connection, "error unknown_command\n");
+    return;
+  }
+  if (!valid) {
+    addReply(connection, "error bad_arguments\n");
+    return;
+  }
+  requests.push_back(std::move(request));
+}
+
+// Runs of consecutive book (or cancel) requests go to the service as one
+// batch; everything else runs on its own, in order between the batches
+void RequestServer::EventLoop::execute() {
+  std::size_t i = 0;
+  while (i < requests.size()) {
+    const Kind kind = requests[i].kind;
+    if (kind != Kind::Book && kind != Kind::Cancel) {
+      runSingle(requests[i++]);
+      continue;
+    }
+    std::size_t end = i;
+    batch.clear();
+    while (end < requests.size() && requests[end].kind == kind) {
+      batch.push_back(std::move(requests[end].booking));
+      ++end;
+    }
+    if (kind == Kind::Book) {
+      server.service.bookBatch(batch, results);
+    } else {
+      server.service.cancelBatch(batch, results);
+    }
+    for (std::size_t k = 0; k < results.size(); ++k) {
+      requests[i + k].result = results[k];
+    }
+    i = end;
+  }
+}
+
+void RequestServer::EventLoop::runSingle(Request &request) {
+  BookingService &service = server.service;
+  switch (request.kind) {
+  case Kind::Itinerary: {
+    ItineraryResult outcome =
+        service.bookItinerary(request.booking.passengerId, request.legs);
+    request.reply = toString(outcome.result);
+    if (outcome.failedLeg != ItineraryResult::NO_LEG) {
+      request.reply += ' ' + request.legs[outcome.failedLeg];
+    }
+    request.reply += '\n';
+    break;
+  }
+  case Kind::Hold:
+    request.reply = toString(service.holdSeat(
+        request.booking.passengerId, request.booking.flightId,
+        std::chrono::seconds(request.capacity)));
+    request.reply += '\n';
+    break;
+  case Kind::ConfirmHold:
+    request.reply = toString(service.confirmHold(request.booking.passengerId,
+                                                 request.booking.flightId));
+    request.reply += '\n';
+    break;
+  case Kind::ReleaseHold:
+    request.reply = toString(service.releaseHold(request.booking.passengerId,
+                                                 request.booking.flightId));
+    request.reply += '\n';
+    break;
+  case Kind::Query: {
+    FlightStatus status;
+    if (!service.queryFlight(request.booking.flightId, status)) {
+      request.reply = "unknown_flight\n";
+      break;
+    }
+    request.reply = "flight " + status.flightId + ' ' + status.origin + ' ' +
+                    status.destination + ' ' + std::to_string(status.capacity) +
+                    ' ' + std::to_string(status.booked) + ' ' +
+                    std::to_string(status.waitlisted) + ' ' +
+                    std::to_string(status.held) + '\n';
+    break;
+  }
+  case Kind::Passenger:
+    request.reply =
+        "passenger " + std::to_string(service.addPassenger(request.text)) + '\n';
+    break;
+  case Kind::AddFlight:
+    request.reply = service.addFlight(request.booking.flightId, request.text,
+                                      request.destination, request.capacity)
+                        ? "ok\n"
+                        : "exists\n";
+    break;
+  case Kind::Metrics: {
+    std::ostringstream text;
+    writePrometheus(text);
+    text << "# EOF\n";
+    request.reply = text.str();
+    break;
+  }
+  default: // Reply: answered while parsing
+    break;
+  }
+}
+
+void RequestServer::EventLoop::sendOutput(Connection &connection) {
+  while (!connection.dead && connection.sent < connection.output.size()) {
+    ssize_t written = ::send(connection.fd,
+                             connection.output.data() + connection.sent,
+                             connection.output.size() - connection.sent,
+                             MSG_NOSIGNAL);
+    if (written >= 0) {
+      connection.sent += static_cast<std::size_t>(written);
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return; // Rest goes out on EPOLLOUT
+    } else if (errno != EINTR) {
+      connection.dead = true;
+    }
+  }
+  connection.output.clear();
+  connection.sent = 0;
+  if (connection.closing) {
+    connection.dead = true;
+  }
+}
+
+void RequestServer::EventLoop::updateInterest(Connection &connection) {
+  const std::size_t unsent = connection.output.size() - connection.sent;
+  std::uint32_t wanted = 0;
+  if (!connection.closing && unsent <= MAX_PENDING_OUTPUT) {
+    wanted |= EPOLLIN; // Paused above the limit until the client reads
+  }
+  if (unsent > 0) {
+    wanted |= EPOLLOUT;
+  }
+  if (wanted == connection.events) {
+    return;
+  }
+  epoll_event event;
+  event.events = wanted;
+  event.data.fd = connection.fd;
+  if (::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event) != 0) {
+    fail("Cannot update socket events");
+  }
+  connection.events = wanted;
+}
+
+void RequestServer::EventLoop::closeConnection(Connection &connection) {
+  const int fd = connection.fd;
+  ::close(fd); // Also drops it from the epoll set
+  connections[fd].reset();
+}
+
+// --- RequestServer ---
+
+RequestServer::RequestServer(BookingService &bookingService,
+                             const ServerOptions &opts)
+    : service(bookingService), options(opts), tcpListener(-1),
+      unixListener(-1), wakeFd(-1), boundPort(-1) {
+  if (options.port < -1 || options.port > 65535) {
+    throw std::invalid_argument("Invalid port " + std::to_string(options.port));
+  }
+  if (options.port < 0 && options.unixPath.empty()) {
+    throw std::invalid_argument("Server has no TCP port or Unix socket");
+  }
+  if (options.threads == 0) {
+    throw std::invalid_argument("Server needs at least one thread");
+  }
+  if (options.threads > 1 && !service.isThreadSafe()) {
+    throw std::invalid_argument(
+        "This booking service cannot be served from several threads");
+  }
+  try {
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+      fail("Cannot create eventfd");
+    }
+    if (options.port >= 0) {
+      listenTcp();
+    }
+    if (!options.unixPath.empty()) {
+      listenUnix();
+    }
+  } catch (...) {
+    closeSockets();
+    throw;
+  }
+}
+
+RequestServer::~RequestServer() { closeSockets(); }
+
+void RequestServer::closeSockets() {
+  if (tcpListener >= 0) {
+    ::close(tcpListener);
+    tcpListener = -1;
+  }
+  if (unixListener >= 0) {
+    ::close(unixListener);
+    unixListener = -1;
+    ::unlink(options.unixPath.c_str());
+  }
+  if (wakeFd >= 0) {
+    ::close(wakeFd);
+    wakeFd = -1;
+  }
+}
+
+void RequestServer::listenTcp() {
+  const std::string where = options.host + ':' + std::to_string(options.port);
+  sockaddr_storage address;
+  std::memset(&address, 0, sizeof(address));
+  socklen_t length;
+  sockaddr_in *v4 = reinterpret_cast<sockaddr_in *>(&address);
+  sockaddr_in6 *v6 = reinterpret_cast<sockaddr_in6 *>(&address);
+  if (::inet_pton(AF_INET, options.host.c_str(), &v4->sin_addr) == 1) {
+    v4->sin_family = AF_INET;
+    v4->sin_port = htons(static_cast<std::uint16_t>(options.port));
+    length = sizeof(*v4);
+  } else if (::inet_pton(AF_INET6, options.host.c_str(), &v6->sin6_addr) ==
+             1) {
+    v6->sin6_family = AF_INET6;
+    v6->sin6_port = htons(static_cast<std::uint16_t>(options.port));
+    length = sizeof(*v6);
+  } else {
+    throw std::invalid_argument("Invalid listen address '" + options.host +
+                                "'");
+  }
+
+  tcpListener =
+      ::socket(address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (tcpListener < 0) {
+    fail("Cannot create socket for " + where);
+  }
+  int one = 1;
+  ::setsockopt(tcpListener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  if (::bind(tcpListener, reinterpret_cast<sockaddr *>(&address), length) !=
+          0 ||
+      ::listen(tcpListener, SOMAXCONN) != 0) {
+    fail("Cannot listen on " + where);
+  }
+  if (::getsockname(tcpListener, reinterpret_cast<sockaddr *>(&address),
+                    &length) != 0) {
+    fail("Cannot read the address of " + where);
+  }
+  boundPort = ntohs(address.ss_family == AF_INET ? v4->sin_port : v6->sin6_port);
+}
+
+void RequestServer::listenUnix() {
+  const std::string &path = options.unixPath;
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  if (path.size() >= sizeof(address.sun_path)) {
+    throw std::invalid_argument("Unix socket path too long: '" + path + "'");
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  // A socket file left by a server that did not shut down cleanly would
+  // make bind() fail; anything else at the path is not ours to remove
+  struct stat info;
+  if (::lstat(path.c_str(), &info) == 0) {
+    if (!S_ISSOCK(info.st_mode)) {
+      throw std::runtime_error("Cannot listen on '" + path +
+                               "': not a socket");
+    }
+    ::unlink(path.c_str());
+  }
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    fail("Cannot create socket for '" + path + "'");
+  }
+  if (::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) !=
+      0) {
+    int error = errno;
+    ::close(fd);
+    errno = error;
+    fail("Cannot listen on '" + path + "'");
+  }
+  unixListener = fd; // From here on the path is unlinked on close
+  if (::listen(unixListener, SOMAXCONN) != 0) {
+    fail("Cannot listen on '" + path + "'");
+  }
+}
+
+void RequestServer::run() {
+  const std::size_t extra = options.threads - 1;
+  std::vector<std::thread> workers;
+  std::vector<std::exception_ptr> errors(extra + 1);
+  for (std::size_t i = 0; i < extra; ++i) {
+    std::exception_ptr &error = errors[i + 1];
+    workers.emplace_back([this, &error] {
+      try {
+        EventLoop(*this).run();
+      } catch (...) {
+        error = std::current_exception();
+        stop(); // Take the other loops down with it
+      }
+    });
+  }
+  try {
+    EventLoop(*this).run();
+  } catch (...) {
+    errors[0] = std::current_exception();
+    stop();
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  for (const std::exception_ptr &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+void RequestServer::stop() {
+  std::uint64_t one = 1;
+  ssize_t ignored = ::write(wakeFd, &one, sizeof(one));
+  (void)ignored;
+}
+
+int RequestServer::getPort() const { return boundPort; }
@@ -0,0 +1,32 @@
+// src/storage/BinaryCodec.cpp
+#include "storage/BinaryCodec.h"
+
+namespace {
+
+// Byte-at-a-time table for the reflected polynomial 0xEDB88320
+struct Crc32Table {
+  std::uint32_t entries[256];
+
+  Crc32Table() {
+    for (std::uint32_t i = 0; i < 256; ++i) {
+      std::uint32_t c = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      entries[i] = c;
+    }
+  }
+};
+
+const Crc32Table crcTable;
+
+} // namespace
+
+std::uint32_t crc32(const void *data, std::size_t length, std::uint32_t crc) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  crc = ~crc;
+  for (std::size_t i = 0; i < length; ++i) {
+    crc = crcTable.entries[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
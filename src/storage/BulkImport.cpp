@@ -0,0 +1,404 @@
+// src/storage/BulkImport.cpp
+#include "storage/BulkImport.h"
+#include "common/InlineCode.h"
+#include <cstring> // For std::memchr, std::memcmp, std::memcpy, std::memmove
+#include <fcntl.h>
+#include <stdexcept>
+
+namespace {
+
+const char SCHEDULE_MAGIC[] = "BSCH";
+const char MANIFEST_MAGIC[] = "BMAN";
+const std::size_t MAGIC_BYTES = 4;
+const std::size_t SCHEDULE_RECORD_BYTES = 12; // Fixed part, then strings
+const std::size_t MANIFEST_RECORD_BYTES = 4;
+const int MAX_CAPACITY = 1000000;
+
+std::uint16_t readU16(const char *p) {
+  std::uint16_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+// Non-negative decimal up to MAX_CAPACITY, nothing else
+bool parseCapacity(StringRef text, int &capacity) {
+  if (text.empty() || text.size > 7) {
+    return false;
+  }
+  int value = 0;
+  for (std::size_t i = 0; i < text.size; ++i) {
+    if (text.data[i] < '0' || text.data[i] > '9') {
+      return false;
+    }
+    value = value * 10 + (text.data[i] - '0');
+  }
+  if (value > MAX_CAPACITY) {
+    return false;
+  }
+  capacity = value;
+  return true;
+}
+
+bool parseBackend(StringRef text, WaitlistBackend &backend) {
+  if (text.empty()) {
+    backend = WaitlistBackend::Binomial;
+    return true;
+  }
+  const WaitlistBackend all[] = {WaitlistBackend::Binomial,
+                                 WaitlistBackend::Pairing,
+                                 WaitlistBackend::Quaternary,
+                                 WaitlistBackend::Radix};
+  for (WaitlistBackend candidate : all) {
+    const char *name = toString(candidate);
+    if (text == StringRef(name, std::strlen(name))) {
+      backend = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Flights keep these fields inline, see common/InlineCode.h
+bool fitsFlightCodes(const ScheduleRow &row) {
+  return FlightCode::fits(row.flightId) && FlightCode::fits(row.origin) &&
+         FlightCode::fits(row.destination);
+}
+
+} // namespace
+
+// --- BulkReader ---
+
+BulkReader::BulkReader()
+    : begin(0), end(0), atEof(false), binary(false), sampling(false),
+      sampleStart(0), fileSize(0), rowNumber(0), rejected(0), sampleRows(0),
+      sampleBytes(0) {}
+
+void BulkReader::open(const std::string &path, const char *magic) {
+  file = FileHandle(path, O_RDONLY);
+  fileSize = file.size();
+  buffer.resize(CHUNK_BYTES);
+  fill(MAGIC_BYTES);
+  binary = end - begin >= MAGIC_BYTES &&
+           std::memcmp(&buffer[begin], magic, MAGIC_BYTES) == 0;
+  if (binary) {
+    begin += MAGIC_BYTES;
+  }
+}
+
+bool BulkReader::isBinary() const { return binary; }
+
+bool BulkReader::fill(std::size_t count) {
+  if (end - begin >= count) {
+    return true;
+  }
+  if (atEof || sampling) {
+    return false;
+  }
+  // Carry the unread tail (a partial row) to the front, then top up
+  std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+  end -= begin;
+  begin = 0;
+  if (count > buffer.size()) {
+    buffer.resize(count); // A single row longer than a chunk
+  }
+  while (end < count && !atEof) {
+    std::size_t wanted = buffer.size() - end;
+    std::size_t got = file.readSome(buffer.data() + end, wanted);
+    end += got;
+    atEof = got < wanted;
+  }
+  return end >= count;
+}
+
+bool BulkReader::nextCsvRow(const char *headerName) {
+  for (;;) {
+    // Find the end of the line, reading more until it is buffered
+    const char *line = nullptr;
+    std::size_t length = 0;
+    std::size_t scanned = 0;
+    for (;;) {
+      const char *start = buffer.data() + begin;
+      const void *newline =
+          std::memchr(start + scanned, '\n', end - begin - scanned);
+      if (newline != nullptr) {
+        line = start;
+        length = static_cast<const char *>(newline) - start;
+        begin += length + 1;
+        break;
+      }
+      scanned = end - begin;
+      if (!fill(scanned + 1)) {
+        if (sampling && !atEof) {
+          return false; // The rest of this row is not buffered yet
+        }
+        if (begin == end) {
+          return false;
+        }
+        line = buffer.data() + begin; // Last line, no newline
+        length = end - begin;
+        begin = end;
+        break;
+      }
+    }
+    ++rowNumber;
+    if (length > 0 && line[length - 1] == '\r') {
+      --length;
+    }
+    if (length == 0) {
+      continue; // Blank lines are not rows
+    }
+
+    // Split. Unescaped fields go into 'scratch', which is reserved to the
+    // line length up front so its StringRefs cannot move.
+    fields.clear();
+    scratch.clear();
+    scratch.reserve(length);
+    bool malformed = false;
+    std::size_t i = 0;
+    for (;;) {
+      if (i < length && line[i] == '"') {
+        std::size_t first = ++i;
+        bool escaped = false;
+        for (;;) {
+          const void *quote = std::memchr(line + i, '"', length - i);
+          if (quote == nullptr) {
+            i = length + 1; // Unterminated
+            break;
+          }
+          i = static_cast<const char *>(quote) - line;
+          if (i + 1 < length && line[i + 1] == '"') {
+            escaped = true;
+            i += 2;
+            continue;
+          }
+          break;
+        }
+        if (i > length || (i + 1 < length && line[i + 1] != ',')) {
+          malformed = true;
+          break;
+        }
+        if (!escaped) {
+          fields.push_back(StringRef(line + first, i - first));
+        } else {
+          std::size_t start = scratch.size();
+          for (std::size_t k = first; k < i; ++k) {
+            scratch.push_back(line[k]);
+            if (line[k] == '"') {
+              ++k; // Second quote of the pair
+            }
+          }
+          fields.push_back(
+              StringRef(scratch.data() + start, scratch.size() - start));
+        }
+        ++i; // Closing quote
+      } else {
+        const void *comma = std::memchr(line + i, ',', length - i);
+        std::size_t stop =
+            comma == nullptr ? length : static_cast<const char *>(comma) - line;
+        fields.push_back(StringRef(line + i, stop - i));
+        i = stop;
+      }
+      if (i >= length) {
+        break;
+      }
+      ++i; // Comma; a trailing one ends with an empty field
+      if (i == length) {
+        fields.push_back(StringRef());
+        break;
+      }
+    }
+    if (malformed) {
+      reject("unbalanced quotes");
+      continue;
+    }
+    if (rowNumber == 1 &&
+        fields[0] == StringRef(headerName, std::strlen(headerName))) {
+      continue;
+    }
+    return true;
+  }
+}
+
+const char *BulkReader::nextBytes(std::size_t length, bool recordStart) {
+  if (recordStart) {
+    if (begin == end && !fill(1)) {
+      return nullptr;
+    }
+    ++rowNumber;
+  }
+  if (!fill(length)) {
+    if (sampling && !atEof) {
+      return nullptr;
+    }
+    throw std::runtime_error("Truncated record " +
+                             std::to_string(rowNumber) + " in '" +
+                             file.getPath() + "'");
+  }
+  const char *bytes = buffer.data() + begin;
+  begin += length;
+  return bytes;
+}
+
+void BulkReader::reject(const char *reason) {
+  if (rejected++ == 0) {
+    firstError = (binary ? "record " : "line ") + std::to_string(rowNumber) +
+                 ": " + reason;
+  }
+}
+
+void BulkReader::beginSample() {
+  sampling = true;
+  sampleStart = begin;
+}
+
+void BulkReader::endSample(std::size_t rows) {
+  sampleRows = rows;
+  sampleBytes = begin - sampleStart;
+  begin = sampleStart;
+  sampling = false;
+  rowNumber = 0;
+  rejected = 0;
+  firstError.clear();
+}
+
+std::size_t BulkReader::extrapolate(std::size_t sampled) const {
+  if (sampleBytes == 0) {
+    return 0;
+  }
+  const double dataBytes =
+      static_cast<double>(fileSize - (binary ? MAGIC_BYTES : 0));
+  return static_cast<std::size_t>(static_cast<double>(sampled) * dataBytes /
+                                  static_cast<double>(sampleBytes));
+}
+
+std::size_t BulkReader::estimatedRows() const { return extrapolate(sampleRows); }
+std::uint64_t BulkReader::getRowNumber() const { return rowNumber; }
+std::size_t BulkReader::getRejectedCount() const { return rejected; }
+const std::string &BulkReader::getFirstError() const { return firstError; }
+
+// --- ScheduleReader ---
+
+ScheduleReader::ScheduleReader(const std::string &path) {
+  open(path, SCHEDULE_MAGIC);
+  beginSample();
+  std::size_t rows = 0;
+  ScheduleRow row;
+  while (next(row)) {
+    ++rows;
+  }
+  endSample(rows);
+}
+
+bool ScheduleReader::next(ScheduleRow &row) {
+  if (isBinary()) {
+    for (;;) {
+      const char *fixed = nextBytes(SCHEDULE_RECORD_BYTES, true);
+      if (fixed == nullptr) {
+        return false;
+      }
+      const std::size_t idLength = readU16(fixed);
+      const std::size_t originLength = readU16(fixed + 2);
+      const std::size_t destinationLength = readU16(fixed + 4);
+      const std::uint8_t backend = static_cast<std::uint8_t>(fixed[6]);
+      std::int32_t capacity;
+      std::memcpy(&capacity, fixed + 8, sizeof(capacity));
+      const char *strings =
+          nextBytes(idLength + originLength + destinationLength, false);
+      if (strings == nullptr) {
+        return false; // Sampling reached the end of the buffer
+      }
+      if (idLength == 0 || capacity < 0 || capacity > MAX_CAPACITY ||
+          backend > static_cast<std::uint8_t>(WaitlistBackend::Radix)) {
+        reject("bad flight record");
+        continue;
+      }
+      row.flightId = StringRef(strings, idLength);
+      row.origin = StringRef(strings + idLength, originLength);
+      row.destination =
+          StringRef(strings + idLength + originLength, destinationLength);
+      if (!fitsFlightCodes(row)) {
+        reject("flight ID or airport too long");
+        continue;
+      }
+      row.capacity = capacity;
+      row.backend = static_cast<WaitlistBackend>(backend);
+      return true;
+    }
+  }
+  while (nextCsvRow("flight_id")) {
+    if (fields.size() < 4 || fields.size() > 5 || fields[0].empty()) {
+      reject("expected flight_id,origin,destination,capacity[,backend]");
+      continue;
+    }
+    if (!parseCapacity(fields[3], row.capacity)) {
+      reject("bad capacity");
+      continue;
+    }
+    if (!parseBackend(fields.size() == 5 ? fields[4] : StringRef(),
+                      row.backend)) {
+      reject("unknown waitlist backend");
+      continue;
+    }
+    row.flightId = fields[0];
+    row.origin = fields[1];
+    row.destination = fields[2];
+    if (!fitsFlightCodes(row)) {
+      reject("flight ID or airport too long");
+      continue;
+    }
+    return true;
+  }
+  return false;
+}
+
+// --- ManifestReader ---
+
+ManifestReader::ManifestReader(const std::string &path) : sampleNameBytes(0) {
+  open(path, MANIFEST_MAGIC);
+  beginSample();
+  std::size_t rows = 0;
+  ManifestRow row;
+  while (next(row)) {
+    ++rows;
+    sampleNameBytes += row.name.size;
+  }
+  endSample(rows);
+}
+
+bool ManifestReader::next(ManifestRow &row) {
+  if (isBinary()) {
+    for (;;) {
+      const char *fixed = nextBytes(MANIFEST_RECORD_BYTES, true);
+      if (fixed == nullptr) {
+        return false;
+      }
+      const std::size_t nameLength = readU16(fixed);
+      const std::size_t flightLength = readU16(fixed + 2);
+      const char *strings = nextBytes(nameLength + flightLength, false);
+      if (strings == nullptr) {
+        return false; // Sampling reached the end of the buffer
+      }
+      if (nameLength == 0) {
+        reject("empty passenger name");
+        continue;
+      }
+      row.name = StringRef(strings, nameLength);
+      row.flightId = StringRef(strings + nameLength, flightLength);
+      return true;
+    }
+  }
+  while (nextCsvRow("name")) {
+    if (fields.size() > 2 || fields[0].empty()) {
+      reject("expected name[,flight_id]");
+      continue;
+    }
+    row.name = fields[0];
+    row.flightId = fields.size() == 2 ? fields[1] : StringRef();
+    return true;
+  }
+  return false;
+}
+
+std::size_t ManifestReader::estimatedNameBytes() const {
+  return extrapolate(sampleNameBytes);
+}
@@ -0,0 +1,222 @@
+// src/storage/FileHandle.cpp
+#include "storage/FileHandle.h"
+#include <cerrno>
+#include <cstring>   // For std::strerror
+#include <fcntl.h>
+#include <stdexcept> // For std::runtime_error
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace {
+
+[[noreturn]] void fail(const char *what, const std::string &path) {
+  throw std::runtime_error(std::string(what) + " '" + path +
+                           "': " + std::strerror(errno));
+}
+
+int syncDescriptor(int fd) {
+#if defined(__linux__)
+  return ::fdatasync(fd); // Size changes are still flushed, mtime is not
+#else
+  return ::fsync(fd);
+#endif
+}
+
+std::string parentOf(const std::string &path) {
+  std::string::size_type slash = path.find_last_of('/');
+  if (slash == std::string::npos) {
+    return ".";
+  }
+  return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+} // namespace
+
+FileHandle::FileHandle() : fd(-1) {}
+
+FileHandle::FileHandle(const std::string &p, int flags) : fd(-1), path(p) {
+  fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    fail("Cannot open", path);
+  }
+}
+
+FileHandle::~FileHandle() {
+  if (fd >= 0) {
+    ::close(fd);
+  }
+}
+
+FileHandle::FileHandle(FileHandle &&other)
+    : fd(other.fd), path(std::move(other.path)) {
+  other.fd = -1;
+}
+
+FileHandle &FileHandle::operator=(FileHandle &&other) {
+  if (this != &other) {
+    close();
+    fd = other.fd;
+    path = std::move(other.path);
+    other.fd = -1;
+  }
+  return *this;
+}
+
+bool FileHandle::isOpen() const { return fd >= 0; }
+const std::string &FileHandle::getPath() const { return path; }
+
+void FileHandle::close() {
+  if (fd >= 0) {
+    int result = ::close(fd);
+    fd = -1;
+    if (result != 0) {
+      fail("Cannot close", path);
+    }
+  }
+}
+
+void FileHandle::writeAll(const void *data, std::size_t length) {
+  const char *bytes = static_cast<const char *>(data);
+  while (length > 0) {
+    ssize_t written = ::write(fd, bytes, length);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fail("Cannot write", path);
+    }
+    bytes += written;
+    length -= static_cast<std::size_t>(written);
+  }
+}
+
+std::size_t FileHandle::readSome(void *data, std::size_t length) {
+  char *bytes = static_cast<char *>(data);
+  std::size_t total = 0;
+  while (total < length) {
+    ssize_t got = ::read(fd, bytes + total, length - total);
+    if (got < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fail("Cannot read", path);
+    }
+    if (got == 0) {
+      break; // End of file
+    }
+    total += static_cast<std::size_t>(got);
+  }
+  return total;
+}
+
+void FileHandle::sync() {
+  if (syncDescriptor(fd) != 0) {
+    fail("Cannot sync", path);
+  }
+}
+
+void FileHandle::truncate(std::uint64_t length) {
+  if (::ftruncate(fd, static_cast<off_t>(length)) != 0) {
+    fail("Cannot truncate", path);
+  }
+}
+
+std::uint64_t FileHandle::size() const {
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    fail("Cannot stat", path);
+  }
+  return static_cast<std::uint64_t>(info.st_size);
+}
+
+void FileHandle::seekToEnd() {
+  if (::lseek(fd, 0, SEEK_END) < 0) {
+    fail("Cannot seek", path);
+  }
+}
+
+void FileHandle::writeAt(std::uint64_t offset, const void *data,
+                         std::size_t length) {
+  const char *bytes = static_cast<const char *>(data);
+  while (length > 0) {
+    ssize_t written = ::pwrite(fd, bytes, length, static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fail("Cannot write", path);
+    }
+    bytes += written;
+    offset += static_cast<std::uint64_t>(written);
+    length -= static_cast<std::size_t>(written);
+  }
+}
+
+MappedFile::MappedFile() : data(nullptr), length(0) {}
+
+MappedFile::MappedFile(const std::string &path) : data(nullptr), length(0) {
+  FileHandle file(path, O_RDONLY);
+  length = static_cast<std::size_t>(file.size());
+  if (length == 0) {
+    return; // mmap rejects empty mappings
+  }
+  void *mapped = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, file.fd, 0);
+  if (mapped == MAP_FAILED) {
+    length = 0;
+    fail("Cannot map", path);
+  }
+  data = static_cast<const char *>(mapped);
+  // The mapping keeps the file alive; the descriptor closes here
+}
+
+MappedFile::~MappedFile() { unmap(); }
+
+MappedFile::MappedFile(MappedFile &&other)
+    : data(other.data), length(other.length) {
+  other.data = nullptr;
+  other.length = 0;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) {
+  if (this != &other) {
+    unmap();
+    data = other.data;
+    length = other.length;
+    other.data = nullptr;
+    other.length = 0;
+  }
+  return *this;
+}
+
+const char *MappedFile::getData() const { return data; }
+std::size_t MappedFile::getSize() const { return length; }
+
+void MappedFile::unmap() {
+  if (data != nullptr) {
+    ::munmap(const_cast<char *>(data), length);
+    data = nullptr;
+  }
+  length = 0;
+}
+
+bool pathExists(const std::string &path) {
+  struct stat info;
+  return ::stat(path.c_str(), &info) == 0;
+}
+
+void makeDirectory(const std::string &path) {
+  if (::mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+    fail("Cannot create directory", path);
+  }
+}
+
+void renameDurably(const std::string &from, const std::string &to) {
+  if (::rename(from.c_str(), to.c_str()) != 0) {
+    fail("Cannot rename", from);
+  }
+  // The new directory entry must reach the disk too
+  FileHandle directory(parentOf(to), O_RDONLY | O_DIRECTORY);
+  directory.sync();
+}
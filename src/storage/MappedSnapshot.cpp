@@ -0,0 +1,243 @@
+// src/storage/MappedSnapshot.cpp
+#include "storage/MappedSnapshot.h"
+#include "booking/FlightIndex.h" // For FlightIndex::hashId
+#include "common/InlineCode.h"   // For FlightCode::MAX_LENGTH
+#include "storage/BinaryCodec.h" // For crc32
+#include <cstddef>               // For offsetof
+#include <cstring>               // For std::memcpy, std::memcmp
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const char SNAPSHOT_MAGIC[4] = {'B', 'S', 'N', 'P'};
+const std::uint32_t ENDIAN_TAG = 0x01020304u;
+
+// True if 'count' elements of 'size' bytes at 'offset' lie inside the file
+// and start suitably aligned
+bool fits(std::uint64_t offset, std::uint64_t count, std::uint64_t size,
+          std::uint64_t fileSize) {
+  return offset % 8 == 0 && offset <= fileSize &&
+         count <= (fileSize - offset) / size;
+}
+
+// [begin, begin + count) within [0, total)
+bool inRange(std::uint64_t begin, std::uint64_t count, std::uint64_t total) {
+  return begin <= total && count <= total - begin;
+}
+
+} // namespace
+
+MappedSnapshot::MappedSnapshot()
+    : nameOffsets(nullptr), names(nullptr), flights(nullptr), slots(nullptr),
+      strings(nullptr), seats(nullptr), waitlist(nullptr) {
+  std::memset(&header, 0, sizeof(header));
+}
+
+void MappedSnapshot::corrupt() const {
+  throw std::runtime_error("Corrupt snapshot file");
+}
+
+bool MappedSnapshot::open(const std::string &path) {
+  close();
+  if (!pathExists(path)) {
+    return false;
+  }
+  MappedFile mapped(path);
+  const std::uint64_t size = mapped.getSize();
+  if (size < sizeof(SnapshotHeader)) {
+    throw std::runtime_error("Corrupt snapshot '" + path + "'");
+  }
+  std::memcpy(&header, mapped.getData(), sizeof(header));
+  if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) !=
+      0) {
+    throw std::runtime_error("Not a snapshot file: '" + path + "'");
+  }
+  if (header.version != VERSION || header.headerSize != sizeof(header) ||
+      header.endianTag != ENDIAN_TAG) {
+    throw std::runtime_error("Unsupported snapshot version or byte order in '" +
+                             path + "'");
+  }
+  const bool sane =
+      header.headerCrc ==
+          crc32(&header, offsetof(SnapshotHeader, headerCrc)) &&
+      header.fileSize == size &&
+      fits(header.passengerOffsetsOffset, header.passengerCount + 1, 8,
+           size) &&
+      fits(header.namesOffset, header.namesSize, 1, size) &&
+      fits(header.flightsOffset, header.flightCount,
+           sizeof(SnapshotFlightRecord), size) &&
+      header.hashSlots >= header.flightCount && header.hashSlots > 0 &&
+      (header.hashSlots & (header.hashSlots - 1)) == 0 &&
+      header.hashSlots <= 0xFFFFFFFFu &&
+      fits(header.slotsOffset, header.hashSlots, 4, size) &&
+      fits(header.stringsOffset, header.stringsSize, 1, size) &&
+      fits(header.seatsOffset, header.seatCount, 4, size) &&
+      fits(header.waitlistOffset, header.waitlistCount,
+           sizeof(SnapshotWaitlistEntry), size);
+  if (!sane) {
+    throw std::runtime_error("Corrupt snapshot '" + path + "'");
+  }
+
+  const char *base = mapped.getData();
+  nameOffsets = reinterpret_cast<const std::uint64_t *>(
+      base + header.passengerOffsetsOffset);
+  // Name offsets are copied as they are into a PassengerTable, so they
+  // must be checked up front; one pass over 8 bytes per passenger
+  if (nameOffsets[0] != 0 ||
+      nameOffsets[header.passengerCount] != header.namesSize) {
+    throw std::runtime_error("Corrupt snapshot '" + path + "'");
+  }
+  for (std::uint64_t i = 0; i < header.passengerCount; ++i) {
+    if (nameOffsets[i] > nameOffsets[i + 1]) {
+      throw std::runtime_error("Corrupt snapshot '" + path + "'");
+    }
+  }
+  names = base + header.namesOffset;
+  flights =
+      reinterpret_cast<const SnapshotFlightRecord *>(base + header.flightsOffset);
+  slots = reinterpret_cast<const std::uint32_t *>(base + header.slotsOffset);
+  strings = base + header.stringsOffset;
+  seats = reinterpret_cast<const std::int32_t *>(base + header.seatsOffset);
+  waitlist = reinterpret_cast<const SnapshotWaitlistEntry *>(
+      base + header.waitlistOffset);
+  file = std::move(mapped);
+  return true;
+}
+
+bool MappedSnapshot::isOpen() const { return file.getData() != nullptr; }
+
+void MappedSnapshot::close() {
+  file.unmap();
+  std::memset(&header, 0, sizeof(header));
+  nameOffsets = nullptr;
+  names = nullptr;
+  flights = nullptr;
+  slots = nullptr;
+  strings = nullptr;
+  seats = nullptr;
+  waitlist = nullptr;
+}
+
+void MappedSnapshot::verify() const {
+  const char *body = file.getData() + sizeof(header);
+  if (crc32(body, file.getSize() - sizeof(header)) != header.bodyCrc) {
+    corrupt();
+  }
+}
+
+std::uint64_t MappedSnapshot::getLsn() const { return header.lsn; }
+PriorityType MappedSnapshot::getNextBookingPriority() const {
+  return header.nextBookingPriority;
+}
+
+PassengerIdType MappedSnapshot::getFirstPassengerId() const {
+  return header.firstPassengerId;
+}
+std::size_t MappedSnapshot::getPassengerCount() const {
+  return static_cast<std::size_t>(header.passengerCount);
+}
+const std::uint64_t *MappedSnapshot::getNameOffsets() const {
+  return nameOffsets;
+}
+const char *MappedSnapshot::getNames() const { return names; }
+
+std::size_t MappedSnapshot::getFlightCount() const {
+  return static_cast<std::size_t>(header.flightCount);
+}
+
+// Bounds checks are done per record when it is first used, so opening
+// stays O(1) in the number of flights
+const SnapshotFlightRecord &
+MappedSnapshot::record(std::uint32_t index) const {
+  if (index >= header.flightCount) {
+    corrupt();
+  }
+  const SnapshotFlightRecord &r = flights[index];
+  const std::uint64_t stringLength = static_cast<std::uint64_t>(r.idLength) +
+                                     r.originLength + r.destinationLength;
+  if (!inRange(r.stringsBegin, stringLength, header.stringsSize) ||
+      !inRange(r.seatsBegin, r.seatCount, header.seatCount) ||
+      !inRange(r.waitlistBegin, r.waitlistCount, header.waitlistCount) ||
+      r.idLength > FlightCode::MAX_LENGTH ||
+      r.originLength > FlightCode::MAX_LENGTH ||
+      r.destinationLength > FlightCode::MAX_LENGTH ||
+      r.backend > static_cast<std::uint8_t>(WaitlistBackend::Radix) ||
+      r.capacity < 0 ||
+      r.seatCount > static_cast<std::uint32_t>(r.capacity)) {
+    corrupt();
+  }
+  return r;
+}
+
+std::uint32_t MappedSnapshot::find(StringRef flightId) const {
+  if (!isOpen()) {
+    return NOT_FOUND;
+  }
+  const std::uint64_t mask = header.hashSlots - 1;
+  std::uint64_t pos = FlightIndex::hashId(flightId) & mask;
+  for (std::uint64_t probes = 0; probes < header.hashSlots; ++probes) {
+    std::uint32_t slot = slots[pos];
+    if (slot == 0) {
+      return NOT_FOUND;
+    }
+    const SnapshotFlightRecord &r = record(slot - 1);
+    if (StringRef(strings + r.stringsBegin, r.idLength) == flightId) {
+      return slot - 1;
+    }
+    pos = (pos + 1) & mask;
+  }
+  return NOT_FOUND;
+}
+
+SnapshotFlightView MappedSnapshot::getFlight(std::uint32_t index) const {
+  const SnapshotFlightRecord &r = record(index);
+  SnapshotFlightView view;
+  view.id = strings + r.stringsBegin;
+  view.idLength = r.idLength;
+  view.origin = view.id + r.idLength;
+  view.originLength = r.originLength;
+  view.destination = view.origin + r.originLength;
+  view.destinationLength = r.destinationLength;
+  view.capacity = r.capacity;
+  view.backend = static_cast<WaitlistBackend>(r.backend);
+  view.seats = seats + r.seatsBegin;
+  view.seatCount = r.seatCount;
+  view.waitlist = waitlist + r.waitlistBegin;
+  view.waitlistCount = r.waitlistCount;
+  return view;
+}
+
+Flight MappedSnapshot::materialize(std::uint32_t index) const {
+  SnapshotFlightView view = getFlight(index);
+  Flight flight(std::string(view.id, view.idLength),
+                std::string(view.origin, view.originLength),
+                std::string(view.destination, view.destinationLength),
+                view.capacity, view.backend);
+  // Seats in seat order as one batch, then the sorted waitlist bulk-built
+  // as is: seats that were held when the snapshot was written are free in
+  // it, and the journal tail holds them again
+  std::vector<std::pair<PassengerIdType, PriorityType>> bookings;
+  bookings.reserve(view.seatCount);
+  for (std::size_t i = 0; i < view.seatCount; ++i) {
+    bookings.emplace_back(view.seats[i], MIN_PRIORITY);
+  }
+  std::vector<BookingResult> results;
+  flight.addPassengers(bookings, results);
+  for (BookingResult result : results) {
+    if (result != BookingResult::Confirmed) {
+      corrupt(); // Passenger listed twice
+    }
+  }
+  std::vector<std::pair<PriorityType, PassengerIdType>> waiting;
+  waiting.reserve(view.waitlistCount);
+  for (std::size_t i = 0; i < view.waitlistCount; ++i) {
+    waiting.emplace_back(view.waitlist[i].priority,
+                         view.waitlist[i].passengerId);
+  }
+  if (!flight.restoreWaitlist(waiting)) {
+    corrupt();
+  }
+  return flight;
+}
@@ -0,0 +1,260 @@
+// src/storage/Snapshot.cpp
+#include "storage/Snapshot.h"
+#include "booking/Flight.h"
+#include "storage/BinaryCodec.h" // For crc32
+#include "storage/FileHandle.h"
+#include <cstddef>               // For offsetof
+#include <cstring>               // For std::memcpy
+#include <fcntl.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+static_assert(sizeof(PassengerIdType) == 4 && sizeof(PriorityType) == 8,
+              "Snapshot arrays store 32-bit IDs and 64-bit priorities");
+
+namespace {
+
+const std::size_t FLUSH_BYTES = 1 << 20;
+
+// Streams the body to the file in large writes, checksumming as it goes,
+// so a schedule of millions of flights is never held twice in memory
+class SnapshotStream {
+private:
+  FileHandle &file;
+  std::string buffer;
+  std::uint64_t offset; // File offset of the next byte
+  std::uint32_t checksum;
+
+  void flush() {
+    checksum = crc32(buffer.data(), buffer.size(), checksum);
+    file.writeAll(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+
+public:
+  SnapshotStream(FileHandle &f, std::uint64_t start)
+      : file(f), offset(start), checksum(0) {}
+
+  void write(const void *data, std::size_t length) {
+    buffer.append(static_cast<const char *>(data), length);
+    offset += length;
+    if (buffer.size() >= FLUSH_BYTES) {
+      flush();
+    }
+  }
+  void align() { // Zero-pads to the next 8-byte boundary
+    static const char zeros[8] = {0};
+    write(zeros, static_cast<std::size_t>((8 - offset % 8) % 8));
+  }
+  std::uint64_t tell() const { return offset; }
+  std::uint32_t finish() {
+    flush();
+    return checksum;
+  }
+};
+
+// The flights to write, in listing order: untouched baseline records, then
+// the live flights. 'live' is nullptr for a baseline record, whose view
+// then points into the old mapping.
+struct FlightSource {
+  const Flight *live;
+  SnapshotFlightView view;
+};
+
+template <typename Fn>
+void forEachFlight(const FlightIndex &flights, const MappedSnapshot *baseline,
+                   Fn fn) {
+  FlightSource source;
+  if (baseline != nullptr) {
+    source.live = nullptr;
+    for (std::size_t i = 0; i < baseline->getFlightCount(); ++i) {
+      source.view = baseline->getFlight(static_cast<std::uint32_t>(i));
+      if (flights.find(StringRef(source.view.id, source.view.idLength)) ==
+          INVALID_FLIGHT_HANDLE) {
+        fn(source);
+      }
+    }
+  }
+  for (const Flight &flight : flights) {
+    source.live = &flight;
+    SnapshotFlightView &view = source.view;
+    view.id = flight.getFlightId().data();
+    view.idLength = flight.getFlightId().size();
+    view.origin = flight.getOrigin().data();
+    view.originLength = flight.getOrigin().size();
+    view.destination = flight.getDestination().data();
+    view.destinationLength = flight.getDestination().size();
+    view.capacity = flight.getCapacity();
+    view.backend = flight.getWaitlist().getBackend();
+    view.seats = flight.getConfirmedPassengers().data();
+    view.seatCount = flight.getConfirmedPassengers().size();
+    view.waitlist = nullptr; // Read from the heap in the waitlist pass
+    view.waitlistCount = static_cast<std::size_t>(flight.getWaitlistCount());
+    fn(source);
+  }
+}
+
+std::uint64_t alignUp(std::uint64_t offset) { return (offset + 7) & ~7ull; }
+
+} // namespace
+
+void writeSnapshot(const std::string &path, const SnapshotInfo &info,
+                   const PassengerTable &passengers,
+                   const FlightIndex &flights,
+                   const MappedSnapshot *baseline) {
+  SnapshotHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, "BSNP", 4);
+  header.version = MappedSnapshot::VERSION;
+  header.headerSize = sizeof(header);
+  header.endianTag = 0x01020304u;
+  header.lsn = info.lsn;
+  header.nextBookingPriority = info.nextBookingPriority;
+  header.firstPassengerId = passengers.getFirstId();
+  header.passengerCount = passengers.size();
+  header.namesSize = passengers.getNameArenaSize();
+
+  // Pass 1: section sizes
+  forEachFlight(flights, baseline, [&header](const FlightSource &source) {
+    const SnapshotFlightView &view = source.view;
+    ++header.flightCount;
+    header.stringsSize +=
+        view.idLength + view.originLength + view.destinationLength;
+    header.seatCount += view.seatCount;
+    header.waitlistCount += view.waitlistCount;
+  });
+  header.hashSlots = 1;
+  while (header.hashSlots < 2 * header.flightCount) {
+    header.hashSlots *= 2;
+  }
+
+  std::uint64_t offset = sizeof(header);
+  header.passengerOffsetsOffset = offset;
+  offset = alignUp(offset + 8 * (header.passengerCount + 1));
+  header.namesOffset = offset;
+  offset = alignUp(offset + header.namesSize);
+  header.flightsOffset = offset;
+  offset = alignUp(offset + sizeof(SnapshotFlightRecord) * header.flightCount);
+  header.slotsOffset = offset;
+  offset = alignUp(offset + 4 * header.hashSlots);
+  header.stringsOffset = offset;
+  offset = alignUp(offset + header.stringsSize);
+  header.seatsOffset = offset;
+  offset = alignUp(offset + 4 * header.seatCount);
+  header.waitlistOffset = offset;
+  header.fileSize =
+      offset + sizeof(SnapshotWaitlistEntry) * header.waitlistCount;
+
+  // Pass 2: the ID hash table, built in memory (4 bytes per slot)
+  std::vector<std::uint32_t> slots(static_cast<std::size_t>(header.hashSlots),
+                                   0);
+  const std::uint64_t mask = header.hashSlots - 1;
+  std::uint32_t recordIndex = 0;
+  forEachFlight(flights, baseline, [&](const FlightSource &source) {
+    std::uint64_t pos =
+        FlightIndex::hashId(StringRef(source.view.id, source.view.idLength)) &
+        mask;
+    while (slots[pos] != 0) {
+      pos = (pos + 1) & mask;
+    }
+    slots[pos] = ++recordIndex;
+  });
+
+  const std::string tmpPath = path + ".tmp";
+  FileHandle file(tmpPath, O_WRONLY | O_CREAT | O_TRUNC);
+  file.writeAll(&header, sizeof(header)); // Placeholder, rewritten below
+  SnapshotStream out(file, sizeof(header));
+
+  out.write(passengers.getNameOffsets(), 8 * (header.passengerCount + 1));
+  out.align();
+  out.write(passengers.getNameArena(), header.namesSize);
+  out.align();
+
+  // Pass 3: records, with running indexes into the later sections
+  SnapshotFlightRecord record;
+  std::memset(&record, 0, sizeof(record));
+  forEachFlight(flights, baseline, [&](const FlightSource &source) {
+    const SnapshotFlightView &view = source.view;
+    record.idLength = static_cast<std::uint32_t>(view.idLength);
+    record.originLength = static_cast<std::uint32_t>(view.originLength);
+    record.destinationLength = static_cast<std::uint32_t>(view.destinationLength);
+    record.capacity = view.capacity;
+    record.seatCount = static_cast<std::uint32_t>(view.seatCount);
+    record.waitlistCount = static_cast<std::uint32_t>(view.waitlistCount);
+    record.backend = static_cast<std::uint8_t>(view.backend);
+    out.write(&record, sizeof(record));
+    record.stringsBegin +=
+        view.idLength + view.originLength + view.destinationLength;
+    record.seatsBegin += view.seatCount;
+    record.waitlistBegin += view.waitlistCount;
+  });
+  out.align();
+  out.write(slots.data(), 4 * slots.size());
+  out.align();
+  std::vector<std::uint32_t>().swap(slots);
+
+  // Passes 4 to 6: strings, seats, waitlists
+  forEachFlight(flights, baseline, [&out](const FlightSource &source) {
+    const SnapshotFlightView &view = source.view;
+    out.write(view.id, view.idLength);
+    out.write(view.origin, view.originLength);
+    out.write(view.destination, view.destinationLength);
+  });
+  out.align();
+  forEachFlight(flights, baseline, [&out](const FlightSource &source) {
+    out.write(source.view.seats, 4 * source.view.seatCount);
+  });
+  out.align();
+  std::vector<SnapshotWaitlistEntry> entries;
+  forEachFlight(flights, baseline, [&](const FlightSource &source) {
+    if (source.live == nullptr) {
+      out.write(source.view.waitlist,
+                sizeof(SnapshotWaitlistEntry) * source.view.waitlistCount);
+      return;
+    }
+    entries.clear();
+    for (const auto &entry :
+         source.live->getWaitlistTop(source.view.waitlistCount)) {
+      SnapshotWaitlistEntry stored;
+      stored.priority = entry.first;
+      stored.passengerId = entry.second;
+      stored.padding = 0; // Checksummed, keep it deterministic
+      entries.push_back(stored);
+    }
+    out.write(entries.data(), sizeof(SnapshotWaitlistEntry) * entries.size());
+  });
+  if (out.tell() != header.fileSize) {
+    throw std::runtime_error("Snapshot size mismatch while writing '" +
+                             tmpPath + "'");
+  }
+
+  header.bodyCrc = out.finish();
+  header.headerCrc = crc32(&header, offsetof(SnapshotHeader, headerCrc));
+  file.writeAt(0, &header, sizeof(header));
+  file.sync();
+  file.close();
+  renameDurably(tmpPath, path);
+}
+
+bool loadSnapshot(const std::string &path, SnapshotInfo &info,
+                  PassengerTable &passengers, FlightIndex &flights) {
+  MappedSnapshot snapshot;
+  if (!snapshot.open(path)) {
+    return false;
+  }
+  snapshot.verify();
+  info.lsn = snapshot.getLsn();
+  info.nextBookingPriority = snapshot.getNextBookingPriority();
+  passengers.assign(snapshot.getFirstPassengerId(), snapshot.getNameOffsets(),
+                    snapshot.getPassengerCount(), snapshot.getNames());
+  flights.reserve(snapshot.getFlightCount());
+  for (std::size_t i = 0; i < snapshot.getFlightCount(); ++i) {
+    if (!flights.insert(snapshot.materialize(static_cast<std::uint32_t>(i)))
+             .second) {
+      throw std::runtime_error("Corrupt snapshot '" + path +
+                               "' (duplicate flight ID)");
+    }
+  }
+  return true;
+}
@@ -0,0 +1,222 @@
+// src/storage/WriteAheadLog.cpp
+#include "storage/WriteAheadLog.h"
+#include "storage/BinaryCodec.h"
+#include <algorithm> // For std::max
+#include <fcntl.h>
+#include <stdexcept>
+
+namespace {
+
+const char WAL_MAGIC[4] = {'B', 'W', 'A', 'L'};
+const std::uint32_t WAL_VERSION = 2; // 2: 64-bit priorities
+const std::size_t WAL_HEADER_SIZE = 8;
+const std::size_t FRAME_HEADER_SIZE = 8; // Length + CRC
+const std::size_t GROUP_BYTES = 1 << 20; // Commit early past this
+
+std::string encodeHeader() {
+  std::string header(WAL_MAGIC, sizeof(WAL_MAGIC));
+  ByteWriter(header).u32(WAL_VERSION);
+  return header;
+}
+
+// Decodes one payload; false if its fields do not add up
+bool decodeRecord(const char *data, std::size_t length, WalRecord &record) {
+  ByteReader in(data, length);
+  record.type = static_cast<WalRecord::Type>(in.u8());
+  record.lsn = in.u64();
+  switch (record.type) {
+  case WalRecord::Type::AddPassenger:
+    record.passengerId = in.i32();
+    in.str(record.name);
+    break;
+  case WalRecord::Type::AddFlight:
+    in.str(record.flightId);
+    in.str(record.name);
+    in.str(record.destination);
+    record.capacity = in.i32();
+    record.backend = static_cast<WaitlistBackend>(in.u8());
+    break;
+  case WalRecord::Type::Booked:
+  case WalRecord::Type::Cancelled:
+  case WalRecord::Type::Promoted:
+  case WalRecord::Type::Upgraded:
+  case WalRecord::Type::Held:
+  case WalRecord::Type::HoldConfirmed:
+  case WalRecord::Type::HoldReleased:
+    in.str(record.flightId);
+    record.passengerId = in.i32();
+    record.priority = in.i64();
+    break;
+  default:
+    return false;
+  }
+  return in.good() && in.remaining() == 0;
+}
+
+} // namespace
+
+WriteAheadLog::WriteAheadLog(std::size_t records, unsigned delayMs)
+    : pendingRecords(0), nextLsn(1), groupRecords(records > 0 ? records : 1),
+      groupDelay(std::chrono::milliseconds(delayMs)), commitCount(0),
+      holdDepth(0) {}
+
+WriteAheadLog::~WriteAheadLog() {
+  try {
+    commit();
+  } catch (const std::exception &) {
+    // Nothing sensible left to do while unwinding; the group is lost
+  }
+}
+
+std::size_t
+WriteAheadLog::open(const std::string &path, std::uint64_t afterLsn,
+                    const std::function<void(const WalRecord &)> &replay) {
+  file = FileHandle(path, O_RDWR | O_CREAT);
+  std::string contents(static_cast<std::size_t>(file.size()), '\0');
+  contents.resize(file.readSome(&contents[0], contents.size()));
+
+  const std::string header = encodeHeader();
+  if (contents.size() < WAL_HEADER_SIZE) {
+    // New (or torn while being created): start over with a fresh header
+    file.truncate(0);
+    file.writeAll(header.data(), header.size());
+    file.sync();
+    nextLsn = afterLsn + 1;
+    return 0;
+  }
+  if (contents.compare(0, WAL_HEADER_SIZE, header) != 0) {
+    throw std::runtime_error("Not a booking journal (bad header): '" + path +
+                             "'");
+  }
+
+  std::size_t offset = WAL_HEADER_SIZE;
+  std::size_t replayed = 0;
+  std::uint64_t last = afterLsn;
+  WalRecord record;
+  while (contents.size() - offset >= FRAME_HEADER_SIZE) {
+    ByteReader frame(contents.data() + offset, FRAME_HEADER_SIZE);
+    std::uint32_t length = frame.u32();
+    std::uint32_t checksum = frame.u32();
+    const char *payload = contents.data() + offset + FRAME_HEADER_SIZE;
+    if (contents.size() - offset - FRAME_HEADER_SIZE < length ||
+        crc32(payload, length) != checksum ||
+        !decodeRecord(payload, length, record)) {
+      break; // Torn or corrupt tail
+    }
+    if (record.lsn > afterLsn) {
+      replay(record);
+      ++replayed;
+    }
+    last = std::max(last, record.lsn);
+    offset += FRAME_HEADER_SIZE + length;
+  }
+  if (offset < contents.size()) {
+    file.truncate(offset); // New appends must follow the last good frame
+    file.sync();
+  }
+  file.seekToEnd();
+  nextLsn = last + 1;
+  return replayed;
+}
+
+bool WriteAheadLog::isOpen() const { return file.isOpen(); }
+
+// --- Appends ---
+
+std::size_t WriteAheadLog::beginRecord(WalRecord::Type type) {
+  if (pendingRecords == 0) {
+    pendingSince = Clock::now();
+  }
+  std::size_t frameOffset = pending.size();
+  pending.append(FRAME_HEADER_SIZE, '\0'); // Patched in endRecord()
+  ByteWriter out(pending);
+  out.u8(static_cast<std::uint8_t>(type));
+  out.u64(nextLsn++);
+  return frameOffset;
+}
+
+void WriteAheadLog::endRecord(std::size_t frameOffset) {
+  const std::size_t payloadOffset = frameOffset + FRAME_HEADER_SIZE;
+  const std::size_t length = pending.size() - payloadOffset;
+  std::string frame;
+  ByteWriter out(frame);
+  out.u32(static_cast<std::uint32_t>(length));
+  out.u32(crc32(pending.data() + payloadOffset, length));
+  pending.replace(frameOffset, FRAME_HEADER_SIZE, frame);
+
+  ++pendingRecords;
+  if (holdDepth == 0 && groupIsDue()) {
+    commit();
+  }
+}
+
+bool WriteAheadLog::groupIsDue() const {
+  return pendingRecords >= groupRecords || pending.size() >= GROUP_BYTES ||
+         (pendingRecords > 0 && Clock::now() - pendingSince >= groupDelay);
+}
+
+void WriteAheadLog::logPassenger(PassengerIdType passengerId,
+                                 const char *name, std::size_t nameLength) {
+  std::size_t frame = beginRecord(WalRecord::Type::AddPassenger);
+  ByteWriter out(pending);
+  out.i32(passengerId);
+  out.str(name, nameLength);
+  endRecord(frame);
+}
+
+void WriteAheadLog::logFlight(const std::string &flightId,
+                              const std::string &origin,
+                              const std::string &destination, int capacity,
+                              WaitlistBackend backend) {
+  std::size_t frame = beginRecord(WalRecord::Type::AddFlight);
+  ByteWriter out(pending);
+  out.str(flightId);
+  out.str(origin);
+  out.str(destination);
+  out.i32(capacity);
+  out.u8(static_cast<std::uint8_t>(backend));
+  endRecord(frame);
+}
+
+void WriteAheadLog::logBooking(WalRecord::Type type, StringRef flightId,
+                               PassengerIdType passengerId,
+                               PriorityType priority) {
+  std::size_t frame = beginRecord(type);
+  ByteWriter out(pending);
+  out.str(flightId.data, flightId.size);
+  out.i32(passengerId);
+  out.i64(priority);
+  endRecord(frame);
+}
+
+// --- Durability ---
+
+void WriteAheadLog::commit() {
+  if (pendingRecords == 0 || !file.isOpen()) {
+    return;
+  }
+  file.writeAll(pending.data(), pending.size());
+  file.sync();
+  ++commitCount;
+  pending.clear();
+  pendingRecords = 0;
+}
+
+void WriteAheadLog::holdCommits() { ++holdDepth; }
+
+void WriteAheadLog::releaseCommits() {
+  if (holdDepth > 0 && --holdDepth == 0 && groupIsDue()) {
+    commit();
+  }
+}
+
+void WriteAheadLog::reset() {
+  commit();
+  file.truncate(WAL_HEADER_SIZE);
+  file.sync();
+  file.seekToEnd();
+}
+
+std::uint64_t WriteAheadLog::lastLsn() const { return nextLsn - 1; }
+std::size_t WriteAheadLog::pendingCount() const { return pendingRecords; }
+std::uint64_t WriteAheadLog::getCommitCount() const { return commitCount; }